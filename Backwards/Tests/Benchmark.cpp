@@ -0,0 +1,328 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "Backwards/Input/Lexer.h"
+#include "Backwards/Input/StringInput.h"
+
+#include "Backwards/Parser/SymbolTable.h"
+#include "Backwards/Parser/Parser.h"
+#include "Backwards/Parser/ContextBuilder.h"
+
+#include "Backwards/Engine/Statement.h"
+#include "Backwards/Engine/CallingContext.h"
+#include "Backwards/Engine/Logger.h"
+#include "Backwards/Engine/VirtualMachine.h"
+#include "Backwards/Engine/FatalException.h"
+
+/*
+   End-to-end timing of the engine over a fixed set of scripts, on both the tree walker and the VirtualMachine.
+   Usage: Benchmark [warmup runs] [timed runs]
+   Output is JSON on stdout. Times are medians over the timed runs, in nanoseconds. Allocation counts and
+   bytes are from the last run. Peak bytes is the most memory that the phase had allocated at once.
+*/
+
+ // Count every allocation. This benchmark is single threaded, so plain counters do.
+static size_t allocations = 0U;
+static size_t allocatedBytes = 0U;
+static size_t liveBytes = 0U;
+static size_t peakBytes = 0U;
+
+static const size_t HEADER = alignof(std::max_align_t);
+
+void* operator new (std::size_t size)
+ {
+   char* block = static_cast<char*>(std::malloc(size + HEADER));
+   if (nullptr == block)
+    {
+      throw std::bad_alloc();
+    }
+   *reinterpret_cast<std::size_t*>(block) = size;
+   ++allocations;
+   allocatedBytes += size;
+   liveBytes += size;
+   peakBytes = std::max(peakBytes, liveBytes);
+   return block + HEADER;
+ }
+
+void operator delete (void* pointer) noexcept
+ {
+   if (nullptr != pointer)
+    {
+       // Through an integer, as the compiler can't see that pointer came from operator new.
+      char* block = reinterpret_cast<char*>(reinterpret_cast<std::uintptr_t>(pointer) - HEADER);
+      liveBytes -= *reinterpret_cast<std::size_t*>(block);
+      std::free(block);
+    }
+ }
+
+void* operator new[] (std::size_t size) { return operator new(size); }
+void operator delete[] (void* pointer) noexcept { operator delete(pointer); }
+void operator delete (void* pointer, std::size_t) noexcept { operator delete(pointer); }
+void operator delete[] (void* pointer, std::size_t) noexcept { operator delete(pointer); }
+
+class Counts final
+ {
+public:
+   size_t allocations;
+   size_t bytes;
+   size_t peak;
+
+   void start ()
+    {
+      allocations = ::allocations;
+      bytes = allocatedBytes;
+      peak = liveBytes;
+      peakBytes = liveBytes;
+    }
+
+   void stop ()
+    {
+      allocations = ::allocations - allocations;
+      bytes = allocatedBytes - bytes;
+      peak = peakBytes - peak;
+    }
+ };
+
+class BenchLogger final : public Backwards::Engine::Logger
+ {
+public:
+   std::string last;
+   void log (const std::string& message) { last = message; }
+   std::string get () { return ""; }
+ };
+
+class Workload final
+ {
+public:
+   const char* name;
+   const char* script;
+ };
+
+static const Workload WORKLOADS [] =
+ {
+   { "fib",
+      "set f to function fib (n) is if n < 2 then return n else return fib(n - 1) + fib(n - 2) end end "
+      "call Info(ToString(f(20)))" },
+   { "for_loop",
+      "set s to 0 for x from 1 to 200000 do set s to s + x * 2 - 1 end call Info(ToString(s))" },
+   { "array_push_back",
+      "set a to NewArray() for x from 1 to 20000 do set a to PushBack(a; x) end "
+      "for x from 0 to 19999 do set a[x] to a[x] * 2 end call Info(ToString(Size(a)))" },
+   { "dictionary_churn",
+      "set d to NewDictionary() for x from 1 to 5000 do set d to Insert(d; x; x) end "
+      "for x from 1 to 5000 step 2 do set d to RemoveKey(d; x) end "
+      "for x from 1 to 5000 do set d[ToString(x)] to x end call Info(ToString(Size(d)))" },
+   { "string_concat",
+      "set s to '' for x from 1 to 5000 do set s to s + 'x' end call Info(ToString(Length(s)))" },
+   { "string_accumulate",
+      "set s to '' for x from 1 to 20000 do set s to s + 'abcdefghij' end "
+      "call Info(ToString(Length(s))) call Info(SubString(s; 100000; 100010))" },
+   { "select_dispatch",
+      "set s to 0 for x from 1 to 50000 do "
+      "   select x - Floor(x / 4) * 4 from "
+      "      case 0 is set s to s + 1 "
+      "      case 1 is set s to s - 2 "
+      "      case 2 is set s to s * 1 "
+      "      case else is set s to s + 3 "
+      "   end "
+      "end call Info(ToString(s))" },
+   { "stdlib_calls",
+      "set s to 0 for x from 1 to 50000 do set s to s + Sqrt(x) + Abs(Min(x; 7) - Max(x; 3)) end "
+      "call Info(ToString(Floor(s)))" },
+   { "tail_recursion",
+      "set f to function count (n; acc) is if n = 0 then return acc else return count(n - 1; acc + n) end end "
+      "call Info(ToString(f(20000; 0)))" },
+   { "closures",
+      "set make to function (n) is return function [n] (x) [m] is return x + m end end "
+      "set s to 0 for i from 1 to 20000 do set add to make(i) set s to add(s) end call Info(ToString(s))" },
+   { "array_arithmetic",
+      "set a to NewArrayDefault(10000; 1.5) for x from 1 to 20 do set a to a * 1.01 + 1 - 0.5 end "
+      "call Info(ToString(a[9999])) set b to 2 / a call Info(ToString(b[0]))" }
+ };
+
+class Sample final
+ {
+public:
+   double parse;
+   double execute;
+   Counts parseCounts;
+   Counts executeCounts;
+   std::string result;
+ };
+
+static Sample runOnce (const Workload& workload, bool useBytecode)
+ {
+   Sample sample;
+   Backwards::Engine::Scope global;
+   Backwards::Parser::ContextBuilder::createGlobalScope(global);
+   Backwards::Parser::GetterSetter gs;
+   Backwards::Parser::SymbolTable table (gs, global);
+   BenchLogger logger;
+   Backwards::Engine::CallingContext context;
+   context.logger = &logger;
+   context.debugger = nullptr;
+   context.globalScope = &global;
+   context.useBytecode = useBytecode;
+
+   Backwards::Input::StringInput string (workload.script);
+   Backwards::Input::Lexer lexer (string, workload.name);
+
+   sample.parseCounts.start();
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   std::shared_ptr<Backwards::Engine::Statement> parse = Backwards::Parser::Parser::Parse(lexer, table, logger);
+   sample.parse = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+   sample.parseCounts.stop();
+
+   if (nullptr == parse.get())
+    {
+      sample.execute = 0.0;
+      sample.executeCounts.start();
+      sample.executeCounts.stop();
+      sample.result = "Parse returned NULL.";
+      return sample;
+    }
+
+   sample.executeCounts.start();
+   start = std::chrono::steady_clock::now();
+   try
+    {
+      if (true == useBytecode)
+       {
+         Backwards::Engine::VirtualMachine::Execute(*parse, context);
+       }
+      else
+       {
+         parse->execute(context);
+       }
+      sample.result = logger.last;
+    }
+   catch (const Backwards::Types::TypedOperationException& e)
+    {
+      sample.result = std::string("TypedOperationException: ") + e.what();
+    }
+   catch (const Backwards::Engine::FatalException& e)
+    {
+      sample.result = std::string("FatalException: ") + e.what();
+    }
+   sample.execute = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+   sample.executeCounts.stop();
+   return sample;
+ }
+
+static double median (std::vector<double> values)
+ {
+   std::sort(values.begin(), values.end());
+   const size_t middle = values.size() / 2U;
+   return (0U == values.size() % 2U) ? (values[middle - 1U] + values[middle]) / 2.0 : values[middle];
+ }
+
+static std::string quote (const std::string& text)
+ {
+   std::string result = "\"";
+   for (char c : text)
+    {
+      if (('"' == c) || ('\\' == c))
+       {
+         result += '\\';
+       }
+      result += c;
+    }
+   return result + "\"";
+ }
+
+int main (int argc, char ** argv)
+ {
+   const int warmup = (argc > 1) ? std::atoi(argv[1]) : 2;
+   int runs = (argc > 2) ? std::atoi(argv[2]) : 10;
+   if (runs < 1)
+    {
+      runs = 1;
+    }
+
+   std::cout << "{" << std::endl;
+   std::cout << "   \"warmup\": " << warmup << "," << std::endl;
+   std::cout << "   \"runs\": " << runs << "," << std::endl;
+   std::cout << "   \"results\": [" << std::endl;
+
+   bool first = true;
+   for (const Workload& workload : WORKLOADS)
+    {
+      for (bool useBytecode : { false, true })
+       {
+         for (int i = 0; i < warmup; ++i)
+          {
+            (void) runOnce(workload, useBytecode);
+          }
+
+         std::vector<double> parseTimes;
+         std::vector<double> executeTimes;
+         Sample last;
+         for (int i = 0; i < runs; ++i)
+          {
+            last = runOnce(workload, useBytecode);
+            parseTimes.push_back(last.parse);
+            executeTimes.push_back(last.execute);
+          }
+
+         if (false == first)
+          {
+            std::cout << "," << std::endl;
+          }
+         first = false;
+         std::cout << "      {" << std::endl;
+         std::cout << "         \"workload\": " << quote(workload.name) << "," << std::endl;
+         std::cout << "         \"engine\": " << quote((true == useBytecode) ? "bytecode" : "tree") << "," << std::endl;
+         std::cout << "         \"result\": " << quote(last.result) << "," << std::endl;
+         std::cout << "         \"parse_ns\": " << static_cast<long long>(median(parseTimes)) << "," << std::endl;
+         std::cout << "         \"parse_allocations\": " << last.parseCounts.allocations << "," << std::endl;
+         std::cout << "         \"parse_bytes\": " << last.parseCounts.bytes << "," << std::endl;
+         std::cout << "         \"parse_peak_bytes\": " << last.parseCounts.peak << "," << std::endl;
+         std::cout << "         \"execute_ns\": " << static_cast<long long>(median(executeTimes)) << "," << std::endl;
+         std::cout << "         \"execute_allocations\": " << last.executeCounts.allocations << "," << std::endl;
+         std::cout << "         \"execute_bytes\": " << last.executeCounts.bytes << "," << std::endl;
+         std::cout << "         \"execute_peak_bytes\": " << last.executeCounts.peak << std::endl;
+         std::cout << "      }";
+       }
+    }
+   std::cout << std::endl << "   ]" << std::endl << "}" << std::endl;
+
+   return 0;
+ }
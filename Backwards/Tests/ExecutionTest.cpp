@@ -32,6 +32,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "gtest/gtest.h"
 
 #include <iostream>
+#include <map>
+#include <sstream>
 
 #include "Backwards/Input/Lexer.h"
 #include "Backwards/Input/StringInput.h"
@@ -44,6 +46,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Engine/CallingContext.h"
 #include "Backwards/Engine/Logger.h"
 #include "Backwards/Engine/DebuggerHook.h"
+#include "Backwards/Engine/VirtualMachine.h"
+#include "Backwards/Engine/FatalException.h"
+#include "Backwards/Engine/Profiler.h"
+
+#include "Backwards/Types/FloatValue.h"
+#include "Backwards/Types/ArrayValue.h"
+#include "Backwards/Types/StringValue.h"
 
 class StringLogger final : public Backwards::Engine::Logger
  {
@@ -785,3 +794,529 @@ TEST(AllTests, testICanRecursiveFib)
    ASSERT_EQ(1U, logger.logs.size());
    EXPECT_EQ("INFO: 1.20000000e+2", logger.logs[0]);
  }
+
+TEST(AllTests, testNumericFor)
+ {
+   Backwards::Input::StringInput string
+      (
+      "set s to 0 "
+      "for x from 1 to 2 step 0.25 do set s to s + x end "
+      "call Info(ToString(s)) "
+      "for x from 3 downto 1 do set x to x * 10 call Info(ToString(x)) end "
+      "for x from 1 to 0 do call Info('Nope') end "
+      "for x from 2 downto 1 step -0.5 do call Info(ToString(x)) end "
+      "call Info(ToString(x)) "
+      );
+   Backwards::Input::Lexer lexer (string, "InputString");
+
+   Backwards::Engine::Scope global;
+   Backwards::Parser::ContextBuilder::createGlobalScope(global); // Create the global scope before the table.
+   Backwards::Parser::GetterSetter gs;
+   Backwards::Parser::SymbolTable table (gs, global);
+   Backwards::Engine::CallingContext context;
+   StringLogger logger;
+   DummyDebugger debugger;
+
+   context.logger = &logger;
+   context.debugger = &debugger;
+   context.globalScope = &global;
+
+   std::shared_ptr<Backwards::Engine::Statement> parse = Backwards::Parser::Parser::Parse(lexer, table, logger);
+
+   debugger.entered = false;
+   EXPECT_EQ(0U, logger.logs.size());
+
+   if (nullptr != parse.get())
+    {
+      parse->execute(context);
+    }
+   else
+    {
+      FAIL() << "Parse returned NULL.";
+    }
+
+   ASSERT_EQ(8U, logger.logs.size());
+   EXPECT_EQ("INFO: 7.50000000e+0", logger.logs[0]);
+   EXPECT_EQ("INFO: 3.00000000e+1", logger.logs[1]); // Changing the variable doesn't change the loop.
+   EXPECT_EQ("INFO: 2.00000000e+1", logger.logs[2]);
+   EXPECT_EQ("INFO: 1.00000000e+1", logger.logs[3]);
+   EXPECT_EQ("INFO: 2.00000000e+0", logger.logs[4]);
+   EXPECT_EQ("INFO: 1.50000000e+0", logger.logs[5]);
+   EXPECT_EQ("INFO: 1.00000000e+0", logger.logs[6]);
+   EXPECT_EQ("INFO: 5.00000000e-1", logger.logs[7]); // The variable is left one step past the end.
+   ASSERT_FALSE(debugger.entered);
+ }
+
+ // Run a script with either engine, and record everything that can be observed about the run.
+static std::vector<std::string> runWithEngine (const std::string& script, bool useBytecode, Backwards::Engine::Profiler* profiler = nullptr)
+ {
+   Backwards::Input::StringInput string (script);
+   Backwards::Input::Lexer lexer (string, "InputString");
+
+   Backwards::Engine::Scope global;
+   Backwards::Parser::ContextBuilder::createGlobalScope(global); // Create the global scope before the table.
+   Backwards::Parser::GetterSetter gs;
+   Backwards::Parser::SymbolTable table (gs, global);
+   Backwards::Engine::CallingContext context;
+   StringLogger logger;
+   DummyDebugger debugger;
+
+   context.logger = &logger;
+   context.debugger = &debugger;
+   context.globalScope = &global;
+   context.useBytecode = useBytecode;
+   context.profiler = profiler;
+
+   std::shared_ptr<Backwards::Engine::Statement> parse = Backwards::Parser::Parser::Parse(lexer, table, logger);
+
+   debugger.entered = false;
+   if (nullptr != parse.get())
+    {
+      try
+       {
+         if (true == useBytecode)
+          {
+            Backwards::Engine::VirtualMachine::Execute(*parse, context);
+          }
+         else
+          {
+            parse->execute(context);
+          }
+       }
+      catch (const Backwards::Types::TypedOperationException& e)
+       {
+         logger.logs.emplace_back(std::string("TypedOperationException: ") + e.what());
+       }
+      catch (const Backwards::Engine::FatalException& e)
+       {
+         logger.logs.emplace_back(std::string("FatalException: ") + e.what());
+       }
+    }
+   else
+    {
+      logger.logs.emplace_back("Parse returned NULL.");
+    }
+
+   logger.logs.emplace_back((true == debugger.entered) ? "Debugger entered." : "Debugger not entered.");
+   return logger.logs;
+ }
+
+TEST(AllTests, testBytecodeMatchesTree)
+ {
+   const char* scripts [] =
+    {
+      "if 7 < 5 then call Info('True') else call Info('False') end if 5 < 7 then call Info('True') else call Info('False') end",
+      "set ThisThing to NewArrayDefault(3; { 'hello' : 'world' }) \n"
+      "set ThisThing[2],hello to { 'Bye' : 'Cruel World' } \n"
+      "set ThisThing[2],hello.Bye to NewArrayDefault(3; 'More') \n"
+      "set ThisThing[2],hello.Bye[1] to NewArrayDefault(3; 'Less') \n"
+      "set ThisThing[2],hello.Bye[1][2] to 'Poor Unfortunate Souls' \n"
+      "call Warn(ThisThing[2],hello.Bye[1][2]) call Warn(ToString(ThisThing))",
+      "for x from 1 to 3 do call Info(ToString(x)) end "
+      "for x from 3 downto 1 do call Info(ToString(x)) end "
+      "for x from 2 to 10 step 3 do call Info(ToString(x)) end "
+      "for x in {1; 2; 3} do call Info(ToString(x)) end "
+      "for x in {1 : 'a'; 2 : 'b'} do call Info(ToString(x)) end "
+      "for x from 1 to 10 call Bob do "
+      "   for y from 1 to 10 do "
+      "      select x from "
+      "         case 1 is continue Bob "
+      "         case 2 is break Bob "
+      "      end "
+      "      call Info(ToString(y)) "
+      "   end "
+      "end ",
+      "select 27 from case below 3 is call Info('Nope') case above 100 is call Info('Nope') "
+      "   case from 50 to 100 is call Info('Nope') case 27 is call Info('Yeppers') also case else is call Info('Yeps') "
+      "   case 28 is call Info('Nope') end",
+      "set x to 12 \n"
+      "while x < 15 call Bob do call Info('Yeppers') set x to x + 1 "
+      "   while x > 10 do select x from case 13 is continue Bob case 14 is break Bob end end "
+      "end "
+      "call Info(ToString(x))",
+      "call Info(ToString(function fib (y) is if y > 1 then return fib(y - 1) * y else return 1 end end (5)))",
+      "set a to 3 set f to function [a] (x) [b] is return x + b end "
+      "set g to function [f; 2] (y) [h; c] is return h(y) * c end "
+      "call Info(ToString(g(4))) call Info(f(1) = 4 & 1 | 0 ? 'yes' : 'no') call Info(ToString(-a ^ 2 / 3))",
+      "set f to function (x) is for y in x do if y = 2 then return y end end return 0 end call Info(ToString(f({1; 2; 3})))",
+      "set x to 3 set x[2][3] to 5",
+      "set x to 3 set x[2] to 5",
+      "if 3 < 'hello' then end",
+      "while 3 < 'hello' do end",
+      "set x to 3 while x < 4 do set x to 'hello' end",
+      "select 3 from case 'hello' is case 14 is end",
+      "for x from 3 to 'hello' do end",
+      "for x in 3 do end",
+      "for x from 3 downto 1 step -0.5 do set x to x * 10 call Info(ToString(x)) end call Info(ToString(x))",
+      "for x from 'a' to 'c' do end",
+      "set f to function (x) is return x + 'a' end call Info(ToString(f(1) = 1 ? 2 : 3))",
+      "set f to function (x) is return x end call f(1; 2)",
+      "set f to 3 call f(1)",
+      "call Info(3)",
+      "set a to NewArrayDefault(3; 1) set b to a set a[1] to 'x' set a[2] to a[0] + 1 "
+      "for x in a do call Info(IsString(x) ? x : ToString(x)) end for x in b do call Info(ToString(x)) end call Info(ToString(a = b)) call Info(b[3])"
+    };
+   for (const char* script : scripts)
+    {
+      std::vector<std::string> tree = runWithEngine(script, false);
+      std::vector<std::string> bytecode = runWithEngine(script, true);
+      EXPECT_EQ(tree, bytecode) << script;
+    }
+ }
+
+TEST(AllTests, testIntegerIndicesAndCounters)
+ {
+   const char* script =
+      "for x from -2 to 2 do call Info(ToString(x)) end "
+      "for x from 999999990 to 1000000010 step 10 do end call Info(ToString(x)) "
+      "for x from 1 to 2 step 0.5 do end call Info(ToString(x)) "
+      "set a to {'a'; 'b'; 'c'} set z to -0 call Info(a[1] + a[1.75] + a[z]) "
+      "set a[2.5] to 'd' call Info(a[2] + ToString(Size(a))) "
+      "call Info(SubString('Hello'; 1; 3) + SubString('Hello'; 1.5; 3.9)) "
+      "call Info(ToString(Size(NewArrayDefault(2.9; 0)))) "
+      "call Info(a[3])";
+   const std::vector<std::string> expected =
+    {
+      "INFO: -2.00000000e+0",
+      "INFO: -1.00000000e+0",
+      "INFO: 0.00000000e+0",
+      "INFO: 1.00000000e+0",
+      "INFO: 2.00000000e+0",
+      "INFO: 1.00000002e+9",
+      "INFO: 2.50000000e+0",
+      "INFO: bba",
+      "INFO: d3.00000000e+0",
+      "INFO: elel",
+      "INFO: 2.00000000e+0"
+    };
+
+   for (bool useBytecode : { false, true })
+    {
+      std::vector<std::string> logs = runWithEngine(script, useBytecode);
+      ASSERT_EQ(expected.size() + 2U, logs.size());
+      for (size_t i = 0U; i < expected.size(); ++i)
+       {
+         EXPECT_EQ(expected[i], logs[i]);
+       }
+      EXPECT_EQ(0U, logs[expected.size()].find("TypedOperationException: "));
+    }
+ }
+
+TEST(AllTests, testAssigningIntoAFloatElement)
+ {
+   const char* script =
+      "set x to NewArrayDefault(3; 1) \n"
+      "set x[1][0] to 5 \n";
+
+   for (bool useBytecode : { false, true })
+    {
+      std::vector<std::string> logs = runWithEngine(script, useBytecode);
+      ASSERT_EQ(2U, logs.size());
+      EXPECT_EQ("TypedOperationException: Error indexing non-Collection.\n\tFrom file InputString on line 2 at 9", logs[0]);
+      EXPECT_EQ("Debugger entered.", logs[1]);
+    }
+ }
+
+class SnoopingDebugger final : public Backwards::Engine::DebuggerHook
+ {
+public:
+   std::vector<Backwards::Types::Value> globals;
+   virtual void EnterDebugger(const std::string&, Backwards::Engine::CallingContext& context) { globals = context.globalScope->vars; }
+ };
+
+TEST(AllTests, testIndexedAssignmentKeepsValueSemantics)
+ {
+   const char* script =
+      "set a to {1; {2; 3}} set b to a set c to a[1] \n"
+      "set a[1][0] to 7 set a[0] to 5 \n"
+      "call Info(ToString(a[0] + a[1][0] * 10)) call Info(ToString(b[0] + b[1][0] * 10)) call Info(ToString(c[0])) \n"
+      "set d to {'k' : 1} set e to d set d['k'] to 2 call Info(ToString(d['k'] * 10 + e['k'])) \n"
+      "set a[1][5] to 1";
+
+   for (bool useBytecode : { false, true })
+    {
+      Backwards::Input::StringInput string (script);
+      Backwards::Input::Lexer lexer (string, "InputString");
+
+      Backwards::Engine::Scope global;
+      Backwards::Parser::ContextBuilder::createGlobalScope(global);
+      Backwards::Parser::GetterSetter gs;
+      Backwards::Parser::SymbolTable table (gs, global);
+      Backwards::Engine::CallingContext context;
+      StringLogger logger;
+      SnoopingDebugger debugger;
+
+      context.logger = &logger;
+      context.debugger = &debugger;
+      context.globalScope = &global;
+      context.useBytecode = useBytecode;
+
+      std::shared_ptr<Backwards::Engine::Statement> parse = Backwards::Parser::Parser::Parse(lexer, table, logger);
+      ASSERT_TRUE(nullptr != parse.get());
+      try
+       {
+         if (true == useBytecode)
+          {
+            Backwards::Engine::VirtualMachine::Execute(*parse, context);
+          }
+         else
+          {
+            parse->execute(context);
+          }
+         FAIL() << "The last assignment should have thrown.";
+       }
+      catch (const Backwards::Types::TypedOperationException& e)
+       {
+         logger.logs.emplace_back(e.what());
+       }
+
+       // Changing a doesn't change the copies of it, or of its parts.
+      ASSERT_EQ(5U, logger.logs.size());
+      EXPECT_EQ("INFO: 7.50000000e+1", logger.logs[0]);
+      EXPECT_EQ("INFO: 2.10000000e+1", logger.logs[1]);
+      EXPECT_EQ("INFO: 2.00000000e+0", logger.logs[2]);
+      EXPECT_EQ("INFO: 2.10000000e+1", logger.logs[3]);
+      EXPECT_EQ("Array Index Out-of-Bounds.", logger.logs[4].substr(0U, 26U));
+
+       // The failed assignment left a alone, even while the debugger was looking at it.
+      const std::vector<Backwards::Types::Value>* seen [] = { &debugger.globals, &global.vars };
+      for (const std::vector<Backwards::Types::Value>* vars : seen)
+       {
+         const Backwards::Types::Value& a = (*vars)[global.var["a"]];
+         ASSERT_TRUE(typeid(Backwards::Types::ArrayValue) == typeid(*a));
+         const Backwards::Types::ArrayValue& outer = static_cast<const Backwards::Types::ArrayValue&>(*a);
+         ASSERT_EQ(2U, outer.value.size());
+         ASSERT_TRUE(typeid(Backwards::Types::ArrayValue) == typeid(*outer.value[1]));
+         const Backwards::Types::ArrayValue& inner = static_cast<const Backwards::Types::ArrayValue&>(*outer.value[1]);
+         ASSERT_EQ(2U, inner.value.size());
+         EXPECT_EQ(SlowFloat::SlowFloat(7.0), static_cast<const Backwards::Types::FloatValue&>(*inner.value[0]).value);
+       }
+    }
+ }
+
+TEST(AllTests, testFramesComeFromTheValueStack)
+ {
+   const char* script =
+      "set f to function [10] (x) [c] is set c to c + x return c end \n"
+      "call Info(ToString(f(1))) call Info(ToString(f(2))) \n"
+      "set g to function deep (n) is if n = 0 then return 0 else return 1 + deep(n - 1) end end \n"
+      "call Info(ToString(g(600))) \n"
+      "set h to function bad (n) is if n = 0 then return 1 + 'a' else return bad(n - 1) end end \n"
+      "call Info(ToString(h(300)))";
+
+   for (bool useBytecode : { false, true })
+    {
+      Backwards::Input::StringInput string (script);
+      Backwards::Input::Lexer lexer (string, "InputString");
+
+      Backwards::Engine::Scope global;
+      Backwards::Parser::ContextBuilder::createGlobalScope(global);
+      Backwards::Parser::GetterSetter gs;
+      Backwards::Parser::SymbolTable table (gs, global);
+      Backwards::Engine::CallingContext context;
+      StringLogger logger;
+      DummyDebugger debugger;
+
+      context.logger = &logger;
+      context.debugger = &debugger;
+      context.globalScope = &global;
+      context.useBytecode = useBytecode;
+
+      std::shared_ptr<Backwards::Engine::Statement> parse = Backwards::Parser::Parser::Parse(lexer, table, logger);
+      ASSERT_TRUE(nullptr != parse.get());
+      try
+       {
+         if (true == useBytecode)
+          {
+            Backwards::Engine::VirtualMachine::Execute(*parse, context);
+          }
+         else
+          {
+            parse->execute(context);
+          }
+         FAIL() << "The last call should have thrown.";
+       }
+      catch (const Backwards::Types::TypedOperationException&)
+       {
+       }
+
+       // Assigning to a capture doesn't change the function, and every slice is given back, even when unwinding.
+      ASSERT_EQ(3U, logger.logs.size());
+      EXPECT_EQ("INFO: 1.10000000e+1", logger.logs[0]);
+      EXPECT_EQ("INFO: 1.20000000e+1", logger.logs[1]);
+      EXPECT_EQ("INFO: 6.00000000e+2", logger.logs[2]);
+      EXPECT_EQ(0U, context.values.inUse());
+      EXPECT_EQ(nullptr, context.currentFrame);
+    }
+
+   Backwards::Engine::ValueStack stack;
+   Backwards::Types::Value* first = stack.carve(Backwards::Engine::ValueStack::BLOCK_SIZE - 1U);
+   Backwards::Types::Value* second = stack.carve(2U); // Doesn't fit: starts the next block.
+   Backwards::Types::Value* third = stack.carve(Backwards::Engine::ValueStack::BLOCK_SIZE * 2U);
+   EXPECT_EQ(Backwards::Engine::ValueStack::BLOCK_SIZE * 3U + 1U, stack.inUse());
+   second[1] = Backwards::Types::Value(SlowFloat::SlowFloat(1.0));
+   third[0] = std::make_shared<Backwards::Types::StringValue>("A");
+   stack.release(third, Backwards::Engine::ValueStack::BLOCK_SIZE * 2U);
+   stack.release(second, 2U);
+   EXPECT_EQ(Backwards::Engine::ValueStack::BLOCK_SIZE - 1U, stack.inUse());
+   EXPECT_EQ(second, stack.carve(2U)); // The same place as before, emptied.
+   EXPECT_FALSE(second[1]);
+   stack.release(second, 2U);
+   EXPECT_EQ(first + Backwards::Engine::ValueStack::BLOCK_SIZE - 1U, stack.carve(1U));
+ }
+
+TEST(AllTests, testNativeCalls)
+ {
+   const char* script =
+      "set a to Sqrt(16) \n"
+      "call Info(ToString(a) + ' ' + ToString(Max(3; 4)) + ' ' + SubString('abcdef'; 1; 3) + ' ' + ToString(PI() > 3)) \n"
+      "set Sqrt to function (x) is return x + 1 end \n"
+      "call Info(ToString(Sqrt(16))) \n"
+      "call PushBack(NewArray(); 1) \n"
+      "call Info(ToString(Abs('a')))";
+
+   const char* notAFunction =
+      "set Max to 5 \n"
+      "call Info(ToString(Max(1; 2)))";
+
+   for (bool useBytecode : { false, true })
+    {
+      std::vector<std::string> logs = runWithEngine(script, useBytecode);
+      ASSERT_EQ(4U, logs.size());
+      EXPECT_EQ("INFO: 4.00000000e+0 4.00000000e+0 bc 1.00000000e+0", logs[0]);
+      EXPECT_EQ("INFO: 1.70000000e+1", logs[1]);
+      EXPECT_EQ("TypedOperationException: Error trying to compute absolute value of non-Float.\n\tFrom file InputString on line 6 at 23", logs[2]);
+      EXPECT_EQ("Debugger entered.", logs[3]);
+
+      logs = runWithEngine(notAFunction, useBytecode);
+      ASSERT_EQ(2U, logs.size());
+      EXPECT_EQ("FatalException: Call to not a Function at 23 on line 2 in file InputString", logs[0]);
+      EXPECT_EQ("Debugger entered.", logs[1]);
+    }
+ }
+
+TEST(AllTests, testTailCalls)
+ {
+    // Deep enough that nesting a native frame per call would run out of stack.
+   const char* script =
+      "set counter to function count (n; acc) is if n = 0 then return acc else return count(n - 1; acc + 1) end end \n"
+      "call Info(ToString(counter(300000; 0))) \n"
+      "set isEven to 0 \n"
+      "set isOdd to function (n) is if n = 0 then return 0 else return isEven(n - 1) end end \n"
+      "set isEven to function (n) is if n = 0 then return 1 else return isOdd(n - 1) end end \n"
+      "call Info(ToString(isEven(100001))) \n"
+      "set adder to function (n) is return function [n] (x) [m] is return x + m end end \n"
+      "set apply to function (f; x) is for y in { 1; 2 } do return f(x + y) end end \n"
+      "call Info(ToString(apply(adder(10); 5))) \n"
+      "set failing to function bad (n) is if n = 0 then return 1 + 'a' else return bad(n - 1) end end \n"
+      "call Info(ToString(failing(3)))";
+
+   for (bool useBytecode : { false, true })
+    {
+      std::vector<std::string> logs = runWithEngine(script, useBytecode);
+      ASSERT_EQ(5U, logs.size());
+      EXPECT_EQ("INFO: 3.00000000e+5", logs[0]);
+      EXPECT_EQ("INFO: 0.00000000e+0", logs[1]);
+      EXPECT_EQ("INFO: 1.60000000e+1", logs[2]);
+       // The frames of the tail calls are gone, so they don't add to the message.
+      EXPECT_EQ("TypedOperationException: Error adding Float to String\n\tFrom file InputString on line 10 at 59\n"
+         "\tFrom file InputString on line 10 at 50\n\tFrom file InputString on line 11 at 27", logs[3]);
+      EXPECT_EQ("Debugger entered.", logs[4]);
+    }
+ }
+
+TEST(AllTests, testProfiler)
+ {
+   const char* script =
+      "set doubler to function twice (n) is return n * 2 end \n"
+      "set middle to function mid (n) is \n"
+      "   set a to doubler(n) \n"
+      "   return doubler(a) \n"
+      "end \n"
+      "set total to 0 \n"
+      "for i from 1 to 3 do \n"
+      "   set total to total + middle(i) \n"
+      "end \n"
+      "call Info(ToString(total)) \n"
+      "set k to 0 while k < 2 do set k to k + 1 end \n"
+      "set failing to function bad () is return 1 + 'a' end \n"
+      "call failing()";
+
+   for (bool useBytecode : { false, true })
+    {
+      Backwards::Engine::Profiler profiler;
+      std::vector<std::string> logs = runWithEngine(script, useBytecode, &profiler);
+      ASSERT_EQ(3U, logs.size());
+      EXPECT_EQ("INFO: 2.40000000e+1", logs[0]);
+
+      std::map<std::string, size_t> calls;
+      for (const Backwards::Engine::Profiler::FunctionStats& function : profiler.getFunctions())
+       {
+         calls[Backwards::Engine::Profiler::nameOf(*function.function)] = function.calls;
+         EXPECT_LE(function.exclusive, function.inclusive);
+         EXPECT_EQ(0U, function.active); // Even the one that threw has returned.
+       }
+      EXPECT_EQ((std::map<std::string, size_t>{ { "Info", 1U }, { "bad", 1U }, { "mid", 3U }, { "twice", 6U } }), calls);
+
+      std::map<size_t, size_t> hits;
+      for (const Backwards::Engine::Profiler::LineStats& line : profiler.getLines())
+       {
+         EXPECT_EQ("InputString", line.sourceFile);
+         hits[line.lineNumber] = line.hits;
+       }
+       // Function bodies count every call, and the while loop counts each test of its condition.
+      EXPECT_EQ((std::map<size_t, size_t>{ { 1U, 7U }, { 2U, 1U }, { 3U, 3U }, { 4U, 3U }, { 6U, 1U }, { 7U, 1U }, { 8U, 3U },
+         { 10U, 1U }, { 11U, 6U }, { 12U, 2U }, { 13U, 1U } }), hits) << useBytecode;
+
+       // The tail call to twice replaces mid, so it is called from the top of the stack.
+      std::stringstream folded (profiler.folded());
+      std::string line;
+      while (std::getline(folded, line))
+       {
+         std::string path = line.substr(0U, line.find(' '));
+         EXPECT_TRUE(("mid" == path) || ("mid;twice" == path) || ("twice" == path) || ("bad" == path) || ("Info" == path)) << line;
+       }
+
+      std::string report = profiler.report(1U);
+      EXPECT_NE(std::string::npos, report.find("line 1 in file InputString"));
+      EXPECT_EQ(std::string::npos, report.find("line 3 in file InputString"));
+
+      profiler.clear();
+      EXPECT_TRUE(profiler.getFunctions().empty());
+      EXPECT_EQ("", profiler.folded());
+    }
+ }
+
+TEST(AllTests, testFoldingIgnoresTheParseTimeRoundingMode)
+ {
+   Backwards::Engine::Scope global;
+   Backwards::Parser::ContextBuilder::createGlobalScope(global);
+   Backwards::Parser::GetterSetter gs;
+   Backwards::Parser::SymbolTable table (gs, global);
+   Backwards::Engine::CallingContext context;
+   StringLogger logger;
+   context.logger = &logger;
+   context.globalScope = &global;
+
+    // Parse in one rounding mode, then have another unit change it: nothing in the first unit mentions the mode.
+   Backwards::Input::StringInput first ("set x to 1 call Info(ToString(1 / 3)) call Info(ToString(x / 3))");
+   Backwards::Input::Lexer firstLexer (first, "InputString");
+   std::shared_ptr<Backwards::Engine::Statement> divide = Backwards::Parser::Parser::Parse(firstLexer, table, logger);
+   Backwards::Input::StringInput second ("call SetRoundMode(2)");
+   Backwards::Input::Lexer secondLexer (second, "InputString");
+   std::shared_ptr<Backwards::Engine::Statement> setMode = Backwards::Parser::Parser::Parse(secondLexer, table, logger);
+   ASSERT_NE(nullptr, divide.get());
+   ASSERT_NE(nullptr, setMode.get());
+
+   SlowFloat::SlowFloat_Round_Mode saved = SlowFloat::mode;
+   setMode->execute(context);
+   divide->execute(context);
+   Backwards::Engine::VirtualMachine::Execute(*divide, context);
+   SlowFloat::mode = saved;
+
+   ASSERT_EQ(4U, logger.logs.size());
+   EXPECT_EQ("INFO: 3.33333334e-1", logger.logs[0]);
+   EXPECT_EQ(logger.logs[0], logger.logs[1]);
+   EXPECT_EQ(logger.logs[0], logger.logs[2]);
+   EXPECT_EQ(logger.logs[0], logger.logs[3]);
+ }
@@ -50,6 +50,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Backwards/Engine/StackFrame.h"
 
+#include "Backwards/Parser/ContextBuilder.h"
+#include "Backwards/Parser/SymbolTable.h"
+
 class StringLogger final : public Backwards::Engine::Logger
  {
 public:
@@ -619,3 +622,56 @@ TEST(EngineTests, testBuildFunction)
    ASSERT_TRUE(typeid(Backwards::Types::FloatValue) == typeid(*std::dynamic_pointer_cast<Backwards::Types::FunctionValue>(res)->captures[0].get()));
    EXPECT_EQ(SlowFloat::SlowFloat(9.0), std::dynamic_pointer_cast<Backwards::Types::FloatValue>(std::dynamic_pointer_cast<Backwards::Types::FunctionValue>(res)->captures[0])->value);
  }
+
+TEST(EngineTests, testResolvedVariables)
+ {
+   Backwards::Engine::CallingContext context;
+   Backwards::Engine::Scope global;
+   context.globalScope = &global;
+
+   global.vars.push_back(std::shared_ptr<Backwards::Types::ValueType>());
+   global.vars.push_back(makeFloatValue(1.0));
+
+   Backwards::Engine::Variable unset (Backwards::Input::Token(), std::make_shared<Backwards::Engine::GlobalGetter>(0U));
+   EXPECT_EQ(Backwards::Engine::Variable::GLOBAL, unset.access);
+   EXPECT_THROW(unset.evaluate(context), Backwards::Engine::FatalException);
+   global.vars[0] = makeFloatValue(2.0);
+   EXPECT_EQ(SlowFloat::SlowFloat(2.0), static_cast<const Backwards::Types::FloatValue&>(*unset.evaluate(context)).value);
+
+    // A Scope variable is checked against the Scope, not the globals.
+   Backwards::Engine::Scope big, small;
+   big.vars.push_back(makeFloatValue(3.0));
+   big.vars.push_back(std::shared_ptr<Backwards::Types::ValueType>());
+   small.vars.push_back(makeFloatValue(4.0));
+   EXPECT_NE(big.epoch, small.epoch);
+
+   Backwards::Engine::Variable first (Backwards::Input::Token(), std::make_shared<Backwards::Engine::ScopeGetter>(0U));
+   Backwards::Engine::Variable second (Backwards::Input::Token(), std::make_shared<Backwards::Engine::ScopeGetter>(1U));
+   EXPECT_EQ(Backwards::Engine::Variable::SCOPE, second.access);
+   EXPECT_THROW(second.evaluate(context), Backwards::Engine::FatalException);
+
+   context.pushScope(&big);
+   EXPECT_THROW(second.evaluate(context), Backwards::Engine::FatalException);
+   EXPECT_EQ(SlowFloat::SlowFloat(3.0), static_cast<const Backwards::Types::FloatValue&>(*first.evaluate(context)).value);
+   big.vars[1] = makeFloatValue(5.0);
+   EXPECT_EQ(SlowFloat::SlowFloat(5.0), static_cast<const Backwards::Types::FloatValue&>(*second.evaluate(context)).value);
+   EXPECT_EQ(SlowFloat::SlowFloat(5.0), static_cast<const Backwards::Types::FloatValue&>(*second.evaluate(context)).value);
+   context.popScope();
+
+    // Having read the big Scope doesn't excuse the bounds check on the small one.
+   context.pushScope(&small);
+   EXPECT_EQ(SlowFloat::SlowFloat(4.0), static_cast<const Backwards::Types::FloatValue&>(*first.evaluate(context)).value);
+   EXPECT_THROW(second.evaluate(context), Backwards::Engine::FatalException);
+   context.popScope();
+
+    // A global that is set when the read is parsed is never checked again.
+   Backwards::Engine::Scope library;
+   Backwards::Parser::ContextBuilder::createGlobalScope(library);
+   Backwards::Parser::GetterSetter gs;
+   Backwards::Parser::SymbolTable table (gs, library);
+   table.addVariable("later");
+   std::shared_ptr<Backwards::Engine::Expression> sqrt = table.buildVariable(Backwards::Input::Token(Backwards::Input::IDENTIFIER, "Sqrt", "", 0U, 0U));
+   std::shared_ptr<Backwards::Engine::Expression> later = table.buildVariable(Backwards::Input::Token(Backwards::Input::IDENTIFIER, "later", "", 0U, 0U));
+   EXPECT_EQ(Backwards::Engine::Variable::SET_GLOBAL, static_cast<const Backwards::Engine::Variable&>(*sqrt).access);
+   EXPECT_EQ(Backwards::Engine::Variable::GLOBAL, static_cast<const Backwards::Engine::Variable&>(*later).access);
+ }
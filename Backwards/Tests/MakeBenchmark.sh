@@ -0,0 +1,23 @@
+#!/bin/sh -x
+
+./Clean.sh
+
+cd ../src/Types
+g++ -I../../include -I../../../SlowFloat -s -O3 -c -Wall -Wextra -Wpedantic *.cpp
+mv ./*.o ../../obj
+
+cd ../Input
+g++ -I../../include -I../../../SlowFloat -s -O3 -c -Wall -Wextra -Wpedantic *.cpp
+mv ./*.o ../../obj
+
+cd ../Engine
+g++ -I../../include -I../../../SlowFloat -s -O3 -c -Wall -Wextra -Wpedantic *.cpp
+mv ./*.o ../../obj
+
+cd ../Parser
+g++ -I../../include -I../../../SlowFloat -s -O3 -c -Wall -Wextra -Wpedantic *.cpp
+mv ./*.o ../../obj
+
+cd ../../bin
+g++ -o Benchmark -s -Wall -Wextra -Wpedantic -O3 -I../include -I../../SlowFloat ../Tests/Benchmark.cpp ../obj/*.o ../obj/*.a
+./Benchmark.exe > Benchmark.json
@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Parser/ContextBuilder.h"
 
 #include "Backwards/Engine/Statement.h"
+#include "Backwards/Engine/Expression.h"
 #include "Backwards/Engine/CallingContext.h"
 #include "Backwards/Engine/FunctionContext.h"
 #include "Backwards/Engine/FatalException.h"
@@ -49,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Engine/Scope.h"
 
 #include "Backwards/Types/FloatValue.h"
+#include "Backwards/Types/FunctionValue.h"
 
 #include "Backwards/Engine/ProgrammingException.h"
 
@@ -917,6 +919,79 @@ TEST(ParserTests, testStatementParses)
    EXPECT_NE(nullptr, parse.get());
  }
 
+static std::shared_ptr<Backwards::Engine::Statement> parseOptimized (const std::string& text)
+ {
+   Backwards::Engine::Scope global;
+   Backwards::Parser::ContextBuilder::createGlobalScope(global);
+   Backwards::Parser::GetterSetter gs;
+   Backwards::Parser::SymbolTable table (gs, global);
+   StringLogger logger;
+   Backwards::Input::StringInput string (text);
+   Backwards::Input::Lexer lexer (string, "InputString");
+   return Backwards::Parser::Parser::Parse(lexer, table, logger);
+ }
+
+static const Backwards::Engine::Statement& getStatement (const std::shared_ptr<Backwards::Engine::Statement>& parse, size_t index)
+ {
+    // A sequence of one statement is just the statement.
+   if (typeid(Backwards::Engine::StatementSeq) == typeid(*parse))
+    {
+      return *static_cast<const Backwards::Engine::StatementSeq&>(*parse).statements[index];
+    }
+   return *parse;
+ }
+
+static const Backwards::Engine::Expression& getRHS (const std::shared_ptr<Backwards::Engine::Statement>& parse, size_t index)
+ {
+   return *dynamic_cast<const Backwards::Engine::Assignment&>(getStatement(parse, index)).rhs;
+ }
+
+static double getConstant (const Backwards::Engine::Expression& expr)
+ {
+   return static_cast<double>(dynamic_cast<const Backwards::Types::FloatValue&>(*dynamic_cast<const Backwards::Engine::Constant&>(expr).value).value);
+ }
+
+TEST(ParserTests, testOptimizer)
+ {
+   std::shared_ptr<Backwards::Engine::Statement> parse;
+
+   parse = parseOptimized("set a to 1 + 2 * 3");
+   EXPECT_EQ(7.0, getConstant(getRHS(parse, 0)));
+
+    // The rounding mode can be changed by anything before the tree runs, so only exact results are folded.
+   parse = parseOptimized("set a to 1 / 3 set b to 1 + 2");
+   EXPECT_EQ(typeid(Backwards::Engine::Divide), typeid(getRHS(parse, 0)));
+   EXPECT_EQ(3.0, getConstant(getRHS(parse, 1)));
+
+   parse = parseOptimized("set a to 0 & 'hello' set b to !(3 = 3) ? 5 : -(4)");
+   EXPECT_EQ(0.0, getConstant(getRHS(parse, 0)));
+   EXPECT_EQ(-4.0, getConstant(getRHS(parse, 1)));
+
+    // Errors are left for the runtime.
+   parse = parseOptimized("set a to 3 < 'hello'");
+   EXPECT_EQ(typeid(Backwards::Engine::Less), typeid(getRHS(parse, 0)));
+
+   parse = parseOptimized("set a to 1 / 3 set b to 1 + 2 call SetRoundMode(4)");
+   EXPECT_EQ(typeid(Backwards::Engine::Divide), typeid(getRHS(parse, 0)));
+   EXPECT_EQ(3.0, getConstant(getRHS(parse, 1)));
+
+    // Dead arms are dropped and the survivors are flattened into the outer sequence.
+   parse = parseOptimized("if 7 < 5 then set a to 1 else set a to 2 set b to 3 end if 0 then set c to 4 end set d to 5");
+   ASSERT_EQ(3U, dynamic_cast<const Backwards::Engine::StatementSeq&>(*parse).statements.size());
+   EXPECT_EQ(2.0, getConstant(getRHS(parse, 0)));
+   EXPECT_EQ(3.0, getConstant(getRHS(parse, 1)));
+   EXPECT_EQ(5.0, getConstant(getRHS(parse, 2)));
+
+    // Function bodies are optimized, too.
+   parse = parseOptimized("set f to function (x) is return x + (2 * 3) end");
+   const Backwards::Engine::Constant& fun = dynamic_cast<const Backwards::Engine::Constant&>(getRHS(parse, 0));
+   std::shared_ptr<Backwards::Engine::FunctionContext> context = std::dynamic_pointer_cast<Backwards::Engine::FunctionContext>(
+      std::dynamic_pointer_cast<Backwards::Types::FunctionValue>(fun.value)->value);
+   const Backwards::Engine::Plus& plus = dynamic_cast<const Backwards::Engine::Plus&>(
+      *dynamic_cast<const Backwards::Engine::FlowControlStatement&>(getStatement(context->function, 0)).value);
+   EXPECT_EQ(6.0, getConstant(*plus.rhs));
+ }
+
 TEST(ParserTests, testIDontKnowHowToProgram)
  {
    Backwards::Engine::Scope global;
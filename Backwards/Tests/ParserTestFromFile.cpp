@@ -75,7 +75,7 @@ int main (int argc, char ** argv)
 
    Backwards::Engine::CallingContext context;
 
-   std::dynamic_pointer_cast<Backwards::Engine::FunctionContext>(std::dynamic_pointer_cast<Backwards::Types::FunctionValue>(global.vars[global.var["DebugPrint"]])->value)->function =
+   std::dynamic_pointer_cast<Backwards::Engine::FunctionContext>(static_cast<const Backwards::Types::FunctionValue&>(*global.vars[global.var["DebugPrint"]]).value)->function =
       std::make_shared<Backwards::Engine::StandardUnaryFunction>(printValue);
 
    context.globalScope = &global;
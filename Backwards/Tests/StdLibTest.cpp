@@ -526,6 +526,52 @@ TEST(EngineTests, testDictionaryFunctions)
    EXPECT_THROW(Backwards::Engine::GetKeys(Backwards::Engine::NewArray()), Backwards::Types::TypedOperationException);
  }
 
+TEST(EngineTests, testInPlaceFunctions)
+ {
+   std::shared_ptr<Backwards::Types::ValueType> res, shared, left;
+   const Backwards::Types::ValueType* raw;
+
+      // The shared empty Array is copied, the copy is then ours to change.
+   res = Backwards::Engine::PushBackInPlace(Backwards::Engine::NewArray(), makeFloatValue(1.0));
+   EXPECT_EQ(0U, std::dynamic_pointer_cast<Backwards::Types::ArrayValue>(Backwards::Engine::NewArray())->value.size());
+   raw = res.get();
+   res = Backwards::Engine::PushFrontInPlace(std::move(res), makeFloatValue(0.0));
+   res = Backwards::Engine::PushBackInPlace(std::move(res), makeFloatValue(2.0));
+   res = Backwards::Engine::SetIndexInPlace(std::move(res), makeFloatValue(1.0), makeFloatValue(5.0));
+   res = Backwards::Engine::PopFrontInPlace(std::move(res));
+   EXPECT_EQ(raw, res.get());
+   ASSERT_EQ(2U, std::dynamic_pointer_cast<Backwards::Types::ArrayValue>(res)->value.size());
+   left = std::dynamic_pointer_cast<Backwards::Types::ArrayValue>(res)->value[0];
+   EXPECT_EQ(SlowFloat::SlowFloat(5.0), std::dynamic_pointer_cast<Backwards::Types::FloatValue>(left)->value);
+
+      // Someone else can see it, so it is copied.
+   shared = res;
+   res = Backwards::Engine::PopBackInPlace(std::move(res));
+   EXPECT_NE(raw, res.get());
+   EXPECT_EQ(1U, std::dynamic_pointer_cast<Backwards::Types::ArrayValue>(res)->value.size());
+   EXPECT_EQ(2U, std::dynamic_pointer_cast<Backwards::Types::ArrayValue>(shared)->value.size());
+
+      // A failure leaves the container with the caller.
+   EXPECT_THROW(Backwards::Engine::SetIndexInPlace(std::move(shared), makeFloatValue(2.0), makeFloatValue(5.0)), Backwards::Types::TypedOperationException);
+   EXPECT_EQ(raw, shared.get());
+
+   res = Backwards::Engine::InsertInPlace(Backwards::Engine::NewDictionary(), std::make_shared<Backwards::Types::StringValue>("hello"), makeFloatValue(1.0));
+   EXPECT_EQ(0U, std::dynamic_pointer_cast<Backwards::Types::DictionaryValue>(Backwards::Engine::NewDictionary())->value.size());
+   raw = res.get();
+   res = Backwards::Engine::InsertInPlace(std::move(res), std::make_shared<Backwards::Types::StringValue>("world"), makeFloatValue(2.0));
+   res = Backwards::Engine::RemoveKeyInPlace(std::move(res), std::make_shared<Backwards::Types::StringValue>("hello"));
+   EXPECT_EQ(raw, res.get());
+   ASSERT_EQ(1U, std::dynamic_pointer_cast<Backwards::Types::DictionaryValue>(res)->value.size());
+   left = std::dynamic_pointer_cast<Backwards::Types::DictionaryValue>(res)->value.begin()->first;
+   EXPECT_EQ("world", std::dynamic_pointer_cast<Backwards::Types::StringValue>(left)->value);
+
+   shared = res;
+   res = Backwards::Engine::InsertInPlace(std::move(res), std::make_shared<Backwards::Types::StringValue>("hello"), makeFloatValue(1.0));
+   EXPECT_NE(raw, res.get());
+   EXPECT_EQ(2U, std::dynamic_pointer_cast<Backwards::Types::DictionaryValue>(res)->value.size());
+   EXPECT_EQ(1U, std::dynamic_pointer_cast<Backwards::Types::DictionaryValue>(shared)->value.size());
+ }
+
 TEST(EngineTests, testSubstring)
  {
    EXPECT_THROW(Backwards::Engine::SubString(Backwards::Engine::NewArray(), makeFloatValue(1.0), makeFloatValue(2.0)), Backwards::Types::TypedOperationException);
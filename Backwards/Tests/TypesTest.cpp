@@ -32,12 +32,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "gtest/gtest.h"
 
 #include "Backwards/Types/ValueType.h"
+#include "Backwards/Types/Value.h"
 
 #include "Backwards/Types/FloatValue.h"
 #include "Backwards/Types/StringValue.h"
 #include "Backwards/Types/ArrayValue.h"
 #include "Backwards/Types/DictionaryValue.h"
 #include "Backwards/Types/FunctionValue.h"
+#include "Backwards/Types/PersistentVector.h"
+#include "Backwards/Types/PersistentHashMap.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <vector>
 
 /*
    NOTE : The base cases for add/sub/mul/div for ArrayValue/DictionaryValue in ValueType.cpp are impossible calls.
@@ -1034,3 +1042,472 @@ TEST(TypesTests, checkCertainCase) // Make sure iteration isn't broken for sorti
    EXPECT_FALSE(tree.sort(four));
    EXPECT_TRUE(four.sort(tree));
  }
+
+TEST(TypesTests, testValueHandle)
+ {
+   Backwards::Types::FloatValue two (SlowFloat::SlowFloat(2.0));
+   Backwards::Types::FloatValue three (SlowFloat::SlowFloat(3.0));
+
+   Backwards::Types::Value sum = two.add(three);
+   ASSERT_TRUE(sum.isImmediate());
+   EXPECT_EQ(SlowFloat::SlowFloat(5.0), sum.getFloat());
+   ASSERT_TRUE(typeid(Backwards::Types::FloatValue) == typeid(*sum));
+   EXPECT_EQ(SlowFloat::SlowFloat(5.0), static_cast<const Backwards::Types::FloatValue&>(*sum).value);
+   EXPECT_TRUE(sum->logical());
+
+   Backwards::Types::Value copy = sum;
+   sum = std::make_shared<Backwards::Types::StringValue>("MZ");
+   ASSERT_TRUE(copy.isImmediate());
+   EXPECT_EQ(SlowFloat::SlowFloat(5.0), copy.getFloat());
+   ASSERT_FALSE(sum.isImmediate());
+   ASSERT_TRUE(typeid(Backwards::Types::StringValue) == typeid(*sum));
+
+   std::shared_ptr<Backwards::Types::ValueType> boxed = copy;
+   ASSERT_TRUE(typeid(Backwards::Types::FloatValue) == typeid(*boxed));
+   EXPECT_EQ(SlowFloat::SlowFloat(5.0), std::dynamic_pointer_cast<Backwards::Types::FloatValue>(boxed)->value);
+
+   std::shared_ptr<Backwards::Types::ValueType> shared = sum;
+   EXPECT_EQ(shared.get(), sum.get());
+
+   Backwards::Types::Value empty;
+   EXPECT_FALSE(empty);
+   EXPECT_EQ(nullptr, empty.get());
+   empty = copy;
+   EXPECT_TRUE(empty.isImmediate());
+   EXPECT_TRUE(copy->equal(*empty));
+ }
+
+TEST(TypesTests, testBatchedArrayArithmetic)
+ {
+   Backwards::Types::ArrayValue numbers;
+   Backwards::Types::ArrayValue mixed;
+   Backwards::Types::FloatValue three (SlowFloat::SlowFloat(3.0));
+   std::shared_ptr<Backwards::Types::ValueType> temp;
+
+   for (int i = -50; i < 50; ++i)
+    {
+      numbers.value.emplace_back(std::make_shared<Backwards::Types::FloatValue>(SlowFloat::SlowFloat(i * 0.25)));
+    }
+   mixed.value.emplace_back(std::make_shared<Backwards::Types::FloatValue>(SlowFloat::SlowFloat(1.0)));
+   mixed.value.emplace_back(std::make_shared<Backwards::Types::StringValue>("A"));
+
+    // Float op Array, and Array op Float, must match the operation done one element at a time.
+   Backwards::Types::Value (Backwards::Types::ArrayValue::* const ops []) (const Backwards::Types::FloatValue&) const =
+      { &Backwards::Types::ArrayValue::add, &Backwards::Types::ArrayValue::sub, &Backwards::Types::ArrayValue::mul, &Backwards::Types::ArrayValue::div };
+   Backwards::Types::Value (Backwards::Types::ValueType::* const flipped []) (const Backwards::Types::ValueType&) const =
+      { &Backwards::Types::ValueType::add, &Backwards::Types::ValueType::sub, &Backwards::Types::ValueType::mul, &Backwards::Types::ValueType::div };
+   for (size_t op = 0U; op < 4U; ++op)
+    {
+      temp = (numbers.*ops[op])(three);
+      ASSERT_TRUE(typeid(Backwards::Types::ArrayValue) == typeid(*temp));
+      const Backwards::Types::ArrayValue& result = static_cast<const Backwards::Types::ArrayValue&>(*temp);
+      ASSERT_EQ(numbers.value.size(), result.value.size());
+      for (size_t i = 0U; i < numbers.value.size(); ++i)
+       {
+         ASSERT_TRUE(typeid(Backwards::Types::FloatValue) == typeid(*result.value[i]));
+         Backwards::Types::Value expected = (three.*flipped[op])(*numbers.value[i]);
+         EXPECT_TRUE(expected->equal(*result.value[i])) << op << " " << i;
+       }
+
+      temp = (numbers.*flipped[op])(three);
+      ASSERT_TRUE(typeid(Backwards::Types::ArrayValue) == typeid(*temp));
+      const Backwards::Types::ArrayValue& other = static_cast<const Backwards::Types::ArrayValue&>(*temp);
+      ASSERT_EQ(numbers.value.size(), other.value.size());
+      for (size_t i = 0U; i < numbers.value.size(); ++i)
+       {
+         Backwards::Types::Value expected = (numbers.value[i].get()->*flipped[op])(three);
+         EXPECT_TRUE(expected->equal(*other.value[i])) << op << " " << i;
+       }
+    }
+
+    // An array that isn't all Floats still goes one element at a time, and fails the same way.
+   EXPECT_THROW(mixed.add(three), Backwards::Types::TypedOperationException);
+   EXPECT_THROW(mixed.mul(dynamic_cast<Backwards::Types::ValueType&>(three)), Backwards::Types::TypedOperationException);
+   temp = Backwards::Types::ArrayValue().add(three);
+   ASSERT_TRUE(typeid(Backwards::Types::ArrayValue) == typeid(*temp));
+   EXPECT_EQ(0U, static_cast<const Backwards::Types::ArrayValue&>(*temp).value.size());
+ }
+
+TEST(TypesTests, testPackedArrays)
+ {
+   Backwards::Types::ArrayValue packed;
+   Backwards::Types::ArrayValue promoted;
+
+   for (int i = 0; i < 100; ++i)
+    {
+      packed.value.push_back(SlowFloat::SlowFloat(i * 1.0));
+      promoted.value.push_back(std::make_shared<Backwards::Types::FloatValue>(SlowFloat::SlowFloat(i * 1.0)));
+    }
+   EXPECT_TRUE(packed.value.isPacked());
+   EXPECT_TRUE(promoted.value.isPacked()); // A boxed Float is still a Float.
+   promoted.value.push_back(std::make_shared<Backwards::Types::StringValue>("A"));
+   EXPECT_FALSE(promoted.value.isPacked());
+   promoted.value.pop_back();
+   EXPECT_FALSE(promoted.value.isPacked()); // Once promoted, always promoted.
+
+    // The two forms are the same Array to everyone else.
+   EXPECT_TRUE(packed.equal(dynamic_cast<Backwards::Types::ValueType&>(promoted)));
+   EXPECT_TRUE(promoted.equal(dynamic_cast<Backwards::Types::ValueType&>(packed)));
+   EXPECT_EQ(packed.hash(), promoted.hash());
+   EXPECT_FALSE(packed.sort(dynamic_cast<Backwards::Types::ValueType&>(promoted)));
+   ASSERT_EQ(100U, promoted.value.size());
+   for (size_t i = 0U; i < packed.value.size(); ++i)
+    {
+      Backwards::Types::Value element = packed.value.element(i);
+      EXPECT_TRUE(element.isImmediate());
+      EXPECT_EQ(SlowFloat::SlowFloat(i * 1.0), element.getFloat());
+      std::shared_ptr<Backwards::Types::ValueType> boxed = packed.value[i];
+      ASSERT_TRUE(typeid(Backwards::Types::FloatValue) == typeid(*boxed));
+      EXPECT_TRUE(boxed->equal(*promoted.value[i]));
+    }
+   size_t count = 0U;
+   for (Backwards::Types::Value element : packed.value)
+    {
+      EXPECT_TRUE(element->equal(*promoted.value.element(count)));
+      ++count;
+    }
+   EXPECT_EQ(100U, count);
+
+    // Copies share, and a write to one doesn't show in the other.
+   Backwards::Types::ArrayValue copy;
+   copy.value = packed.value;
+   copy.value.set(5U, Backwards::Types::Value(SlowFloat::SlowFloat(-1.0)));
+   copy.value.push_front(Backwards::Types::Value(SlowFloat::SlowFloat(-2.0)));
+   copy.value.pop_back();
+   EXPECT_TRUE(copy.value.isPacked());
+   EXPECT_EQ(SlowFloat::SlowFloat(-2.0), copy.value.element(0U).getFloat());
+   EXPECT_EQ(SlowFloat::SlowFloat(-1.0), copy.value.element(6U).getFloat());
+   EXPECT_EQ(SlowFloat::SlowFloat(5.0), packed.value.element(5U).getFloat());
+   EXPECT_EQ(100U, packed.value.size());
+   copy.value.set(0U, std::make_shared<Backwards::Types::StringValue>("B"));
+   EXPECT_FALSE(copy.value.isPacked());
+   EXPECT_TRUE(packed.value.isPacked());
+   ASSERT_TRUE(typeid(Backwards::Types::StringValue) == typeid(*copy.value[0U]));
+   ASSERT_TRUE(typeid(Backwards::Types::FloatValue) == typeid(*copy.value[6U]));
+   EXPECT_EQ(SlowFloat::SlowFloat(-1.0), static_cast<const Backwards::Types::FloatValue&>(*copy.value[6U]).value);
+   EXPECT_EQ(100U, copy.value.size());
+
+    // Operations on a packed Array give a packed Array.
+   std::shared_ptr<Backwards::Types::ValueType> temp = packed.neg();
+   ASSERT_TRUE(typeid(Backwards::Types::ArrayValue) == typeid(*temp));
+   EXPECT_TRUE(static_cast<const Backwards::Types::ArrayValue&>(*temp).value.isPacked());
+   temp = packed.add(Backwards::Types::FloatValue(SlowFloat::SlowFloat(1.0)));
+   EXPECT_TRUE(static_cast<const Backwards::Types::ArrayValue&>(*temp).value.isPacked());
+   EXPECT_EQ(SlowFloat::SlowFloat(100.0), static_cast<const Backwards::Types::ArrayValue&>(*temp).value.element(99U).getFloat());
+ }
+
+TEST(TypesTests, testInternedStrings)
+ {
+   std::shared_ptr<Backwards::Types::StringValue> first = Backwards::Types::StringValue::intern("field");
+   std::shared_ptr<Backwards::Types::StringValue> second = Backwards::Types::StringValue::intern("field");
+   std::shared_ptr<Backwards::Types::StringValue> other = Backwards::Types::StringValue::intern("other");
+   std::shared_ptr<Backwards::Types::StringValue> built = std::make_shared<Backwards::Types::StringValue>("fie");
+   built = std::make_shared<Backwards::Types::StringValue>(built->value.str() + "ld");
+
+   EXPECT_TRUE(first->isInterned());
+   EXPECT_FALSE(built->isInterned());
+   EXPECT_EQ(first.get(), second.get());
+   EXPECT_TRUE(first->equal(*second));
+   EXPECT_FALSE(first->equal(*other));
+   EXPECT_TRUE(first->notEqual(*other));
+   EXPECT_FALSE(first->sort(*second));
+
+    // A String built at runtime still matches the interned one.
+   EXPECT_TRUE(first->equal(*built));
+   EXPECT_TRUE(built->equal(*first));
+   EXPECT_EQ(first->hash(), built->hash());
+   EXPECT_TRUE(first->equal(*built)); // Both hashes are known now.
+   EXPECT_FALSE(other->equal(*built));
+
+    // Copies aren't interned, but keep the hash.
+   Backwards::Types::StringValue copy (*first);
+   EXPECT_FALSE(copy.isInterned());
+   EXPECT_EQ(first->hash(), copy.hash());
+   EXPECT_TRUE(copy.equal(*first));
+
+    // Once the last reference goes, the next one is a new String.
+   other.reset();
+   other = Backwards::Types::StringValue::intern("other");
+   EXPECT_EQ("other", other->value);
+   EXPECT_TRUE(other->isInterned());
+
+   Backwards::Types::DictionaryValue dict;
+   EXPECT_TRUE(dict.value.insert(std::make_pair(first, other)));
+   EXPECT_EQ(1U, dict.value.size());
+   EXPECT_TRUE(dict.value.contains(built));
+ }
+
+TEST(TypesTests, testStringRopes)
+ {
+   std::shared_ptr<Backwards::Types::StringValue> built = std::make_shared<Backwards::Types::StringValue>();
+   std::shared_ptr<Backwards::Types::StringValue> piece = std::make_shared<Backwards::Types::StringValue>("abcdefghij");
+   std::string expected;
+   for (int i = 0; i < 1000; ++i)
+    {
+      std::shared_ptr<Backwards::Types::ValueType> temp = piece->add(*built);
+      ASSERT_TRUE(typeid(Backwards::Types::StringValue) == typeid(*temp));
+      built = std::static_pointer_cast<Backwards::Types::StringValue>(temp);
+      expected += "abcdefghij";
+    }
+   EXPECT_FALSE(built->value.isFlat());
+   EXPECT_EQ(10000U, built->value.size());
+
+    // Large slices share, small ones copy.
+   Backwards::Types::StringContents slice = built->value.substr(25U, 5000U);
+   EXPECT_FALSE(slice.isFlat());
+   EXPECT_EQ(5000U, slice.size());
+   Backwards::Types::StringContents small = slice.substr(10U, 5U);
+   EXPECT_TRUE(small.isFlat());
+   EXPECT_EQ("fghij", small);
+   EXPECT_EQ(expected.substr(25U, 5000U), slice.str());
+   EXPECT_EQ(expected.substr(35U, 4000U), slice.substr(10U, 4000U).str());
+
+    // Different lengths are different without looking at the characters.
+   EXPECT_FALSE(built->equal(*piece));
+   EXPECT_FALSE(built->value.isFlat());
+
+   EXPECT_EQ(expected, built->value);
+   EXPECT_TRUE(built->value.isFlat());
+   EXPECT_EQ(std::hash<std::string>()(expected), built->hash());
+   EXPECT_TRUE(built->equal(Backwards::Types::StringValue(expected)));
+   EXPECT_TRUE(Backwards::Types::StringValue("b").less(*built));
+   EXPECT_TRUE(Backwards::Types::StringValue("a").greater(*built));
+
+    // Short results are copied right away.
+   std::shared_ptr<Backwards::Types::ValueType> temp = Backwards::Types::StringValue("B").add(Backwards::Types::StringValue("A"));
+   EXPECT_TRUE(std::static_pointer_cast<Backwards::Types::StringValue>(temp)->value.isFlat());
+   EXPECT_EQ("AB", std::static_pointer_cast<Backwards::Types::StringValue>(temp)->value);
+
+    // A very long chain is torn down without running out of stack.
+   Backwards::Types::StringContents chain;
+   for (int i = 0; i < 200000; ++i)
+    {
+      chain = Backwards::Types::StringContents::concat(chain, std::string(Backwards::Types::StringContents::EAGER_LIMIT, 'x'));
+    }
+   EXPECT_EQ(200000U * Backwards::Types::StringContents::EAGER_LIMIT, chain.size());
+   chain = Backwards::Types::StringContents();
+   EXPECT_TRUE(chain.empty());
+
+    // Appending to a String and reading it each time around keeps one copy of it, not one per append.
+   const std::string tail (Backwards::Types::StringContents::EAGER_LIMIT, 'y');
+   Backwards::Types::StringContents prepended;
+   for (int i = 0; i < 2000; ++i)
+    {
+      chain = Backwards::Types::StringContents::concat(chain, tail);
+      prepended = Backwards::Types::StringContents::concat(tail, prepended);
+      ASSERT_EQ(chain.size(), chain.str().size());
+      ASSERT_EQ(prepended.size(), prepended.str().size());
+      ASSERT_LE(chain.footprint(), 2U * chain.size() + tail.size());
+      ASSERT_LE(prepended.footprint(), 2U * prepended.size() + tail.size());
+    }
+   EXPECT_EQ(2000U * tail.size(), chain.size());
+ }
+
+TEST(TypesTests, testTypeTags)
+ {
+   Backwards::Types::FloatValue one;
+   Backwards::Types::StringValue two;
+   Backwards::Types::ArrayValue three;
+   Backwards::Types::DictionaryValue four;
+   Backwards::Types::FunctionValue five;
+
+   EXPECT_EQ(Backwards::Types::ValueType::FLOAT, one.getType());
+   EXPECT_EQ(Backwards::Types::ValueType::STRING, two.getType());
+   EXPECT_EQ(Backwards::Types::ValueType::ARRAY, three.getType());
+   EXPECT_EQ(Backwards::Types::ValueType::DICTIONARY, four.getType());
+   EXPECT_EQ(Backwards::Types::ValueType::FUNCTION, five.getType());
+
+   EXPECT_EQ(Backwards::Types::ValueType::FLOAT, Backwards::Types::Value(SlowFloat::SlowFloat(1.0))->getType());
+   EXPECT_EQ(Backwards::Types::ValueType::STRING, Backwards::Types::StringValue(two).getType());
+   Backwards::Types::ArrayValue copy (three);
+   EXPECT_EQ(Backwards::Types::ValueType::ARRAY, copy.getType());
+
+   EXPECT_FALSE(one.compare(two));
+   EXPECT_TRUE(three.compare(copy));
+ }
+
+TEST(TypesTests, testPersistentVector)
+ {
+   Backwards::Types::PersistentVector<int> vec;
+   std::vector<int> model;
+   std::vector<Backwards::Types::PersistentVector<int> > history;
+   std::vector<std::vector<int> > models;
+
+   unsigned int state = 12345U; // Deterministic "random" operations.
+   for (int step = 0; step < 40000; ++step)
+    {
+      state = state * 1103515245U + 12345U;
+      unsigned int op = (state >> 16) % 16U;
+      int value = static_cast<int>(state >> 8);
+      if ((op < 8U) || (true == model.empty()))
+       {
+         vec.push_back(value);
+         model.push_back(value);
+       }
+      else if (op < 10U)
+       {
+         vec.pop_back();
+         model.pop_back();
+       }
+      else if (op < 11U)
+       {
+         vec.push_front(value);
+         model.insert(model.begin(), value);
+       }
+      else if (op < 12U)
+       {
+         vec.pop_front();
+         model.erase(model.begin());
+       }
+      else
+       {
+         size_t index = (state >> 4) % model.size();
+         vec.set(index, value);
+         model[index] = value;
+       }
+      if (0 == (step % 4000))
+       {
+         history.push_back(vec);
+         models.push_back(model);
+       }
+    }
+
+   ASSERT_EQ(model.size(), vec.size());
+   for (size_t i = 0U; i < model.size(); ++i)
+    {
+      ASSERT_EQ(model[i], vec[i]);
+    }
+   size_t i = 0U;
+   for (int item : vec)
+    {
+      ASSERT_EQ(model[i], item);
+      ++i;
+    }
+   EXPECT_EQ(model.size(), i);
+
+    // Old versions are unchanged.
+   for (size_t j = 0U; j < history.size(); ++j)
+    {
+      ASSERT_EQ(models[j].size(), history[j].size());
+      EXPECT_TRUE(std::equal(models[j].begin(), models[j].end(), history[j].begin()));
+    }
+
+   while (false == vec.empty())
+    {
+      EXPECT_EQ(model.back(), vec.back());
+      vec.pop_back();
+      model.pop_back();
+    }
+   EXPECT_EQ(0U, vec.size());
+   EXPECT_TRUE(vec.begin() == vec.end());
+ }
+
+class TerribleHash final
+ {
+public:
+   size_t operator() (int key) const { return static_cast<size_t>(key % 5); } // Lots of full collisions.
+ };
+
+static bool sameItem(const std::pair<const int, int>& lhs, const std::pair<int, int>& rhs)
+ {
+   return (lhs.first == rhs.first) && (lhs.second == rhs.second);
+ }
+
+template <class Hash>
+static void checkPersistentHashMap()
+ {
+   Backwards::Types::PersistentHashMap<int, int, Hash, std::equal_to<int>, std::less<int> > map;
+   std::map<int, int> model;
+   std::vector<Backwards::Types::PersistentHashMap<int, int, Hash, std::equal_to<int>, std::less<int> > > history;
+   std::vector<std::map<int, int> > models;
+
+   unsigned int state = 54321U;
+   for (int step = 0; step < 20000; ++step)
+    {
+      state = state * 1103515245U + 12345U;
+      unsigned int op = (state >> 16) % 8U;
+      int key = static_cast<int>((state >> 4) % 600U);
+      int value = static_cast<int>(state >> 8);
+      if (op < 5U)
+       {
+         map.set(key, value);
+         model[key] = value;
+       }
+      else
+       {
+         EXPECT_EQ(0U != model.erase(key), map.erase(key));
+       }
+      if (0 == (step % 2000))
+       {
+         history.push_back(map);
+         models.push_back(model);
+       }
+    }
+
+   ASSERT_EQ(model.size(), map.size());
+   for (int key = 0; key < 600; ++key)
+    {
+      const int* found = map.find(key);
+      std::map<int, int>::const_iterator expected = model.find(key);
+      if (model.end() == expected)
+       {
+         EXPECT_TRUE(nullptr == found);
+       }
+      else
+       {
+         ASSERT_TRUE(nullptr != found);
+         EXPECT_EQ(expected->second, *found);
+       }
+    }
+
+    // Iteration is in key order, regardless of the hash.
+   EXPECT_TRUE(std::equal(model.begin(), model.end(), map.begin(), sameItem));
+
+    // Old versions are unchanged.
+   for (size_t j = 0U; j < history.size(); ++j)
+    {
+      ASSERT_EQ(models[j].size(), history[j].size());
+      EXPECT_TRUE(std::equal(models[j].begin(), models[j].end(), history[j].begin(), sameItem));
+    }
+
+   EXPECT_FALSE(map.insert(std::make_pair(model.begin()->first, 0)));
+   EXPECT_EQ(model.begin()->second, *map.find(model.begin()->first));
+
+   for (const std::pair<const int, int>& item : model)
+    {
+      EXPECT_TRUE(map.erase(item.first));
+    }
+   EXPECT_TRUE(map.empty());
+   EXPECT_TRUE(map.begin() == map.end());
+ }
+
+TEST(TypesTests, testPersistentHashMap)
+ {
+   checkPersistentHashMap<std::hash<int> >();
+   checkPersistentHashMap<TerribleHash>();
+
+   Backwards::Types::DictionaryValue one;
+   Backwards::Types::DictionaryValue two;
+   for (int i = 0; i < 100; ++i)
+    {
+      one.value.set(std::make_shared<Backwards::Types::FloatValue>(SlowFloat::SlowFloat(static_cast<double>(i))), std::make_shared<Backwards::Types::StringValue>("A"));
+      two.value.set(std::make_shared<Backwards::Types::FloatValue>(SlowFloat::SlowFloat(static_cast<double>(99 - i))), std::make_shared<Backwards::Types::StringValue>("A"));
+    }
+   one.value.set(std::make_shared<Backwards::Types::StringValue>("B"), std::make_shared<Backwards::Types::FloatValue>(SlowFloat::SlowFloat(1.0)));
+   two.value.set(std::make_shared<Backwards::Types::StringValue>("B"), std::make_shared<Backwards::Types::FloatValue>(SlowFloat::SlowFloat(1.0)));
+   EXPECT_EQ(101U, one.value.size());
+   EXPECT_TRUE(one.equal(two));
+   EXPECT_EQ(one.hash(), two.hash());
+   EXPECT_FALSE(one.sort(two));
+   EXPECT_FALSE(two.sort(one));
+
+    // Keys of different types don't match, and Floats sort before Strings.
+   EXPECT_TRUE(nullptr == one.value.find(std::make_shared<Backwards::Types::StringValue>("0")));
+   EXPECT_TRUE(typeid(Backwards::Types::FloatValue) == typeid(*one.value.begin()->first));
+   EXPECT_EQ(SlowFloat::SlowFloat(0.0), static_cast<const Backwards::Types::FloatValue&>(*one.value.begin()->first).value);
+
+   two.value.set(std::make_shared<Backwards::Types::FloatValue>(SlowFloat::SlowFloat(50.0)), std::make_shared<Backwards::Types::StringValue>("C"));
+   EXPECT_FALSE(one.equal(two));
+   EXPECT_TRUE(two.sort(one)); // one < two
+   EXPECT_FALSE(one.sort(two));
+ }
@@ -0,0 +1,213 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BACKWARDS_ENGINE_BYTECODE_H
+#define BACKWARDS_ENGINE_BYTECODE_H
+
+#include "Backwards/Engine/GetterSetter.h"
+#include "Backwards/Input/Token.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace Backwards
+ {
+
+namespace Engine
+ {
+
+   class Statement;
+   class Expression;
+   class FunctionContext;
+
+    /*
+      An instruction operates on the registers of the running Chunk.
+      Every instruction remembers the Token of the node it was lowered from,
+      and the innermost Region whose error handling it is subject to.
+    */
+   class Instruction final
+    {
+   public:
+
+      enum OpCode : uint8_t
+       {
+         LOADK,     // a = constants[b]
+         GET,       // a = getters[b]
+         VAR,       // a = expressions[b] (a Variable), reading its slot directly
+         SET,       // setters[a] = b
+         ADD,       // a = b + c
+         SUB,
+         MUL,
+         DIV,
+         POW,
+         EQ,        // a = b = c
+         NE,
+         GT,
+         LT,
+         GE,
+         LE,
+         NOT,       // a = not b
+         NEG,       // a = -b
+         INDEX,     // a = b[c]
+         STORE,     // setters[a] = containers b ... b + c - 1 rebuilt with indices b + c ... and value b + 2c (see Assignment::store)
+         JMP,       // goto a
+         JMPF,      // if not a goto b
+         JMPT,      // if a goto b
+         CHECK,     // a is a Function taking b arguments
+         CALL,      // a = b(b + 1 ... b + c)
+         NATIVE,    // a = b(b + 1 ...) called directly if b is expressions[c] (a NativeCall)'s function, else as CALL
+         BUILD,     // a = expressions[b] (a BuildFunction) capturing c ...
+         EVAL,      // a = expressions[b]->evaluate()
+         EXEC,      // statements[a]->execute()
+         ITERPREP,  // iterators[a] = b
+         ITERNEXT,  // a = next(iterators[b]), or goto c
+         FORPREP,   // counters[a] shadows b, which counts by c
+         FORSTEP,   // b = b + c, counted by counters[a] when it can be
+         RET,       // return a (if there is one)
+         TAILCALL,  // return a call of a(a + 1 ... a + b), for the caller to make in this frame
+         FLOW       // break/continue to loop a (b is the type)
+       };
+
+      static const uint32_t NO_REGION;
+      static const uint32_t NO_REGISTER;
+
+      OpCode op;
+      uint32_t a;
+      uint32_t b;
+      uint32_t c;
+      uint32_t token;
+      uint32_t region;
+
+      Instruction(OpCode op, uint32_t a, uint32_t b, uint32_t c, uint32_t token, uint32_t region);
+    };
+
+    /*
+      A Region replaces the try/catch that a tree node wraps around part of its work:
+      a TypedOperationException leaving the Region gets the Region's Token appended
+      to its message, and the debugger is entered if the node would have entered it.
+    */
+   class Region final
+    {
+   public:
+      uint32_t token;
+      uint32_t parent;
+      bool debugger;
+
+      Region(uint32_t token, uint32_t parent, bool debugger);
+    };
+
+    // Where a loop's break and continue go, for flow control returned by a fall-back Statement.
+   class Loop final
+    {
+   public:
+      size_t id;
+      size_t breakTarget;
+      size_t continueTarget;
+
+      Loop(size_t id, size_t breakTarget, size_t continueTarget);
+    };
+
+   class Chunk final
+    {
+   public:
+      static const uint32_t NO_LINE;
+
+      std::vector<Instruction> code;
+
+      std::vector<Types::Value> constants;
+      std::vector<std::shared_ptr<Getter> > getters;
+      std::vector<std::shared_ptr<Setter> > setters;
+      std::vector<const Expression*> expressions;
+      std::vector<const Statement*> statements;
+
+      std::vector<const Input::Token*> tokens;
+      std::vector<Region> regions;
+      std::vector<Loop> loops;
+      std::vector<uint32_t> lines; // For each instruction, the Token of the statement that starts there (if one does), for the Profiler.
+
+      size_t registers;
+      size_t iterators;
+      size_t counters;
+
+       // If the function body is something the compiler doesn't understand (like a standard library function),
+       // the Chunk has no code and the VM executes the Statement directly.
+      const Statement* native;
+
+      Chunk();
+    };
+
+   class Compiler final
+    {
+   public:
+       // The Statement must outlive the Chunk: the Chunk refers to the tree's Tokens and fall-back nodes.
+      static std::shared_ptr<Chunk> Compile (const Statement&);
+
+   private:
+
+      class PendingLoop final
+       {
+      public:
+         size_t id;
+         std::vector<size_t> breaks;
+         std::vector<size_t> continues;
+
+         PendingLoop(size_t id);
+       };
+
+      Chunk& chunk;
+      uint32_t top;
+      uint32_t pendingLine; // The Token of a statement whose first instruction hasn't been emitted yet.
+      std::vector<uint32_t> activeRegions;
+      std::vector<PendingLoop> activeLoops;
+
+      Compiler(Chunk&);
+
+      size_t emit (Instruction::OpCode, uint32_t a, uint32_t b, uint32_t c, const Input::Token&);
+      void patch (size_t location, size_t target);
+      void patch (const std::vector<size_t>& locations, size_t target);
+
+      uint32_t token (const Input::Token&);
+      uint32_t constant (const std::shared_ptr<Types::ValueType>&);
+      uint32_t allocate ();
+
+      void line (const Statement&);
+      void pushRegion (const Input::Token&, bool debugger);
+      void popRegion ();
+
+      void statement (const Statement&);
+      void expression (const Expression&, uint32_t target);
+    };
+
+ } // namespace Engine
+
+ } // namespace Backwards
+
+#endif /* BACKWARDS_ENGINE_BYTECODE_H */
@@ -32,9 +32,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef BACKWARDS_ENGINE_CALLINGCONTEXT_H
 #define BACKWARDS_ENGINE_CALLINGCONTEXT_H
 
-#include "Backwards/Types/ValueType.h"
+#include "Backwards/Types/Value.h"
 #include "Backwards/Engine/GetterSetter.h"
 #include "Backwards/Engine/Scope.h"
+#include "Backwards/Engine/ValueStack.h"
 
 #include <vector>
 
@@ -51,6 +52,7 @@ namespace Engine
 
    class DebuggerHook;
    class Logger;
+   class Profiler;
    class StackFrame;
    class Statement;
 
@@ -65,11 +67,17 @@ namespace Engine
 
       Logger* logger;
       DebuggerHook* debugger;
+      Profiler* profiler; // Times calls and counts lines when set.
 
       StackFrame* currentFrame;
       Scope* globalScope;
 
-      Scope* topScope();
+      bool useBytecode; // Run function bodies on the VirtualMachine rather than walking the tree.
+
+      ValueStack values; // Where StackFrames and the VirtualMachine get their Values.
+      std::vector<Types::Value> tailArgs; // The arguments of a tail call, on their way to the frame it reuses.
+
+      Scope* topScope() { return (true == scopes.empty()) ? nullptr : scopes.back(); }
       void pushScope(Scope* scope);
       void popScope();
 
@@ -88,7 +96,8 @@ namespace Engine
       size_t location;
    public:
       GlobalGetter(size_t location);
-      std::shared_ptr<Types::ValueType> get(CallingContext&) const;
+      Types::Value get(CallingContext&) const;
+      size_t getLocation() const { return location; }
     };
 
    class GlobalSetter final : public Setter
@@ -97,7 +106,7 @@ namespace Engine
       size_t location;
    public:
       GlobalSetter(size_t location);
-      void set(CallingContext&, const std::shared_ptr<Types::ValueType>&) const;
+      void set(CallingContext&, const Types::Value&) const;
     };
 
    class ScopeGetter final : public Getter
@@ -106,7 +115,8 @@ namespace Engine
       size_t location;
    public:
       ScopeGetter(size_t location);
-      std::shared_ptr<Types::ValueType> get(CallingContext&) const;
+      Types::Value get(CallingContext&) const;
+      size_t getLocation() const { return location; }
     };
 
    class ScopeSetter final : public Setter
@@ -115,7 +125,7 @@ namespace Engine
       size_t location;
    public:
       ScopeSetter(size_t location);
-      void set(CallingContext&, const std::shared_ptr<Types::ValueType>&) const;
+      void set(CallingContext&, const Types::Value&) const;
     };
 
    typedef std::shared_ptr<Types::ValueType> (*ConstantFunctionPointer)(void);
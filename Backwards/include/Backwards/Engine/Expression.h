@@ -35,6 +35,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Engine/CallingContext.h"
 #include "Backwards/Input/Token.h"
 
+#include <atomic>
+#include <cstdint>
+
 namespace Backwards
  {
 
@@ -53,7 +56,7 @@ namespace Engine
 
        /* CallingContext can't be const, because if we propagate it
           to a function call, the function call is allowed to modify it. */
-      virtual std::shared_ptr<Types::ValueType> evaluate (CallingContext&) const = 0;
+      virtual Types::Value evaluate (CallingContext&) const = 0;
 
       static std::string constructMessage(const Types::TypedOperationException&, const Input::Token&);
       std::string constructMessage(const Types::TypedOperationException&) const;
@@ -66,7 +69,7 @@ namespace Engine
 
       Constant(const Input::Token&, const std::shared_ptr<Types::ValueType>&);
 
-      std::shared_ptr<Types::ValueType> evaluate (CallingContext&) const;
+      Types::Value evaluate (CallingContext&) const;
     };
 
    class Variable final : public Expression
@@ -74,9 +77,25 @@ namespace Engine
    public:
       std::shared_ptr<Getter> getter;
 
+       // Where the getter reads from, so that the common cases read the slot directly.
+       // The getter is still called to report the errors.
+      enum Access : uint8_t
+       {
+         GETTER,
+         GLOBAL,
+         SET_GLOBAL, // A global that was set when this was parsed: globals are never unset.
+         SCOPE,
+         LOCAL,
+         ARG
+       };
+
+      Access access;
+      size_t location;
+      mutable std::atomic<size_t> epoch; // Of the last Scope this read from: its bounds are known to be good.
+
       Variable(const Input::Token&, const std::shared_ptr<Getter>&);
 
-      std::shared_ptr<Types::ValueType> evaluate (CallingContext& context) const;
+      Types::Value evaluate (CallingContext& context) const;
     };
 
 #define BinaryOperation(x) \
@@ -85,7 +104,7 @@ namespace Engine
    public: \
       std::shared_ptr<Expression> lhs, rhs; \
       x(const Input::Token&, const std::shared_ptr<Expression>&, const std::shared_ptr<Expression>&); \
-      std::shared_ptr<Types::ValueType> evaluate (CallingContext&) const; \
+      Types::Value evaluate (CallingContext&) const; \
     };
 
    BinaryOperation(Plus)
@@ -110,7 +129,7 @@ namespace Engine
    public: \
       std::shared_ptr<Expression> arg; \
       x(const Input::Token&, const std::shared_ptr<Expression>&); \
-      std::shared_ptr<Types::ValueType> evaluate (CallingContext&) const; \
+      Types::Value evaluate (CallingContext&) const; \
     };
 
    UnaryOperation(Not)
@@ -126,7 +145,36 @@ namespace Engine
 
       FunctionCall(const Input::Token&, const std::shared_ptr<Expression>&, const std::vector<std::shared_ptr<Expression> >&);
 
-      std::shared_ptr<Types::ValueType> evaluate (CallingContext&) const;
+      Types::Value evaluate (CallingContext&) const;
+      Types::Value evaluate (CallingContext&, const Types::Value& function) const; // With the location already evaluated.
+      Types::Value prepare (CallingContext&) const; // For a tail call: checks the function and moves the arguments to the context.
+    };
+
+    /*
+      A call to a standard library function, bound when the script was parsed.
+      It calls the function pointer directly, without building a StackFrame,
+      as long as the location still holds the function it was bound to.
+      If it doesn't, it does what the FunctionCall it replaced would have done.
+    */
+   class NativeCall final : public Expression
+    {
+   public:
+      std::shared_ptr<FunctionCall> call;
+      std::shared_ptr<Types::ValueType> expected;
+
+       // Exactly one of these is set, according to the number of arguments.
+      ConstantFunctionPointer constant;
+      UnaryFunctionPointer unary;
+      BinaryFunctionPointer binary;
+      TernaryFunctionPointer ternary;
+
+      NativeCall(const std::shared_ptr<FunctionCall>&, const std::shared_ptr<Types::ValueType>&);
+
+       // Returns the call unchanged if the value isn't a standard library function that can be called directly.
+      static std::shared_ptr<Expression> bind (const std::shared_ptr<FunctionCall>&, const std::shared_ptr<Types::ValueType>&);
+
+      Types::Value evaluate (CallingContext&) const;
+      Types::Value apply (const Types::Value* args) const; // No error handling: the caller provides it.
     };
 
 
@@ -141,7 +189,7 @@ namespace Engine
       BuildFunction(const Input::Token&, const std::shared_ptr<FunctionContext>&, const std::vector<std::shared_ptr<Expression> >&);
       BuildFunction(const Input::Token&, const std::vector<std::shared_ptr<Expression> >&, const std::weak_ptr<FunctionContext>&);
 
-      std::shared_ptr<Types::ValueType> evaluate (CallingContext&) const;
+      Types::Value evaluate (CallingContext&) const;
     };
 
 
@@ -154,7 +202,7 @@ namespace Engine
       TernaryOperation(const Input::Token&,
          const std::shared_ptr<Expression>&, const std::shared_ptr<Expression>&, const std::shared_ptr<Expression>&);
 
-      std::shared_ptr<Types::ValueType> evaluate (CallingContext&) const;
+      Types::Value evaluate (CallingContext&) const;
     };
 
  } // namespace Engine
@@ -45,6 +45,7 @@ namespace Engine
  {
 
    class Statement;
+   class Chunk;
 
    class FunctionContext final : public Types::FunctionObjectHolder
     {
@@ -63,6 +64,8 @@ namespace Engine
       std::vector<std::string> argNames;
       std::vector<std::string> localNames;
       std::vector<std::string> captureNames;
+
+      std::shared_ptr<Chunk> compiled; // The function, as compiled for the VirtualMachine. Built on first use.
     };
 
  } // namespace Engine
@@ -32,7 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef BACKWARDS_ENGINE_GETTERSETTER_H
 #define BACKWARDS_ENGINE_GETTERSETTER_H
 
-#include "Backwards/Types/ValueType.h"
+#include "Backwards/Types/Value.h"
 
 namespace Backwards
  {
@@ -46,14 +46,14 @@ namespace Engine
     {
    public:
       virtual ~Getter() = default;
-      virtual std::shared_ptr<Types::ValueType> get(CallingContext&) const = 0;
+      virtual Types::Value get(CallingContext&) const = 0;
     };
 
    class Setter
     {
    public:
       virtual ~Setter() = default;
-      virtual void set(CallingContext&, const std::shared_ptr<Types::ValueType>&) const = 0;
+      virtual void set(CallingContext&, const Types::Value&) const = 0;
     };
 
  } // namespace Engine
@@ -0,0 +1,142 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BACKWARDS_ENGINE_PROFILER_H
+#define BACKWARDS_ENGINE_PROFILER_H
+
+#include "Backwards/Input/Token.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Backwards
+ {
+
+namespace Engine
+ {
+
+   class FunctionContext;
+
+    /*
+      Counts where a script spends its time. Hook one onto a CallingContext, and every call made
+      with a StackFrame is timed, and every statement run is counted against its line.
+      A while loop's line is counted each time its condition is tested.
+      Standard library functions that are called directly have no frame: their time is their caller's.
+      A Profiler belongs to one CallingContext: it isn't safe to share between threads.
+    */
+   class Profiler final
+    {
+   public:
+
+      class FunctionStats final
+       {
+      public:
+         std::shared_ptr<FunctionContext> function;
+         size_t calls;
+         uint64_t inclusive; // Nanoseconds from call to return. The time of recursive calls is only counted once.
+         uint64_t exclusive; // Nanoseconds not spent in the functions it called.
+         size_t active; // Its calls that haven't returned yet.
+
+         FunctionStats(const std::shared_ptr<FunctionContext>& function);
+       };
+
+      class LineStats final
+       {
+      public:
+         std::string sourceFile;
+         size_t lineNumber;
+         size_t hits;
+
+         LineStats(const std::string& sourceFile, size_t lineNumber, size_t hits);
+       };
+
+      Profiler();
+
+      void enter (const std::shared_ptr<FunctionContext>& function);
+      void leave ();
+      void line (const Input::Token& token);
+
+      void clear ();
+
+       // By exclusive time, then by name.
+      std::vector<FunctionStats> getFunctions () const;
+       // By hits, then by location. Statements on the same line are counted together.
+      std::vector<LineStats> getLines () const;
+
+       // One line per call path, "outer;inner exclusive-nanoseconds": the input to flamegraph.pl.
+      std::string folded () const;
+       // The count functions with the most exclusive time, and the count most-hit lines.
+      std::string report (size_t count) const;
+
+      static const std::string& nameOf (const FunctionContext& function);
+
+   private:
+
+       // A call path: the function called, and from where.
+      class Node final
+       {
+      public:
+         size_t function;
+         size_t parent;
+         std::map<size_t, size_t> children; // function to Node
+         uint64_t exclusive;
+
+         Node(size_t function, size_t parent);
+       };
+
+      class Active final
+       {
+      public:
+         size_t node;
+         std::chrono::steady_clock::time_point start;
+         uint64_t children; // Nanoseconds spent in calls made from this one.
+
+         Active(size_t node, std::chrono::steady_clock::time_point start);
+       };
+
+      std::vector<FunctionStats> functions;
+      std::unordered_map<const FunctionContext*, size_t> functionIndex;
+      std::vector<Node> nodes; // The first is the root of every path.
+      std::vector<Active> stack;
+       // Statements can be freed while the Profiler lives (by Eval), so remember where they were on first sight.
+      std::unordered_map<const Input::Token*, LineStats> tokens;
+    };
+
+ } // namespace Engine
+
+ } // namespace Backwards
+
+#endif /* BACKWARDS_ENGINE_PROFILER_H */
@@ -32,8 +32,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef BACKWARDS_ENGINE_SCOPE_H
 #define BACKWARDS_ENGINE_SCOPE_H
 
-#include "Backwards/Types/ValueType.h"
+#include "Backwards/Types/Value.h"
 
+#include <atomic>
 #include <map>
 #include <vector>
 #include <string>
@@ -49,10 +50,23 @@ namespace Engine
    public:
       std::string name;
 
-      std::vector<std::shared_ptr<Types::ValueType> > vars;
+      std::vector<Types::Value> vars;
 
       std::map<std::string, size_t> var;
       std::vector<std::string> names;
+
+       // Unique to this Scope, so that a Variable can remember having checked its bounds here,
+       // without being fooled by another Scope later made at the same address.
+      size_t epoch;
+
+      Scope() : name(), vars(), var(), names(), epoch(nextEpoch()) { }
+
+   private:
+      static size_t nextEpoch()
+       {
+         static std::atomic<size_t> counter (0U);
+         return ++counter;
+       }
    };
 
  } // namespace Engine
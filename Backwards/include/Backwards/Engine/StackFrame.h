@@ -32,36 +32,80 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef BACKWARDS_ENGINE_STACKFRAME_H
 #define BACKWARDS_ENGINE_STACKFRAME_H
 
-#include "Backwards/Types/ValueType.h"
+#include "Backwards/Types/Value.h"
 #include "Backwards/Engine/GetterSetter.h"
+#include "Backwards/Engine/ValueStack.h"
 
 #include <vector>
 
 namespace Backwards
  {
 
+namespace Types
+ {
+   class FunctionValue;
+ }
+
 namespace Engine
  {
 
    class CallingContext;
    class FunctionContext;
 
+    // The captures of the function being called. They are read from the FunctionValue, which the caller keeps alive,
+    // and only copied if the function assigns to one.
+   class CaptureValues final
+    {
+   private:
+      const std::vector<std::shared_ptr<Types::ValueType> >* shared;
+      std::vector<Types::Value> owned;
+      bool copied;
+
+      void copy()
+       {
+         if (false == copied)
+          {
+            owned.assign(shared->begin(), shared->end());
+            copied = true;
+          }
+       }
+
+   public:
+      CaptureValues() : shared(nullptr), owned(), copied(true) { }
+      explicit CaptureValues(const std::vector<std::shared_ptr<Types::ValueType> >& captures) : shared(&captures), owned(), copied(false) { }
+
+      Types::Value get(size_t index) const { return (true == copied) ? owned[index] : Types::Value((*shared)[index]); }
+      void set(size_t index, const Types::Value& value) { copy(); owned[index] = value; }
+
+      Types::Value& operator[] (size_t index) { copy(); return owned[index]; }
+      size_t size() const { return (true == copied) ? owned.size() : shared->size(); }
+      void resize(size_t count) { copy(); owned.resize(count); }
+    };
+
    class StackFrame final
     {
    public:
       std::shared_ptr<FunctionContext> function;
 
-      std::vector<std::shared_ptr<Types::ValueType> > args;
-      std::vector<std::shared_ptr<Types::ValueType> > locals;
-      std::vector<std::shared_ptr<Types::ValueType> > captures;
+      FrameValues args;
+      FrameValues locals;
+      CaptureValues captures;
 
       StackFrame* prev;
       StackFrame* next;
 
       const Input::Token& callingToken;
       size_t depth;
+      size_t tailCalls; // How many functions have reused this frame: the backtrace can't show them.
 
+       // A frame that owns its Values, for the debugger and the like.
       StackFrame(std::shared_ptr<FunctionContext> function, const Input::Token& callingToken, StackFrame* prev);
+       // A frame for a call from the current frame of context, on its ValueStack.
+      StackFrame(CallingContext& context, std::shared_ptr<FunctionContext> function, const Input::Token& callingToken,
+         const std::vector<std::shared_ptr<Types::ValueType> >& captures);
+
+       // Reuse this frame for a tail call to callee (which the caller keeps alive), taking the arguments from the context's tailArgs.
+      void retarget(CallingContext& context, const Types::FunctionValue& callee);
     };
 
    class LocalGetter final : public Getter
@@ -70,7 +114,8 @@ namespace Engine
       size_t location;
    public:
       LocalGetter(size_t location);
-      std::shared_ptr<Types::ValueType> get(CallingContext&) const;
+      Types::Value get(CallingContext&) const;
+      size_t getLocation() const { return location; }
     };
 
    class LocalSetter final : public Setter
@@ -79,7 +124,7 @@ namespace Engine
       size_t location;
    public:
       LocalSetter(size_t location);
-      void set(CallingContext&, const std::shared_ptr<Types::ValueType>&) const;
+      void set(CallingContext&, const Types::Value&) const;
     };
 
    class ArgGetter final : public Getter
@@ -88,7 +133,8 @@ namespace Engine
       size_t location;
    public:
       ArgGetter(size_t location);
-      std::shared_ptr<Types::ValueType> get(CallingContext&) const;
+      Types::Value get(CallingContext&) const;
+      size_t getLocation() const { return location; }
     };
 
    class ArgSetter final : public Setter
@@ -97,7 +143,7 @@ namespace Engine
       size_t location;
    public:
       ArgSetter(size_t location);
-      void set(CallingContext&, const std::shared_ptr<Types::ValueType>&) const;
+      void set(CallingContext&, const Types::Value&) const;
     };
 
    class CaptureGetter final : public Getter
@@ -106,7 +152,7 @@ namespace Engine
       size_t location;
    public:
       CaptureGetter(size_t location);
-      std::shared_ptr<Types::ValueType> get(CallingContext&) const;
+      Types::Value get(CallingContext&) const;
     };
 
    class CaptureSetter final : public Setter
@@ -115,7 +161,7 @@ namespace Engine
       size_t location;
    public:
       CaptureSetter(size_t location);
-      void set(CallingContext&, const std::shared_ptr<Types::ValueType>&) const;
+      void set(CallingContext&, const Types::Value&) const;
     };
 
  } // namespace Engine
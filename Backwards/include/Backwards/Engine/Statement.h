@@ -35,7 +35,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Engine/CallingContext.h"
 
 #include "Backwards/Input/Token.h"
-#include "Backwards/Types/ValueType.h"
+#include "Backwards/Types/Value.h"
+
+#include "SlowFloat.h"
 
 #include <string>
 #include <vector>
@@ -49,26 +51,32 @@ namespace Engine
 
    class Expression;
 
+    /*
+      The result of executing a Statement. It is returned by value, so that
+      finishing a Statement normally (NONE) doesn't cost an allocation.
+    */
    class FlowControl final
     {
    public:
 
       enum Type
        {
+         NONE,
          RETURN,
          BREAK,
-         CONTINUE
+         CONTINUE,
+         TAIL_CALL // value is the Function to call in place of the current one, with the context's tailArgs.
        };
 
       static const size_t NO_TARGET;
 
-      const Input::Token& source;
+      const Input::Token* source;
       Type type;
       size_t target;
-      std::shared_ptr<Types::ValueType> value;
+      Types::Value value;
 
-      FlowControl(const Input::Token&, Type, size_t, const std::shared_ptr<Types::ValueType>&);
-      ~FlowControl() = default;
+      FlowControl();
+      FlowControl(const Input::Token&, Type, size_t, const Types::Value&);
     };
 
    class Statement
@@ -81,7 +89,7 @@ namespace Engine
 
        /* CallingContext can't be const, because if we propagate it
           to a function call, the function call is allowed to modify it. */
-      virtual std::shared_ptr<FlowControl> execute (CallingContext&) const = 0;
+      virtual FlowControl execute (CallingContext&) const = 0;
     };
 
    class NOP final : public Statement
@@ -89,7 +97,7 @@ namespace Engine
    public:
       NOP(const Input::Token&);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const;
+      FlowControl execute (CallingContext&) const;
     };
 
    class Expr final : public Statement
@@ -99,7 +107,7 @@ namespace Engine
 
       Expr(const Input::Token&, const std::shared_ptr<Expression>&);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const;
+      FlowControl execute (CallingContext&) const;
     };
 
    class StatementSeq final : public Statement
@@ -109,7 +117,7 @@ namespace Engine
 
       StatementSeq(const Input::Token&, const std::vector<std::shared_ptr<Statement> >&);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const;
+      FlowControl execute (CallingContext&) const;
     };
 
    class RecAssignState final
@@ -122,11 +130,7 @@ namespace Engine
 
       RecAssignState(const Input::Token&, const std::shared_ptr<Expression>&);
 
-      std::shared_ptr<Types::ValueType> evaluate (CallingContext&, const std::shared_ptr<Types::ValueType>& lhs, const std::shared_ptr<Expression>& rhs) const;
-
       std::shared_ptr<Types::ValueType> getIndex (std::shared_ptr<Types::ValueType> container, std::shared_ptr<Types::ValueType> index, CallingContext&) const;
-      std::shared_ptr<Types::ValueType> setIndex (std::shared_ptr<Types::ValueType> container, std::shared_ptr<Types::ValueType> index,
-         std::shared_ptr<Types::ValueType> value, CallingContext&) const;
     };
 
    class Assignment final : public Statement
@@ -140,7 +144,11 @@ namespace Engine
       Assignment(const Input::Token&, const std::shared_ptr<Getter>&, const std::shared_ptr<Setter>&,
          const std::shared_ptr<RecAssignState>&, const std::shared_ptr<Expression>&);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const;
+      FlowControl execute (CallingContext&) const;
+
+       // Put value into the last of count containers (each indexed out of the one before), rebuild the containers, and set the variable.
+       // Takes the containers. Containers that nothing else refers to are updated in place.
+      static void store (CallingContext&, const Setter&, Types::Value* containers, const Types::Value* indices, size_t count, const Types::Value& value);
     };
 
    class IfStatement final : public Statement
@@ -152,7 +160,7 @@ namespace Engine
 
       IfStatement(const Input::Token&, const std::shared_ptr<Expression>&, const std::shared_ptr<Statement>&, const std::shared_ptr<Statement>&);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const;
+      FlowControl execute (CallingContext&) const;
     };
 
    class WhileStatement final : public Statement
@@ -164,7 +172,7 @@ namespace Engine
 
       WhileStatement(const Input::Token&, const std::shared_ptr<Expression>&, const std::shared_ptr<Statement>&, size_t);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const;
+      FlowControl execute (CallingContext&) const;
     };
 
    class CaseContainer final
@@ -188,7 +196,7 @@ namespace Engine
 
       CaseContainer(const Input::Token&, bool, CaseType, const std::shared_ptr<Expression>&, const std::shared_ptr<Expression>&, const std::shared_ptr<Statement>&);
 
-      bool evaluate (CallingContext&, const std::shared_ptr<Types::ValueType>&) const;
+      bool evaluate (CallingContext&, const Types::Value&) const;
     };
 
    class SelectStatement final : public Statement
@@ -199,16 +207,20 @@ namespace Engine
 
       SelectStatement(const Input::Token&, const std::shared_ptr<Expression>&, const std::vector<std::shared_ptr<CaseContainer> >&);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const;
+      FlowControl execute (CallingContext&) const;
     };
 
    class ForStatement final : public Statement
     {
    private:
-      std::shared_ptr<FlowControl> loopIter (CallingContext&, std::shared_ptr<Types::ValueType>) const;
-      std::shared_ptr<FlowControl> collIter (CallingContext&, std::shared_ptr<Types::ValueType>) const;
+      FlowControl loopIter (CallingContext&, Types::Value) const;
+      FlowControl numericIter (CallingContext&, Types::Value, const SlowFloat::SlowFloat&, const SlowFloat::SlowFloat&) const;
+      FlowControl collIter (CallingContext&, std::shared_ptr<Types::ValueType>) const;
 
    public:
+       // Every integer up to this is exactly a Float, so a numeric loop can count with an integer instead.
+      static const int64_t MAX_COUNTER;
+
       std::shared_ptr<Getter> getter;
       std::shared_ptr<Setter> setter;
       std::shared_ptr<Expression> lower;
@@ -222,7 +234,7 @@ namespace Engine
          const std::shared_ptr<Expression>&, bool, const std::shared_ptr<Expression>&,
          const std::shared_ptr<Expression>&, const std::shared_ptr<Statement>&, size_t);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const;
+      FlowControl execute (CallingContext&) const;
     };
 
    class FlowControlStatement final : public Statement
@@ -231,10 +243,11 @@ namespace Engine
       FlowControl::Type type;
       size_t target;
       std::shared_ptr<Expression> value;
+      bool tailCall; // A return of a FunctionCall, run by reusing the frame of the function returning.
 
       FlowControlStatement(const Input::Token&, FlowControl::Type, size_t, const std::shared_ptr<Expression>&);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const;
+      FlowControl execute (CallingContext&) const;
     };
 
    class StandardConstantFunction final : public Statement
@@ -242,7 +255,7 @@ namespace Engine
    public:
       ConstantFunctionPointer function;
       StandardConstantFunction(ConstantFunctionPointer);
-      std::shared_ptr<FlowControl> execute (CallingContext&) const;
+      FlowControl execute (CallingContext&) const;
     };
 
    class StandardConstantFunctionWithContext final : public Statement
@@ -250,7 +263,7 @@ namespace Engine
    public:
       ConstantFunctionPointerWithContext function;
       StandardConstantFunctionWithContext(ConstantFunctionPointerWithContext);
-      std::shared_ptr<FlowControl> execute (CallingContext&) const;
+      FlowControl execute (CallingContext&) const;
     };
 
    class StandardUnaryFunction final : public Statement
@@ -258,7 +271,7 @@ namespace Engine
    public:
       UnaryFunctionPointer function;
       StandardUnaryFunction(UnaryFunctionPointer);
-      std::shared_ptr<FlowControl> execute (CallingContext&) const;
+      FlowControl execute (CallingContext&) const;
     };
 
    class StandardUnaryFunctionWithContext final : public Statement
@@ -266,7 +279,7 @@ namespace Engine
    public:
       UnaryFunctionPointerWithContext function;
       StandardUnaryFunctionWithContext(UnaryFunctionPointerWithContext);
-      std::shared_ptr<FlowControl> execute (CallingContext&) const;
+      FlowControl execute (CallingContext&) const;
     };
 
    class StandardBinaryFunction final : public Statement
@@ -274,7 +287,7 @@ namespace Engine
    public:
       BinaryFunctionPointer function;
       StandardBinaryFunction(BinaryFunctionPointer);
-      std::shared_ptr<FlowControl> execute (CallingContext&) const;
+      FlowControl execute (CallingContext&) const;
     };
 
    class StandardTernaryFunction final : public Statement
@@ -282,7 +295,7 @@ namespace Engine
    public:
       TernaryFunctionPointer function;
       StandardTernaryFunction(TernaryFunctionPointer);
-      std::shared_ptr<FlowControl> execute (CallingContext&) const;
+      FlowControl execute (CallingContext&) const;
     };
 
  } // namespace Engine
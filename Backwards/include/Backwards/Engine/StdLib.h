@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define BACKWARDS_ENGINE_STDLIB_H
 
 #include "Backwards/Types/ValueType.h"
+#include "Backwards/Types/Value.h"
 
 namespace Backwards
  {
@@ -132,6 +133,31 @@ namespace Engine
    STDLIB_TERNARY_DECL(SetIndex);
    STDLIB_TERNARY_DECL(Insert);
 
+    // GetIndex, for the engine: an element of a packed Array comes back as an inline Float rather than boxed.
+   Types::Value GetElement (const Types::Value& first, const Types::Value& second);
+
+    // These take over the caller's reference to the container. If that was the only reference to it,
+    // the container is changed in place instead of copied. The caller's reference is left alone if they throw.
+#define STDLIB_UNARY_INPLACE_DECL(x) \
+   std::shared_ptr<Types::ValueType> x##InPlace (std::shared_ptr<Types::ValueType>&& arg)
+
+   STDLIB_UNARY_INPLACE_DECL(PopBack);
+   STDLIB_UNARY_INPLACE_DECL(PopFront);
+
+#define STDLIB_BINARY_INPLACE_DECL(x) \
+   std::shared_ptr<Types::ValueType> x##InPlace (std::shared_ptr<Types::ValueType>&& first, const std::shared_ptr<Types::ValueType>& second)
+
+   STDLIB_BINARY_INPLACE_DECL(PushBack);
+   STDLIB_BINARY_INPLACE_DECL(PushFront);
+   STDLIB_BINARY_INPLACE_DECL(RemoveKey);
+
+#define STDLIB_TERNARY_INPLACE_DECL(x) \
+   std::shared_ptr<Types::ValueType> x##InPlace \
+      (std::shared_ptr<Types::ValueType>&& first, const std::shared_ptr<Types::ValueType>& second, const std::shared_ptr<Types::ValueType>& third)
+
+   STDLIB_TERNARY_INPLACE_DECL(SetIndex);
+   STDLIB_TERNARY_INPLACE_DECL(Insert);
+
  } // namespace Engine
 
  } // namespace Backwards
@@ -0,0 +1,125 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BACKWARDS_ENGINE_VALUESTACK_H
+#define BACKWARDS_ENGINE_VALUESTACK_H
+
+#include "Backwards/Types/Value.h"
+
+#include <memory>
+#include <vector>
+
+namespace Backwards
+ {
+
+namespace Engine
+ {
+
+    /*
+      The Values for the frames of one CallingContext: arguments, locals and VirtualMachine registers.
+      Frames take slices off of the top and give them back in the reverse order, so a call costs a pointer bump
+      rather than an allocation. The stack grows a block at a time, and a block never moves once made.
+    */
+   class ValueStack final
+    {
+   private:
+      std::vector<std::unique_ptr<Types::Value[]> > blocks;
+      std::vector<size_t> sizes;
+      std::vector<size_t> tops;
+      size_t current;
+
+   public:
+      static const size_t BLOCK_SIZE = 256U;
+
+      ValueStack();
+
+       // CallingContexts are copied as templates for new ones: a copy starts with nothing in use.
+      ValueStack(const ValueStack&) : ValueStack() { }
+      ValueStack& operator= (const ValueStack&) { return *this; }
+
+      Types::Value* carve (size_t count);
+      void release (Types::Value* base, size_t count); // Must be the most recent slice still out.
+
+      size_t inUse() const;
+    };
+
+    // A slice of Values for a frame. Without a ValueStack, it owns its Values.
+   class FrameValues final
+    {
+   private:
+      ValueStack* stack;
+      std::unique_ptr<Types::Value[]> owned;
+      Types::Value* values;
+      size_t count;
+
+   public:
+      FrameValues(ValueStack& stack, size_t count) : stack(&stack), owned(), values(stack.carve(count)), count(count) { }
+      explicit FrameValues(size_t count) : stack(nullptr), owned(new Types::Value[count]), values(owned.get()), count(count) { }
+      ~FrameValues()
+       {
+         if (nullptr != stack)
+          {
+            stack->release(values, count);
+          }
+       }
+
+       // Gives back the Values and takes count new ones. Anything carved after this slice must be given back first.
+      void reset(size_t newCount)
+       {
+         if (nullptr != stack)
+          {
+            stack->release(values, count);
+            values = stack->carve(newCount);
+          }
+         else
+          {
+            owned.reset(new Types::Value[newCount]);
+            values = owned.get();
+          }
+         count = newCount;
+       }
+
+      FrameValues(const FrameValues&) = delete;
+      FrameValues& operator= (const FrameValues&) = delete;
+
+      Types::Value& operator[] (size_t index) { return values[index]; }
+      const Types::Value& operator[] (size_t index) const { return values[index]; }
+      size_t size() const { return count; }
+
+      Types::Value* begin() { return values; }
+      Types::Value* end() { return values + count; }
+    };
+
+ } // namespace Engine
+
+ } // namespace Backwards
+
+#endif /* BACKWARDS_ENGINE_VALUESTACK_H */
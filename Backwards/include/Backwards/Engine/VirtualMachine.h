@@ -0,0 +1,64 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BACKWARDS_ENGINE_VIRTUALMACHINE_H
+#define BACKWARDS_ENGINE_VIRTUALMACHINE_H
+
+#include "Backwards/Engine/CallingContext.h"
+
+namespace Backwards
+ {
+
+namespace Engine
+ {
+
+   class Chunk;
+   class FlowControl;
+   class FunctionContext;
+   class Statement;
+
+   class VirtualMachine final
+    {
+   public:
+       // Compile and run a top-level Statement, as Statement::execute would.
+      static FlowControl Execute (const Statement&, CallingContext&);
+
+       // Run the body of a function, compiling it the first time. The StackFrame must already be pushed.
+      static FlowControl Invoke (FunctionContext&, CallingContext&);
+
+      static FlowControl Run (const Chunk&, CallingContext&);
+    };
+
+ } // namespace Engine
+
+ } // namespace Backwards
+
+#endif /* BACKWARDS_ENGINE_VIRTUALMACHINE_H */
@@ -0,0 +1,81 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BACKWARDS_PARSER_OPTIMIZER_H
+#define BACKWARDS_PARSER_OPTIMIZER_H
+
+#include <memory>
+#include <set>
+
+namespace Backwards
+ {
+
+namespace Engine
+ {
+   class Statement;
+   class Expression;
+   class FunctionContext;
+ }
+
+namespace Parser
+ {
+
+    /*
+      Cleans up a parse tree before it is run: operators applied to constants are replaced with their results,
+      if/else and ?: with a constant condition are replaced with the arm that will run, and nested statement
+      sequences are flattened. Anything that would throw when run is left alone, so that it throws when run.
+
+      Arithmetic on Floats depends on the rounding mode, which anything can change before the tree is run (another
+      parse, another state, the host), so only results that are the same in every rounding mode are folded.
+    */
+   class Optimizer final
+    {
+   public:
+      static std::shared_ptr<Engine::Statement> Optimize (const std::shared_ptr<Engine::Statement>&);
+      static std::shared_ptr<Engine::Expression> Optimize (const std::shared_ptr<Engine::Expression>&);
+
+   private:
+      std::set<const Engine::FunctionContext*> visited;
+
+      Optimizer();
+
+      std::shared_ptr<Engine::Statement> statement (const std::shared_ptr<Engine::Statement>&);
+      std::shared_ptr<Engine::Expression> expression (const std::shared_ptr<Engine::Expression>&);
+      void function (Engine::FunctionContext*);
+
+      std::shared_ptr<Engine::Expression> fold (const std::shared_ptr<Engine::Expression>&) const;
+    };
+
+ } // namespace Parser
+
+ } // namespace Backwards
+
+#endif /* BACKWARDS_PARSER_OPTIMIZER_H */
@@ -86,6 +86,7 @@ namespace Parser
       void injectContext(const std::shared_ptr<Engine::FunctionContext>&);
       std::shared_ptr<Engine::FunctionContext> getContext();
       void popContext();
+      bool inFunction() const;
 
       void addVariable(const std::string&);
       void addArgument(const std::string&);
@@ -95,9 +96,12 @@ namespace Parser
       std::shared_ptr<Engine::Getter> getVariableGetter(const std::string&) const;
       std::shared_ptr<Engine::Setter> getVariableSetter(const std::string&) const;
 
+      std::shared_ptr<Engine::Expression> buildVariable(const Input::Token&) const;
       std::shared_ptr<Engine::Expression> buildPushBack(const Input::Token&, const std::shared_ptr<Engine::Expression>&, const std::shared_ptr<Engine::Expression>&) const;
       std::shared_ptr<Engine::Expression> buildInsert(const Input::Token&,
          const std::shared_ptr<Engine::Expression>&, const std::shared_ptr<Engine::Expression>&, const std::shared_ptr<Engine::Expression>&) const;
+      std::shared_ptr<Engine::Expression> buildFunctionCall(const Input::Token&,
+         const std::shared_ptr<Engine::Expression>&, const std::vector<std::shared_ptr<Engine::Expression> >&) const;
 
       std::shared_ptr<Engine::Expression> pushBackFun;
       std::shared_ptr<Engine::Expression> insertFun;
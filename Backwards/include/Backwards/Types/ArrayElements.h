@@ -0,0 +1,244 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BACKWARDS_TYPES_ARRAYELEMENTS_H
+#define BACKWARDS_TYPES_ARRAYELEMENTS_H
+
+#include "Backwards/Types/Value.h"
+
+#include "Backwards/Types/PersistentVector.h"
+
+#include <iterator>
+#include <utility>
+
+namespace Backwards
+ {
+
+namespace Types
+ {
+
+   /*
+      The elements of an Array. While every element is a Float, they are packed as SlowFloats, with no
+      allocation per element: reading one gives an inline Float, unless the reader wants a std::shared_ptr,
+      in which case it is boxed. Storing anything else promotes the Array to a vector of references,
+      where it stays. Either way, an Array looks the same to scripts.
+   */
+   class ArrayElements final
+    {
+   private:
+      PersistentVector<SlowFloat::SlowFloat> floats; // While packed.
+      PersistentVector<std::shared_ptr<ValueType> > values; // Once promoted.
+      bool packed;
+
+      static bool isFloat (const Value& value)
+       {
+         return (true == value.isImmediate()) || ((nullptr != value.get()) && (ValueType::FLOAT == value->getType()));
+       }
+
+      static const SlowFloat::SlowFloat& getFloat (const Value& value)
+       {
+         return static_cast<const FloatValue&>(*value).value;
+       }
+
+      void promote()
+       {
+         for (PersistentVector<SlowFloat::SlowFloat>::const_iterator iter = floats.begin(); floats.end() != iter; ++iter)
+          {
+            values.push_back(std::make_shared<FloatValue>(*iter));
+          }
+         floats.clear();
+         packed = false;
+       }
+
+   public:
+      class const_iterator final
+       {
+      private:
+         PersistentVector<SlowFloat::SlowFloat>::const_iterator floatIter;
+         PersistentVector<std::shared_ptr<ValueType> >::const_iterator valueIter;
+         bool packed;
+
+      public:
+         typedef std::forward_iterator_tag iterator_category;
+         typedef Value value_type;
+         typedef std::ptrdiff_t difference_type;
+         typedef const Value* pointer;
+         typedef Value reference;
+
+         const_iterator() : packed(true) { }
+         const_iterator(const PersistentVector<SlowFloat::SlowFloat>::const_iterator& floatIter,
+            const PersistentVector<std::shared_ptr<ValueType> >::const_iterator& valueIter, bool packed) :
+            floatIter(floatIter), valueIter(valueIter), packed(packed) { }
+
+         Value operator* () const { return (true == packed) ? Value(*floatIter) : Value(*valueIter); }
+
+         const_iterator& operator++ ()
+          {
+            if (true == packed)
+             {
+               ++floatIter;
+             }
+            else
+             {
+               ++valueIter;
+             }
+            return *this;
+          }
+         const_iterator operator++ (int) { const_iterator result (*this); ++*this; return result; }
+
+         bool operator== (const const_iterator& rhs) const { return (true == packed) ? (floatIter == rhs.floatIter) : (valueIter == rhs.valueIter); }
+         bool operator!= (const const_iterator& rhs) const { return false == (*this == rhs); }
+       };
+
+      ArrayElements() : packed(true) { }
+
+      size_t size() const { return (true == packed) ? floats.size() : values.size(); }
+      bool empty() const { return (true == packed) ? floats.empty() : values.empty(); }
+
+       // Packed Arrays expose their Floats, so that arithmetic can work on them directly.
+      bool isPacked() const { return packed; }
+      const PersistentVector<SlowFloat::SlowFloat>& getFloats() const { return floats; }
+
+       // This boxes a packed element. Use element() to avoid that.
+      std::shared_ptr<ValueType> operator[] (size_t index) const
+       {
+         if (true == packed)
+          {
+            return std::make_shared<FloatValue>(floats[index]);
+          }
+         return values[index];
+       }
+
+      Value element(size_t index) const
+       {
+         return (true == packed) ? Value(floats[index]) : Value(values[index]);
+       }
+
+      const_iterator begin() const { return const_iterator(floats.begin(), values.begin(), packed); }
+      const_iterator end() const { return const_iterator(floats.end(), values.end(), packed); }
+
+      void clear()
+       {
+         floats.clear();
+         values.clear();
+         packed = true;
+       }
+
+      void set(size_t index, const Value& value)
+       {
+         if ((true == packed) && (true == isFloat(value)))
+          {
+            floats.set(index, getFloat(value));
+            return;
+          }
+         if (true == packed)
+          {
+            promote();
+          }
+         values.set(index, value);
+       }
+
+      void push_back(const SlowFloat::SlowFloat& value)
+       {
+         if (true == packed)
+          {
+            floats.push_back(value);
+          }
+         else
+          {
+            values.push_back(std::make_shared<FloatValue>(value));
+          }
+       }
+
+      void push_back(const Value& value)
+       {
+         if ((true == packed) && (true == isFloat(value)))
+          {
+            floats.push_back(getFloat(value));
+            return;
+          }
+         if (true == packed)
+          {
+            promote();
+          }
+         values.push_back(value);
+       }
+
+      template <class... Args>
+      void emplace_back(Args&&... args)
+       {
+         push_back(Value(std::forward<Args>(args)...));
+       }
+
+      void push_front(const Value& value)
+       {
+         if ((true == packed) && (true == isFloat(value)))
+          {
+            floats.push_front(getFloat(value));
+            return;
+          }
+         if (true == packed)
+          {
+            promote();
+          }
+         values.push_front(value);
+       }
+
+      void pop_back()
+       {
+         if (true == packed)
+          {
+            floats.pop_back();
+          }
+         else
+          {
+            values.pop_back();
+          }
+       }
+
+      void pop_front()
+       {
+         if (true == packed)
+          {
+            floats.pop_front();
+          }
+         else
+          {
+            values.pop_front();
+          }
+       }
+    };
+
+ } // namespace Types
+
+ } // namespace Backwards
+
+#endif /* BACKWARDS_TYPES_ARRAYELEMENTS_H */
@@ -34,7 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Backwards/Types/ValueType.h"
 
-#include <vector>
+#include "Backwards/Types/ArrayElements.h"
 
 namespace Backwards
  {
@@ -46,25 +46,27 @@ namespace Types
     {
 
    public:
-      std::vector<std::shared_ptr<ValueType> > value;
+      ArrayElements value;
+
+      ArrayValue();
 
       const std::string& getTypeName() const;
 
-      std::shared_ptr<ValueType> neg() const;
-
-      std::shared_ptr<ValueType> add (const FloatValue& lhs) const;
-      std::shared_ptr<ValueType> add (const StringValue& lhs) const;
-      std::shared_ptr<ValueType> add (const ArrayValue& lhs) const;
-      std::shared_ptr<ValueType> add (const DictionaryValue& lhs) const;
-      std::shared_ptr<ValueType> sub (const FloatValue& lhs) const;
-      std::shared_ptr<ValueType> sub (const ArrayValue& lhs) const;
-      std::shared_ptr<ValueType> sub (const DictionaryValue& lhs) const;
-      std::shared_ptr<ValueType> mul (const FloatValue& lhs) const;
-      std::shared_ptr<ValueType> mul (const ArrayValue& lhs) const;
-      std::shared_ptr<ValueType> mul (const DictionaryValue& lhs) const;
-      std::shared_ptr<ValueType> div (const FloatValue& lhs) const;
-      std::shared_ptr<ValueType> div (const ArrayValue& lhs) const;
-      std::shared_ptr<ValueType> div (const DictionaryValue& lhs) const;
+      Value neg() const;
+
+      Value add (const FloatValue& lhs) const;
+      Value add (const StringValue& lhs) const;
+      Value add (const ArrayValue& lhs) const;
+      Value add (const DictionaryValue& lhs) const;
+      Value sub (const FloatValue& lhs) const;
+      Value sub (const ArrayValue& lhs) const;
+      Value sub (const DictionaryValue& lhs) const;
+      Value mul (const FloatValue& lhs) const;
+      Value mul (const ArrayValue& lhs) const;
+      Value mul (const DictionaryValue& lhs) const;
+      Value div (const FloatValue& lhs) const;
+      Value div (const ArrayValue& lhs) const;
+      Value div (const DictionaryValue& lhs) const;
 
       bool equal (const ArrayValue& lhs) const;
       bool notEqual (const ArrayValue& lhs) const;
@@ -34,7 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Backwards/Types/ValueType.h"
 
-#include <map>
+#include "Backwards/Types/PersistentHashMap.h"
 
 namespace Backwards
  {
@@ -48,30 +48,46 @@ namespace Types
          bool operator() (const std::shared_ptr<ValueType>& lhs, const std::shared_ptr<ValueType>& rhs) const;
     };
 
+   class ValueTypeHash final
+    {
+      public:
+         size_t operator() (const std::shared_ptr<ValueType>& key) const;
+    };
+
+   class ValueTypeEqual final
+    {
+      public:
+         bool operator() (const std::shared_ptr<ValueType>& lhs, const std::shared_ptr<ValueType>& rhs) const;
+    };
+
+   typedef PersistentHashMap<std::shared_ptr<ValueType>, std::shared_ptr<ValueType>, ValueTypeHash, ValueTypeEqual, ChristHowHorrifying> DictionaryMap;
+
    class DictionaryValue final : public ValueType
     {
 
    public:
-      // Should probably use an unsorted_map. We'll see how this goes.
-      std::map<std::shared_ptr<ValueType>, std::shared_ptr<ValueType>, ChristHowHorrifying> value;
+      // Hashed for lookup, but iterated in sorted order, as that is visible to scripts.
+      DictionaryMap value;
+
+      DictionaryValue();
 
       const std::string& getTypeName() const;
 
-      std::shared_ptr<ValueType> neg() const;
-
-      std::shared_ptr<ValueType> add (const FloatValue& lhs) const;
-      std::shared_ptr<ValueType> add (const StringValue& lhs) const;
-      std::shared_ptr<ValueType> add (const ArrayValue& lhs) const;
-      std::shared_ptr<ValueType> add (const DictionaryValue& lhs) const;
-      std::shared_ptr<ValueType> sub (const FloatValue& lhs) const;
-      std::shared_ptr<ValueType> sub (const ArrayValue& lhs) const;
-      std::shared_ptr<ValueType> sub (const DictionaryValue& lhs) const;
-      std::shared_ptr<ValueType> mul (const FloatValue& lhs) const;
-      std::shared_ptr<ValueType> mul (const ArrayValue& lhs) const;
-      std::shared_ptr<ValueType> mul (const DictionaryValue& lhs) const;
-      std::shared_ptr<ValueType> div (const FloatValue& lhs) const;
-      std::shared_ptr<ValueType> div (const ArrayValue& lhs) const;
-      std::shared_ptr<ValueType> div (const DictionaryValue& lhs) const;
+      Value neg() const;
+
+      Value add (const FloatValue& lhs) const;
+      Value add (const StringValue& lhs) const;
+      Value add (const ArrayValue& lhs) const;
+      Value add (const DictionaryValue& lhs) const;
+      Value sub (const FloatValue& lhs) const;
+      Value sub (const ArrayValue& lhs) const;
+      Value sub (const DictionaryValue& lhs) const;
+      Value mul (const FloatValue& lhs) const;
+      Value mul (const ArrayValue& lhs) const;
+      Value mul (const DictionaryValue& lhs) const;
+      Value div (const FloatValue& lhs) const;
+      Value div (const ArrayValue& lhs) const;
+      Value div (const DictionaryValue& lhs) const;
 
       bool equal (const DictionaryValue& lhs) const;
       bool notEqual (const DictionaryValue& lhs) const;
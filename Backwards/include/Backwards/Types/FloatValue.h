@@ -52,14 +52,14 @@ namespace Types
 
       const std::string& getTypeName() const;
 
-      std::shared_ptr<ValueType> neg() const;
+      Value neg() const;
       bool logical() const;
 
-      std::shared_ptr<ValueType> add (const FloatValue& lhs) const;
-      std::shared_ptr<ValueType> sub (const FloatValue& lhs) const;
-      std::shared_ptr<ValueType> mul (const FloatValue& lhs) const;
-      std::shared_ptr<ValueType> div (const FloatValue& lhs) const;
-      std::shared_ptr<ValueType> power (const FloatValue& lhs) const;
+      Value add (const FloatValue& lhs) const;
+      Value sub (const FloatValue& lhs) const;
+      Value mul (const FloatValue& lhs) const;
+      Value div (const FloatValue& lhs) const;
+      Value power (const FloatValue& lhs) const;
 
       bool greater (const FloatValue& lhs) const;
       bool less (const FloatValue& lhs) const;
@@ -0,0 +1,420 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BACKWARDS_TYPES_PERSISTENTHASHMAP_H
+#define BACKWARDS_TYPES_PERSISTENTHASHMAP_H
+
+#include <memory>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+
+namespace Backwards
+ {
+
+namespace Types
+ {
+
+   /*
+      A persistent hash array mapped trie. Each level of the trie consumes five bits of the hash of the key,
+      and a node keeps its entries and its sub-tries in two separate bitmapped arrays. When the hash is
+      exhausted, the remaining entries (which have identical hashes) are kept in a list.
+
+      Copying a map is O(1), as the copy shares all of its nodes with the original. Updates copy the nodes
+      on the path to the key that changed, unless this map is the only owner of a node, in which case the
+      node is updated in place. Lookup only compares keys whose full hashes match.
+
+      Iteration is in the order given by Order, so that it is independent of the hash function. The sorted
+      order is computed on first use, and shared by copies until one of them changes.
+   */
+   template <class K, class V, class Hash, class Equal, class Order>
+   class PersistentHashMap final
+    {
+   public:
+      typedef std::pair<K, V> value_type;
+
+   private:
+      static const size_t BITS = 5U;
+      static const size_t MASK = (static_cast<size_t>(1U) << BITS) - 1U;
+      static const size_t HASH_BITS = sizeof(size_t) * CHAR_BIT;
+
+      class Entry final
+       {
+      public:
+         value_type item;
+         size_t hash;
+
+         Entry(const K& key, const V& value, size_t hash) : item(key, value), hash(hash) { }
+       };
+
+       // A node at a shift of HASH_BITS or more is a collision node: its bitmaps are unused.
+      class Node final
+       {
+      public:
+         uint32_t dataMap;
+         uint32_t nodeMap;
+         std::vector<Entry> entries;
+         std::vector<std::shared_ptr<Node> > children;
+
+         Node() : dataMap(0U), nodeMap(0U) { }
+       };
+
+      typedef std::vector<const value_type*> Ordering;
+
+      std::shared_ptr<Node> root;
+      size_t count;
+      mutable std::shared_ptr<const Ordering> order; // Only accessed atomically.
+
+      static uint32_t bitFor(size_t hash, size_t shift)
+       {
+         return static_cast<uint32_t>(1U) << ((hash >> shift) & MASK);
+       }
+
+      static size_t indexOf(uint32_t map, uint32_t bit)
+       {
+         uint32_t x = map & (bit - 1U);
+         x = x - ((x >> 1) & 0x55555555U);
+         x = (x & 0x33333333U) + ((x >> 2) & 0x33333333U);
+         return static_cast<size_t>((((x + (x >> 4)) & 0x0F0F0F0FU) * 0x01010101U) >> 24);
+       }
+
+       // Get a Node we can change: if anyone else can see this one, copy it first.
+      static Node& edit(std::shared_ptr<Node>& slot)
+       {
+         if (1 != slot.use_count())
+          {
+            slot = std::make_shared<Node>(*slot);
+          }
+         return *slot;
+       }
+
+      static bool matches(const Entry& entry, size_t hash, const K& key)
+       {
+         return (entry.hash == hash) && (true == Equal()(entry.item.first, key));
+       }
+
+      static std::shared_ptr<Node> merge(const Entry& first, const Entry& second, size_t shift)
+       {
+         std::shared_ptr<Node> result = std::make_shared<Node>();
+         if (shift >= HASH_BITS)
+          {
+            result->entries.push_back(first);
+            result->entries.push_back(second);
+            return result;
+          }
+         uint32_t firstBit = bitFor(first.hash, shift);
+         uint32_t secondBit = bitFor(second.hash, shift);
+         if (firstBit == secondBit)
+          {
+            result->nodeMap = firstBit;
+            result->children.push_back(merge(first, second, shift + BITS));
+          }
+         else
+          {
+            result->dataMap = firstBit | secondBit;
+            result->entries.push_back((firstBit < secondBit) ? first : second);
+            result->entries.push_back((firstBit < secondBit) ? second : first);
+          }
+         return result;
+       }
+
+       // Returns true if the key was added, false if its value was replaced.
+      static bool assoc(std::shared_ptr<Node>& slot, size_t shift, const Entry& entry)
+       {
+         Node& node = edit(slot);
+         if (shift >= HASH_BITS)
+          {
+            for (Entry& current : node.entries)
+             {
+               if (true == matches(current, entry.hash, entry.item.first))
+                {
+                  current.item.second = entry.item.second;
+                  return false;
+                }
+             }
+            node.entries.push_back(entry);
+            return true;
+          }
+         uint32_t bit = bitFor(entry.hash, shift);
+         if (0U != (node.dataMap & bit))
+          {
+            size_t index = indexOf(node.dataMap, bit);
+            if (true == matches(node.entries[index], entry.hash, entry.item.first))
+             {
+               node.entries[index].item.second = entry.item.second;
+               return false;
+             }
+            std::shared_ptr<Node> child = merge(node.entries[index], entry, shift + BITS);
+            node.entries.erase(node.entries.begin() + index);
+            node.dataMap ^= bit;
+            node.children.insert(node.children.begin() + indexOf(node.nodeMap, bit), child);
+            node.nodeMap |= bit;
+            return true;
+          }
+         if (0U != (node.nodeMap & bit))
+          {
+            return assoc(node.children[indexOf(node.nodeMap, bit)], shift + BITS, entry);
+          }
+         node.entries.insert(node.entries.begin() + indexOf(node.dataMap, bit), entry);
+         node.dataMap |= bit;
+         return true;
+       }
+
+       // The key must be present.
+      static void dissoc(std::shared_ptr<Node>& slot, size_t shift, size_t hash, const K& key)
+       {
+         Node& node = edit(slot);
+         if (shift >= HASH_BITS)
+          {
+            for (typename std::vector<Entry>::iterator iter = node.entries.begin(); node.entries.end() != iter; ++iter)
+             {
+               if (true == matches(*iter, hash, key))
+                {
+                  node.entries.erase(iter);
+                  break;
+                }
+             }
+            return;
+          }
+         uint32_t bit = bitFor(hash, shift);
+         if (0U != (node.dataMap & bit))
+          {
+            node.entries.erase(node.entries.begin() + indexOf(node.dataMap, bit));
+            node.dataMap ^= bit;
+            return;
+          }
+         size_t index = indexOf(node.nodeMap, bit);
+         dissoc(node.children[index], shift + BITS, hash, key);
+         const Node& child = *node.children[index];
+         if ((true == child.children.empty()) && (child.entries.size() < 2U))
+          {
+             // Pull a lone entry up into this node, so that the trie doesn't get deeper than it needs to be.
+            if (false == child.entries.empty())
+             {
+               Entry lone = child.entries[0];
+               node.entries.insert(node.entries.begin() + indexOf(node.dataMap, bit), lone);
+               node.dataMap |= bit;
+             }
+            node.children.erase(node.children.begin() + index);
+            node.nodeMap ^= bit;
+          }
+       }
+
+      template <class Function>
+      static void visit(const Node& node, Function& function)
+       {
+         for (const Entry& entry : node.entries)
+          {
+            function(entry.item);
+          }
+         for (const std::shared_ptr<Node>& child : node.children)
+          {
+            visit(*child, function);
+          }
+       }
+
+      std::shared_ptr<const Ordering> ordering() const
+       {
+         std::shared_ptr<const Ordering> result = std::atomic_load(&order);
+         if (nullptr == result.get())
+          {
+            std::shared_ptr<Ordering> sorted = std::make_shared<Ordering>();
+            sorted->reserve(count);
+            forEach([&sorted](const value_type& item) { sorted->push_back(&item); });
+            std::sort(sorted->begin(), sorted->end(), [](const value_type* lhs, const value_type* rhs) { return Order()(lhs->first, rhs->first); });
+            result = sorted;
+            std::atomic_store(&order, result);
+          }
+         return result;
+       }
+
+      void changed()
+       {
+         std::atomic_store(&order, std::shared_ptr<const Ordering>());
+       }
+
+   public:
+      class const_iterator final
+       {
+      private:
+         std::shared_ptr<const Ordering> items;
+         size_t index;
+
+      public:
+         typedef std::forward_iterator_tag iterator_category;
+         typedef std::pair<K, V> value_type;
+         typedef std::ptrdiff_t difference_type;
+         typedef const value_type* pointer;
+         typedef const value_type& reference;
+
+         const_iterator() : index(0U) { }
+         const_iterator(const std::shared_ptr<const Ordering>& items, size_t index) : items(items), index(index) { }
+
+         const value_type& operator* () const { return *(*items)[index]; }
+         const value_type* operator-> () const { return (*items)[index]; }
+
+         const_iterator& operator++ () { ++index; return *this; }
+         const_iterator operator++ (int) { const_iterator result (*this); ++index; return result; }
+
+         bool operator== (const const_iterator& rhs) const { return index == rhs.index; }
+         bool operator!= (const const_iterator& rhs) const { return index != rhs.index; }
+       };
+
+      PersistentHashMap() : count(0U) { }
+
+      PersistentHashMap(const PersistentHashMap& src) : root(src.root), count(src.count), order(std::atomic_load(&src.order)) { }
+
+      PersistentHashMap& operator= (const PersistentHashMap& src)
+       {
+         if (this != &src)
+          {
+            root = src.root;
+            count = src.count;
+            std::atomic_store(&order, std::atomic_load(&src.order));
+          }
+         return *this;
+       }
+
+      size_t size() const { return count; }
+      bool empty() const { return 0U == count; }
+
+       // Returns null if the key isn't present.
+      const V* find(const K& key) const
+       {
+         if (nullptr == root.get())
+          {
+            return nullptr;
+          }
+         size_t hash = Hash()(key);
+         const Node* node = root.get();
+         for (size_t shift = 0U; ; shift += BITS)
+          {
+            if (shift >= HASH_BITS)
+             {
+               for (const Entry& entry : node->entries)
+                {
+                  if (true == matches(entry, hash, key))
+                   {
+                     return &entry.item.second;
+                   }
+                }
+               return nullptr;
+             }
+            uint32_t bit = bitFor(hash, shift);
+            if (0U != (node->dataMap & bit))
+             {
+               const Entry& entry = node->entries[indexOf(node->dataMap, bit)];
+               return (true == matches(entry, hash, key)) ? &entry.item.second : nullptr;
+             }
+            if (0U == (node->nodeMap & bit))
+             {
+               return nullptr;
+             }
+            node = node->children[indexOf(node->nodeMap, bit)].get();
+          }
+       }
+
+      bool contains(const K& key) const
+       {
+         return nullptr != find(key);
+       }
+
+       // Add the key, or replace its value.
+      void set(const K& key, const V& value)
+       {
+         if (nullptr == root.get())
+          {
+            root = std::make_shared<Node>();
+          }
+         if (true == assoc(root, 0U, Entry(key, value, Hash()(key))))
+          {
+            ++count;
+          }
+         changed();
+       }
+
+       // Like std::map : only adds the key if it isn't already present.
+      bool insert(const value_type& item)
+       {
+         if (true == contains(item.first))
+          {
+            return false;
+          }
+         set(item.first, item.second);
+         return true;
+       }
+
+      bool erase(const K& key)
+       {
+         if (false == contains(key))
+          {
+            return false;
+          }
+         dissoc(root, 0U, Hash()(key), key);
+         --count;
+         if (0U == count)
+          {
+            root.reset();
+          }
+         changed();
+         return true;
+       }
+
+      void clear()
+       {
+         root.reset();
+         count = 0U;
+         changed();
+       }
+
+       // Visit every item, in no particular order.
+      template <class Function>
+      void forEach(Function function) const
+       {
+         if (nullptr != root.get())
+          {
+            visit(*root, function);
+          }
+       }
+
+      const_iterator begin() const { return const_iterator(ordering(), 0U); }
+      const_iterator end() const { return const_iterator(std::shared_ptr<const Ordering>(), count); }
+    };
+
+ } // namespace Types
+
+ } // namespace Backwards
+
+#endif /* BACKWARDS_TYPES_PERSISTENTHASHMAP_H */
@@ -0,0 +1,364 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BACKWARDS_TYPES_PERSISTENTVECTOR_H
+#define BACKWARDS_TYPES_PERSISTENTVECTOR_H
+
+#include <memory>
+#include <vector>
+#include <iterator>
+#include <cstddef>
+
+namespace Backwards
+ {
+
+namespace Types
+ {
+
+   /*
+      A persistent vector: a 32-way trie of leaves, with the last leaf held separately as a tail buffer.
+      Copying one is O(1), as the copy shares all of its nodes with the original. Updates copy the
+      nodes on the path to the element that changed (O(log32 n)), unless this vector is the only owner
+      of a node, in which case the node is updated in place. Elements are addressed through an origin
+      offset, so that removing from the front is also cheap; adding to the front is amortized.
+   */
+   template <class T>
+   class PersistentVector final
+    {
+   private:
+      static const size_t BITS = 5U;
+      static const size_t WIDTH = static_cast<size_t>(1U) << BITS;
+      static const size_t MASK = WIDTH - 1U;
+
+      class Node final
+       {
+      public:
+         std::vector<std::shared_ptr<Node> > children; // If a branch.
+         std::vector<T> values; // If a leaf.
+       };
+
+      std::shared_ptr<Node> root; // Everything before the tail. Null if everything fits in the tail.
+      std::shared_ptr<Node> tail;
+      size_t shift;  // The level of the root : leaves are at level zero.
+      size_t origin; // Where element zero lives.
+      size_t count;  // Where the element after the last lives.
+
+      size_t tailOffset() const
+       {
+         return (count < WIDTH) ? 0U : (((count - 1U) >> BITS) << BITS);
+       }
+
+      const Node& leafFor(size_t location) const
+       {
+         if (location >= tailOffset())
+          {
+            return *tail;
+          }
+         const Node* node = root.get();
+         for (size_t level = shift; level > 0U; level -= BITS)
+          {
+            node = node->children[(location >> level) & MASK].get();
+          }
+         return *node;
+       }
+
+       // Get a Node we can change: if anyone else can see this one, copy it first.
+      static Node& edit(std::shared_ptr<Node>& slot)
+       {
+         if (1 != slot.use_count())
+          {
+            slot = std::make_shared<Node>(*slot);
+          }
+         return *slot;
+       }
+
+      static std::shared_ptr<Node> newPath(size_t level, const std::shared_ptr<Node>& leaf)
+       {
+         if (0U == level)
+          {
+            return leaf;
+          }
+         std::shared_ptr<Node> result = std::make_shared<Node>();
+         result->children.push_back(newPath(level - BITS, leaf));
+         return result;
+       }
+
+      void pushTail(std::shared_ptr<Node>& slot, size_t level, const std::shared_ptr<Node>& leaf)
+       {
+         Node& node = edit(slot);
+         size_t index = ((count - 1U) >> level) & MASK;
+         if (BITS == level)
+          {
+            node.children.push_back(leaf);
+          }
+         else if (index < node.children.size())
+          {
+            pushTail(node.children[index], level - BITS, leaf);
+          }
+         else
+          {
+            node.children.push_back(newPath(level - BITS, leaf));
+          }
+       }
+
+       // Returns true if the node is now empty.
+      bool popTail(std::shared_ptr<Node>& slot, size_t level)
+       {
+         Node& node = edit(slot);
+         if (BITS == level)
+          {
+            node.children.pop_back();
+          }
+         else
+          {
+            size_t index = ((count - 2U) >> level) & MASK;
+            if (true == popTail(node.children[index], level - BITS))
+             {
+               node.children.pop_back();
+             }
+          }
+         return node.children.empty();
+       }
+
+      void rebuild(size_t headroom)
+       {
+         PersistentVector result;
+         for (size_t i = 0U; i < headroom; ++i)
+          {
+            result.push_back(T());
+          }
+         for (const_iterator iter = begin(); end() != iter; ++iter)
+          {
+            result.push_back(*iter);
+          }
+         result.origin = headroom;
+         *this = std::move(result);
+       }
+
+   public:
+      class const_iterator final
+       {
+      private:
+         const PersistentVector* owner;
+         size_t index;
+         mutable const std::vector<T>* block; // The leaf we were last in, so that we only walk the tree once per leaf.
+         mutable size_t base;
+
+      public:
+         typedef std::forward_iterator_tag iterator_category;
+         typedef T value_type;
+         typedef std::ptrdiff_t difference_type;
+         typedef const T* pointer;
+         typedef const T& reference;
+
+         const_iterator() : owner(nullptr), index(0U), block(nullptr), base(0U) { }
+         const_iterator(const PersistentVector* owner, size_t index) : owner(owner), index(index), block(nullptr), base(0U) { }
+
+         const T& operator* () const
+          {
+            size_t location = owner->origin + index;
+            if ((nullptr == block) || (location < base) || (location - base >= block->size()))
+             {
+               block = &owner->leafFor(location).values;
+               base = location & ~MASK;
+             }
+            return (*block)[location - base];
+          }
+         const T* operator-> () const { return &**this; }
+
+         const_iterator& operator++ () { ++index; return *this; }
+         const_iterator operator++ (int) { const_iterator result (*this); ++index; return result; }
+
+         bool operator== (const const_iterator& rhs) const { return index == rhs.index; }
+         bool operator!= (const const_iterator& rhs) const { return index != rhs.index; }
+       };
+
+      PersistentVector() : shift(BITS), origin(0U), count(0U) { }
+
+      template <class InputIterator>
+      PersistentVector(InputIterator first, InputIterator last) : shift(BITS), origin(0U), count(0U)
+       {
+         for (; last != first; ++first)
+          {
+            push_back(*first);
+          }
+       }
+
+      size_t size() const { return count - origin; }
+      bool empty() const { return count == origin; }
+
+      const T& operator[] (size_t index) const
+       {
+         size_t location = origin + index;
+         return leafFor(location).values[location & MASK];
+       }
+
+      const T& front() const { return (*this)[0U]; }
+      const T& back() const { return tail->values.back(); }
+
+      const_iterator begin() const { return const_iterator(this, 0U); }
+      const_iterator end() const { return const_iterator(this, size()); }
+
+      void clear()
+       {
+         root.reset();
+         tail.reset();
+         shift = BITS;
+         origin = 0U;
+         count = 0U;
+       }
+
+      void set(size_t index, const T& value)
+       {
+         size_t location = origin + index;
+         if (location >= tailOffset())
+          {
+            edit(tail).values[location - tailOffset()] = value;
+            return;
+          }
+         Node* node = &edit(root);
+         for (size_t level = shift; level > 0U; level -= BITS)
+          {
+            node = &edit(node->children[(location >> level) & MASK]);
+          }
+         node->values[location & MASK] = value;
+       }
+
+      void push_back(const T& value)
+       {
+         if (nullptr == tail.get())
+          {
+            tail = std::make_shared<Node>();
+          }
+         if (count - tailOffset() < WIDTH)
+          {
+            edit(tail).values.push_back(value);
+            ++count;
+            return;
+          }
+          // The tail is full: move it into the tree.
+         if (nullptr == root.get())
+          {
+            root = std::make_shared<Node>();
+            shift = BITS;
+          }
+         if ((count >> BITS) > (static_cast<size_t>(1U) << shift))
+          {
+            std::shared_ptr<Node> newRoot = std::make_shared<Node>();
+            newRoot->children.push_back(root);
+            newRoot->children.push_back(newPath(shift, tail));
+            root = newRoot;
+            shift += BITS;
+          }
+         else
+          {
+            pushTail(root, shift, tail);
+          }
+         tail = std::make_shared<Node>();
+         tail->values.reserve(WIDTH); // A vector this big will probably fill this leaf, too.
+         tail->values.push_back(value);
+         ++count;
+       }
+
+      template <class... Args>
+      void emplace_back(Args&&... args)
+       {
+         push_back(T(std::forward<Args>(args)...));
+       }
+
+      void pop_back()
+       {
+         if (1U == size())
+          {
+            clear();
+            return;
+          }
+         if (count - tailOffset() > 1U)
+          {
+            edit(tail).values.pop_back();
+            --count;
+            return;
+          }
+          // The tail is about to be empty: pull the last leaf out of the tree.
+         std::shared_ptr<Node> newTail;
+          {
+            const std::shared_ptr<Node>* node = &root;
+            for (size_t level = shift; level > 0U; level -= BITS)
+             {
+               node = &(*node)->children[((count - 2U) >> level) & MASK];
+             }
+            newTail = *node;
+          }
+         if (true == popTail(root, shift))
+          {
+            root.reset();
+          }
+         else if ((shift > BITS) && (1U == root->children.size()))
+          {
+            root = std::shared_ptr<Node>(root->children[0]);
+            shift -= BITS;
+          }
+         tail = newTail;
+         --count;
+       }
+
+      void push_front(const T& value)
+       {
+         if (0U == origin)
+          {
+            rebuild((size() > WIDTH) ? size() : WIDTH);
+          }
+         --origin;
+         set(0U, value);
+       }
+
+      void pop_front()
+       {
+         if (1U == size())
+          {
+            clear();
+            return;
+          }
+         set(0U, T()); // Let go of the element.
+         ++origin;
+          // Don't let the space in front grow without bound.
+         if ((origin > WIDTH) && (origin > size()))
+          {
+            rebuild(0U);
+          }
+       }
+    };
+
+ } // namespace Types
+
+ } // namespace Backwards
+
+#endif /* BACKWARDS_TYPES_PERSISTENTVECTOR_H */
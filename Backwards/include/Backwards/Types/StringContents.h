@@ -0,0 +1,128 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BACKWARDS_TYPES_STRINGCONTENTS_H
+#define BACKWARDS_TYPES_STRINGCONTENTS_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace Backwards
+ {
+
+namespace Types
+ {
+
+   /*
+      The characters of a String. Concatenation and SubString build a rope of shared pieces, so that
+      building a String a piece at a time is linear. The characters are only put together when someone
+      needs them as a std::string, and that is remembered. Short results are copied eagerly, as a rope
+      of them would cost more than the copy.
+   */
+   class StringContents final
+    {
+   private:
+      class Piece final
+       {
+      public:
+         size_t length;
+         size_t offset; // Into left, for a slice.
+          // Mutable so that the destructor can take them apart without recursing.
+         mutable std::shared_ptr<const Piece> left;
+         mutable std::shared_ptr<const Piece> right; // Null for a slice.
+         std::string text; // For a leaf.
+         mutable std::atomic<const std::string*> flat; // Null until flattened. Points to text for a leaf.
+
+         Piece(const std::string& text);
+         Piece(const std::shared_ptr<const Piece>& left, const std::shared_ptr<const Piece>& right);
+         Piece(const std::shared_ptr<const Piece>& base, size_t offset, size_t length);
+         ~Piece();
+
+         Piece(const Piece&) = delete;
+         Piece& operator= (const Piece&) = delete;
+
+         const std::string& getFlat() const;
+       };
+
+      std::shared_ptr<const Piece> piece;
+
+      StringContents(const std::shared_ptr<const Piece>& piece) : piece(piece) { }
+
+      static const std::shared_ptr<const Piece>& getEmpty();
+      static std::shared_ptr<const Piece> settle(const std::shared_ptr<const Piece>& piece);
+
+   public:
+      static const size_t EAGER_LIMIT = 64U; // Results shorter than this are always flat.
+
+      StringContents();
+      StringContents(const std::string& text);
+      StringContents(const char* text);
+
+      size_t size() const { return piece->length; }
+      size_t length() const { return piece->length; }
+      bool empty() const { return 0U == piece->length; }
+      bool isFlat() const { return nullptr != piece->flat.load(std::memory_order_acquire); }
+      size_t footprint() const; // The characters held by all of the Pieces of this String, counting flattened copies.
+
+      const std::string& str() const { return piece->getFlat(); }
+      operator const std::string& () const { return piece->getFlat(); }
+
+      StringContents substr(size_t pos, size_t count) const;
+      static StringContents concat(const StringContents& lhs, const StringContents& rhs);
+
+      int compare(const StringContents& rhs) const;
+      bool operator== (const StringContents& rhs) const;
+      bool operator!= (const StringContents& rhs) const { return false == (*this == rhs); }
+      bool operator< (const StringContents& rhs) const { return compare(rhs) < 0; }
+      bool operator> (const StringContents& rhs) const { return compare(rhs) > 0; }
+      bool operator<= (const StringContents& rhs) const { return compare(rhs) <= 0; }
+      bool operator>= (const StringContents& rhs) const { return compare(rhs) >= 0; }
+    };
+
+   inline bool operator== (const StringContents& lhs, const std::string& rhs) { return (lhs.size() == rhs.size()) && (lhs.str() == rhs); }
+   inline bool operator== (const std::string& lhs, const StringContents& rhs) { return rhs == lhs; }
+   inline bool operator== (const StringContents& lhs, const char* rhs) { return lhs.str() == rhs; }
+   inline bool operator== (const char* lhs, const StringContents& rhs) { return rhs.str() == lhs; }
+   inline bool operator!= (const StringContents& lhs, const std::string& rhs) { return false == (lhs == rhs); }
+   inline bool operator!= (const std::string& lhs, const StringContents& rhs) { return false == (rhs == lhs); }
+   inline bool operator!= (const StringContents& lhs, const char* rhs) { return false == (lhs == rhs); }
+   inline bool operator!= (const char* lhs, const StringContents& rhs) { return false == (rhs == lhs); }
+
+   inline std::ostream& operator<< (std::ostream& os, const StringContents& contents) { return os << contents.str(); }
+
+ } // namespace Types
+
+ } // namespace Backwards
+
+#endif /* BACKWARDS_TYPES_STRINGCONTENTS_H */
@@ -34,6 +34,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Backwards/Types/ValueType.h"
 
+#include "Backwards/Types/StringContents.h"
+
+#include <atomic>
+#include <memory>
 #include <string>
 
 namespace Backwards
@@ -45,15 +49,26 @@ namespace Types
    class StringValue final : public ValueType
     {
 
+   private:
+      mutable std::atomic<size_t> hashCode; // Zero until someone asks for it.
+      bool interned;
+
    public:
-      std::string value;
+      StringContents value;
 
       StringValue();
-      StringValue(const std::string& value);
+      StringValue(const StringContents& value);
+      StringValue(const StringValue& src);
+      ~StringValue();
+
+       // There is only ever one live interned String with a given value, so interned Strings are equal only if they are the same String.
+       // String literals are interned by the parser, which makes them cheap as Dictionary keys. This is thread safe.
+      static std::shared_ptr<StringValue> intern(const std::string& value);
+      bool isInterned() const { return interned; }
 
       const std::string& getTypeName() const;
 
-      std::shared_ptr<ValueType> add (const StringValue& lhs) const;
+      Value add (const StringValue& lhs) const;
 
       bool greater (const StringValue& lhs) const;
       bool less (const StringValue& lhs) const;
@@ -0,0 +1,193 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BACKWARDS_TYPES_VALUE_H
+#define BACKWARDS_TYPES_VALUE_H
+
+#include "Backwards/Types/FloatValue.h"
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace Backwards
+ {
+
+namespace Types
+ {
+
+   /*
+      A handle to a value, used where the engine passes values around and stores them in stack frames.
+      A Float is held inline (as a FloatValue that lives in the handle), so arithmetic on Floats
+      doesn't touch the heap. Everything else is a reference to the shared object. The handle
+      dereferences like a std::shared_ptr, and will box an inline Float when someone needs a real one.
+   */
+   class Value final
+    {
+   private:
+      union
+       {
+         FloatValue number;
+         std::shared_ptr<ValueType> ref;
+       };
+      bool immediate;
+
+   public:
+      Value() : ref(), immediate(false) { }
+      Value(std::nullptr_t) : ref(), immediate(false) { }
+      explicit Value(const SlowFloat::SlowFloat& value) : number(value), immediate(true) { }
+      Value(const std::shared_ptr<ValueType>& value) : ref(value), immediate(false) { }
+      Value(std::shared_ptr<ValueType>&& value) : ref(std::move(value)), immediate(false) { }
+      template <class T>
+      Value(const std::shared_ptr<T>& value) : ref(value), immediate(false) { }
+
+      Value(const Value& src) : immediate(src.immediate)
+       {
+         if (true == immediate)
+          {
+            new (&number) FloatValue(src.number);
+          }
+         else
+          {
+            new (&ref) std::shared_ptr<ValueType>(src.ref);
+          }
+       }
+
+      Value(Value&& src) noexcept : immediate(src.immediate)
+       {
+         if (true == immediate)
+          {
+            new (&number) FloatValue(src.number);
+          }
+         else
+          {
+            new (&ref) std::shared_ptr<ValueType>(std::move(src.ref));
+          }
+       }
+
+      ~Value()
+       {
+         release();
+       }
+
+      Value& operator= (const Value& src)
+       {
+         if ((false == immediate) && (false == src.immediate))
+          {
+            ref = src.ref;
+          }
+         else if (this != &src)
+          {
+            release();
+            immediate = src.immediate;
+            if (true == immediate)
+             {
+               new (&number) FloatValue(src.number);
+             }
+            else
+             {
+               new (&ref) std::shared_ptr<ValueType>(src.ref);
+             }
+          }
+         return *this;
+       }
+
+      Value& operator= (Value&& src) noexcept
+       {
+         if ((false == immediate) && (false == src.immediate))
+          {
+            ref = std::move(src.ref);
+          }
+         else if (this != &src)
+          {
+            release();
+            immediate = src.immediate;
+            if (true == immediate)
+             {
+               new (&number) FloatValue(src.number);
+             }
+            else
+             {
+               new (&ref) std::shared_ptr<ValueType>(std::move(src.ref));
+             }
+          }
+         return *this;
+       }
+
+      bool isImmediate() const { return immediate; }
+
+       // Only valid when isImmediate().
+      const SlowFloat::SlowFloat& getFloat() const { return number.value; }
+
+      const ValueType* get() const { return (true == immediate) ? &number : ref.get(); }
+      const ValueType& operator* () const { return *get(); }
+      const ValueType* operator-> () const { return get(); }
+      explicit operator bool () const { return nullptr != get(); }
+
+       // Get a shared reference to the value. This allocates if the value is an inline Float.
+      std::shared_ptr<ValueType> box() const
+       {
+         if (true == immediate)
+          {
+            return std::make_shared<FloatValue>(number.value);
+          }
+         return ref;
+       }
+
+      operator std::shared_ptr<ValueType> () const { return box(); }
+
+       // Move the shared reference out of the handle, leaving the handle empty.
+      std::shared_ptr<ValueType> take()
+       {
+         std::shared_ptr<ValueType> result = (true == immediate) ? box() : std::move(ref);
+         *this = Value();
+         return result;
+       }
+
+   private:
+      void release()
+       {
+         if (true == immediate)
+          {
+            number.~FloatValue();
+          }
+         else
+          {
+            ref.~shared_ptr();
+          }
+       }
+    };
+
+ } // namespace Types
+
+ } // namespace Backwards
+
+#endif /* BACKWARDS_TYPES_VALUE_H */
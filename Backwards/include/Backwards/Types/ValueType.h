@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string>
 #include <exception>
 #include <memory>
+#include <cstdint>
 
 namespace Backwards
  {
@@ -48,18 +49,20 @@ namespace Types
    class DictionaryValue;
    class FunctionValue;
 
+   class Value;
+
    inline void boost_hash_combine(size_t& seed, size_t value)
     {
       seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
     }
 
 #define DECLARE(x) \
-      virtual std::shared_ptr<ValueType> x (const ValueType& rhs) const = 0; \
-      virtual std::shared_ptr<ValueType> x (const FloatValue& lhs) const; \
-      virtual std::shared_ptr<ValueType> x (const StringValue& lhs) const; \
-      virtual std::shared_ptr<ValueType> x (const ArrayValue& lhs) const; \
-      virtual std::shared_ptr<ValueType> x (const DictionaryValue& lhs) const; \
-      virtual std::shared_ptr<ValueType> x (const FunctionValue& lhs) const;
+      virtual Value x (const ValueType& rhs) const = 0; \
+      virtual Value x (const FloatValue& lhs) const; \
+      virtual Value x (const StringValue& lhs) const; \
+      virtual Value x (const ArrayValue& lhs) const; \
+      virtual Value x (const DictionaryValue& lhs) const; \
+      virtual Value x (const FunctionValue& lhs) const;
 
 #define DECLAREBOOL(x) \
       virtual bool x (const ValueType& rhs) const = 0; \
@@ -70,11 +73,11 @@ namespace Types
       virtual bool x (const FunctionValue& lhs) const;
 
 #define DECLAREVISITOR \
-   virtual std::shared_ptr<ValueType> add (const ValueType& rhs) const override; \
-   virtual std::shared_ptr<ValueType> sub (const ValueType& rhs) const override; \
-   virtual std::shared_ptr<ValueType> mul (const ValueType& rhs) const override; \
-   virtual std::shared_ptr<ValueType> div (const ValueType& rhs) const override; \
-   virtual std::shared_ptr<ValueType> power (const ValueType& rhs) const override; \
+   virtual Value add (const ValueType& rhs) const override; \
+   virtual Value sub (const ValueType& rhs) const override; \
+   virtual Value mul (const ValueType& rhs) const override; \
+   virtual Value div (const ValueType& rhs) const override; \
+   virtual Value power (const ValueType& rhs) const override; \
    virtual bool greater (const ValueType& rhs) const override; \
    virtual bool less (const ValueType& rhs) const override; \
    virtual bool geq (const ValueType& rhs) const override; \
@@ -90,7 +93,7 @@ namespace Types
    virtual size_t hash() const;
 
 #define IMPLEMENT(x,y) \
-   std::shared_ptr<ValueType> x::y (const ValueType& rhs) const \
+   Value x::y (const ValueType& rhs) const \
       { return rhs.y(*this); }
 
 #define IMPLEMENTBOOL(x,y) \
@@ -114,12 +117,31 @@ namespace Types
    class ValueType
     {
 
+   public:
+       // Which of the five types this is. Checking this is cheaper than RTTI.
+      enum Type : uint8_t
+       {
+         FLOAT,
+         STRING,
+         ARRAY,
+         DICTIONARY,
+         FUNCTION
+       };
+
+   private:
+      Type type;
+
+   protected:
+      explicit ValueType(Type type) : type(type) { }
+
    public:
       virtual ~ValueType() = default;
 
+      Type getType() const { return type; }
+
       virtual const std::string& getTypeName() const = 0;
 
-      virtual std::shared_ptr<ValueType> neg() const;
+      virtual Value neg() const;
       virtual bool logical() const;
 
       DECLARE(add)
@@ -0,0 +1,660 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Backwards/Engine/Bytecode.h"
+#include "Backwards/Engine/Statement.h"
+#include "Backwards/Engine/Expression.h"
+#include "Backwards/Engine/ConstantsSingleton.h"
+
+#include <map>
+
+namespace Backwards
+ {
+
+namespace Engine
+ {
+
+   const uint32_t Instruction::NO_REGION = 0xFFFFFFFFU;
+   const uint32_t Instruction::NO_REGISTER = 0xFFFFFFFFU;
+   const uint32_t Chunk::NO_LINE = 0xFFFFFFFFU;
+
+   Instruction::Instruction(OpCode op, uint32_t a, uint32_t b, uint32_t c, uint32_t token, uint32_t region) :
+      op(op), a(a), b(b), c(c), token(token), region(region)
+    {
+    }
+
+   Region::Region(uint32_t token, uint32_t parent, bool debugger) : token(token), parent(parent), debugger(debugger)
+    {
+    }
+
+   Loop::Loop(size_t id, size_t breakTarget, size_t continueTarget) : id(id), breakTarget(breakTarget), continueTarget(continueTarget)
+    {
+    }
+
+   Chunk::Chunk() : registers(0U), iterators(0U), counters(0U), native(nullptr)
+    {
+    }
+
+   Compiler::PendingLoop::PendingLoop(size_t id) : id(id)
+    {
+    }
+
+   Compiler::Compiler(Chunk& chunk) : chunk(chunk), top(0U), pendingLine(Chunk::NO_LINE)
+    {
+    }
+
+   std::shared_ptr<Chunk> Compiler::Compile (const Statement& source)
+    {
+      std::shared_ptr<Chunk> result = std::make_shared<Chunk>();
+      Compiler compiler (*result);
+      compiler.statement(source);
+      result->lines.resize(result->code.size(), Chunk::NO_LINE);
+       // If all we did was defer to the tree, then just let the VM defer to the tree.
+      if ((1U == result->code.size()) && (Instruction::EXEC == result->code[0].op))
+       {
+         result->native = result->statements[0];
+         result->code.clear();
+         result->lines.clear();
+       }
+      return result;
+    }
+
+   size_t Compiler::emit (Instruction::OpCode op, uint32_t a, uint32_t b, uint32_t c, const Input::Token& source)
+    {
+      chunk.code.emplace_back(op, a, b, c, token(source), (true == activeRegions.empty()) ? Instruction::NO_REGION : activeRegions.back());
+      if (Chunk::NO_LINE != pendingLine)
+       {
+         chunk.lines.resize(chunk.code.size(), Chunk::NO_LINE);
+         chunk.lines.back() = pendingLine;
+         pendingLine = Chunk::NO_LINE;
+       }
+      return chunk.code.size() - 1U;
+    }
+
+   void Compiler::patch (size_t location, size_t target)
+    {
+      Instruction& instruction = chunk.code[location];
+      switch (instruction.op)
+       {
+      case Instruction::JMP:
+         instruction.a = static_cast<uint32_t>(target);
+         break;
+      case Instruction::JMPF:
+      case Instruction::JMPT:
+         instruction.b = static_cast<uint32_t>(target);
+         break;
+      case Instruction::ITERNEXT:
+         instruction.c = static_cast<uint32_t>(target);
+         break;
+      default:
+         break;
+       }
+    }
+
+   void Compiler::patch (const std::vector<size_t>& locations, size_t target)
+    {
+      for (size_t location : locations)
+       {
+         patch(location, target);
+       }
+    }
+
+   uint32_t Compiler::token (const Input::Token& source)
+    {
+       // Consecutive instructions usually come from the same node.
+      if ((false == chunk.tokens.empty()) && (&source == chunk.tokens.back()))
+       {
+         return static_cast<uint32_t>(chunk.tokens.size() - 1U);
+       }
+      chunk.tokens.emplace_back(&source);
+      return static_cast<uint32_t>(chunk.tokens.size() - 1U);
+    }
+
+   uint32_t Compiler::constant (const std::shared_ptr<Types::ValueType>& value)
+    {
+       // Floats are loaded as immediates, so that loading one doesn't touch a reference count.
+      if (Types::ValueType::FLOAT == value->getType())
+       {
+         chunk.constants.emplace_back(static_cast<const Types::FloatValue&>(*value).value);
+         return static_cast<uint32_t>(chunk.constants.size() - 1U);
+       }
+      for (size_t i = 0U; i < chunk.constants.size(); ++i)
+       {
+         if (value.get() == chunk.constants[i].get())
+          {
+            return static_cast<uint32_t>(i);
+          }
+       }
+      chunk.constants.emplace_back(value);
+      return static_cast<uint32_t>(chunk.constants.size() - 1U);
+    }
+
+   uint32_t Compiler::allocate ()
+    {
+      uint32_t result = top;
+      ++top;
+      if (top > chunk.registers)
+       {
+         chunk.registers = top;
+       }
+      return result;
+    }
+
+    // The statements the tree counts for the Profiler are counted by the VM at their first instruction.
+   void Compiler::line (const Statement& source)
+    {
+      pendingLine = token(source.token);
+    }
+
+   void Compiler::pushRegion (const Input::Token& source, bool debugger)
+    {
+      chunk.regions.emplace_back(token(source), (true == activeRegions.empty()) ? Instruction::NO_REGION : activeRegions.back(), debugger);
+      activeRegions.emplace_back(static_cast<uint32_t>(chunk.regions.size() - 1U));
+    }
+
+   void Compiler::popRegion ()
+    {
+      activeRegions.pop_back();
+    }
+
+#define COMPILE_BINARY(x,y) \
+   else if (typeid(x) == typeid(source)) \
+    { \
+      const x& node = static_cast<const x&>(source); \
+      uint32_t lhs = allocate(); \
+      expression(*node.lhs, lhs); \
+      uint32_t rhs = allocate(); \
+      expression(*node.rhs, rhs); \
+      pushRegion(node.token, true); \
+      emit(Instruction::y, target, lhs, rhs, node.token); \
+      popRegion(); \
+    }
+
+#define COMPILE_SHORT(x,y,z) \
+   else if (typeid(x) == typeid(source)) \
+    { \
+      const x& node = static_cast<const x&>(source); \
+      const ConstantsSingleton& constants = ConstantsSingleton::getInstance(); \
+      expression(*node.lhs, target); \
+      pushRegion(node.token, true); \
+      size_t first = emit(Instruction::y, target, 0U, 0U, node.token); \
+      popRegion(); \
+      expression(*node.rhs, target); \
+      pushRegion(node.token, true); \
+      size_t second = emit(Instruction::y, target, 0U, 0U, node.token); \
+      popRegion(); \
+      emit(Instruction::LOADK, target, constant((true == z) ? constants.FLOAT_ZERO : constants.FLOAT_ONE), 0U, node.token); \
+      size_t skip = emit(Instruction::JMP, 0U, 0U, 0U, node.token); \
+      patch(first, chunk.code.size()); \
+      patch(second, chunk.code.size()); \
+      emit(Instruction::LOADK, target, constant((true == z) ? constants.FLOAT_ONE : constants.FLOAT_ZERO), 0U, node.token); \
+      patch(skip, chunk.code.size()); \
+    }
+
+   void Compiler::expression (const Expression& source, uint32_t target)
+    {
+      uint32_t mark = top;
+      if (typeid(Constant) == typeid(source))
+       {
+         const Constant& node = static_cast<const Constant&>(source);
+         emit(Instruction::LOADK, target, constant(node.value), 0U, node.token);
+       }
+      else if (typeid(Variable) == typeid(source))
+       {
+         const Variable& node = static_cast<const Variable&>(source);
+         if (Variable::GETTER != node.access)
+          {
+            chunk.expressions.emplace_back(&node);
+            emit(Instruction::VAR, target, static_cast<uint32_t>(chunk.expressions.size() - 1U), 0U, node.token);
+          }
+         else
+          {
+            chunk.getters.emplace_back(node.getter);
+            emit(Instruction::GET, target, static_cast<uint32_t>(chunk.getters.size() - 1U), 0U, node.token);
+          }
+       }
+      COMPILE_BINARY(Plus, ADD)
+      COMPILE_BINARY(Minus, SUB)
+      COMPILE_BINARY(Multiply, MUL)
+      COMPILE_BINARY(Divide, DIV)
+      COMPILE_BINARY(Power, POW)
+      COMPILE_BINARY(Equals, EQ)
+      COMPILE_BINARY(NotEqual, NE)
+      COMPILE_BINARY(Greater, GT)
+      COMPILE_BINARY(Less, LT)
+      COMPILE_BINARY(GEQ, GE)
+      COMPILE_BINARY(LEQ, LE)
+      COMPILE_BINARY(DerefVar, INDEX)
+      COMPILE_SHORT(ShortAnd, JMPF, false)
+      COMPILE_SHORT(ShortOr, JMPT, true)
+      else if (typeid(Not) == typeid(source))
+       {
+         const Not& node = static_cast<const Not&>(source);
+         uint32_t arg = allocate();
+         expression(*node.arg, arg);
+         pushRegion(node.token, true);
+         emit(Instruction::NOT, target, arg, 0U, node.token);
+         popRegion();
+       }
+      else if (typeid(Negate) == typeid(source))
+       {
+         const Negate& node = static_cast<const Negate&>(source);
+         uint32_t arg = allocate();
+         expression(*node.arg, arg);
+         pushRegion(node.token, true);
+         emit(Instruction::NEG, target, arg, 0U, node.token);
+         popRegion();
+       }
+      else if (typeid(FunctionCall) == typeid(source))
+       {
+         const FunctionCall& node = static_cast<const FunctionCall&>(source);
+          // The function and its arguments must be in consecutive registers.
+         uint32_t function = allocate();
+         for (size_t i = 0U; i < node.args.size(); ++i)
+          {
+            (void) allocate();
+          }
+         expression(*node.location, function);
+         emit(Instruction::CHECK, function, static_cast<uint32_t>(node.args.size()), 0U, node.token);
+         for (size_t i = 0U; i < node.args.size(); ++i)
+          {
+            expression(*node.args[i], function + 1U + static_cast<uint32_t>(i));
+          }
+         pushRegion(node.token, false);
+         emit(Instruction::CALL, target, function, static_cast<uint32_t>(node.args.size()), node.token);
+         popRegion();
+       }
+      else if (typeid(NativeCall) == typeid(source))
+       {
+         const NativeCall& node = static_cast<const NativeCall&>(source);
+         const FunctionCall& call = *node.call;
+         uint32_t function = allocate();
+         for (size_t i = 0U; i < call.args.size(); ++i)
+          {
+            (void) allocate();
+          }
+         expression(*call.location, function);
+         emit(Instruction::CHECK, function, static_cast<uint32_t>(call.args.size()), 0U, call.token);
+         for (size_t i = 0U; i < call.args.size(); ++i)
+          {
+            expression(*call.args[i], function + 1U + static_cast<uint32_t>(i));
+          }
+         chunk.expressions.emplace_back(&node);
+         pushRegion(call.token, false);
+         emit(Instruction::NATIVE, target, function, static_cast<uint32_t>(chunk.expressions.size() - 1U), call.token);
+         popRegion();
+       }
+      else if (typeid(BuildFunction) == typeid(source))
+       {
+         const BuildFunction& node = static_cast<const BuildFunction&>(source);
+         uint32_t first = top;
+         for (size_t i = 0U; i < node.captures.size(); ++i)
+          {
+            (void) allocate();
+          }
+         for (size_t i = 0U; i < node.captures.size(); ++i)
+          {
+            expression(*node.captures[i], first + static_cast<uint32_t>(i));
+          }
+         chunk.expressions.emplace_back(&node);
+         emit(Instruction::BUILD, target, static_cast<uint32_t>(chunk.expressions.size() - 1U), first, node.token);
+       }
+      else if (typeid(TernaryOperation) == typeid(source))
+       {
+         const TernaryOperation& node = static_cast<const TernaryOperation&>(source);
+         uint32_t condition = allocate();
+         expression(*node.condition, condition);
+         pushRegion(node.token, true);
+         size_t toElse = emit(Instruction::JMPF, condition, 0U, 0U, node.token);
+         popRegion();
+         expression(*node.thenCase, target);
+         size_t toEnd = emit(Instruction::JMP, 0U, 0U, 0U, node.token);
+         patch(toElse, chunk.code.size());
+         expression(*node.elseCase, target);
+         patch(toEnd, chunk.code.size());
+       }
+      else
+       {
+         chunk.expressions.emplace_back(&source);
+         emit(Instruction::EVAL, target, static_cast<uint32_t>(chunk.expressions.size() - 1U), 0U, source.token);
+       }
+      top = mark;
+    }
+
+   void Compiler::statement (const Statement& source)
+    {
+      const ConstantsSingleton& constants = ConstantsSingleton::getInstance();
+      uint32_t mark = top;
+      if (typeid(NOP) == typeid(source))
+       {
+       }
+      else if (typeid(Expr) == typeid(source))
+       {
+         const Expr& node = static_cast<const Expr&>(source);
+         line(node);
+         expression(*node.expr, allocate());
+       }
+      else if (typeid(StatementSeq) == typeid(source))
+       {
+         const StatementSeq& node = static_cast<const StatementSeq&>(source);
+         for (const std::shared_ptr<Statement>& item : node.statements)
+          {
+            statement(*item);
+          }
+       }
+      else if (typeid(Assignment) == typeid(source))
+       {
+         const Assignment& node = static_cast<const Assignment&>(source);
+         line(node);
+         chunk.setters.emplace_back(node.setter);
+         if (nullptr == node.index.get())
+          {
+            uint32_t value = allocate();
+            expression(*node.rhs, value);
+            emit(Instruction::SET, static_cast<uint32_t>(chunk.setters.size() - 1U), value, 0U, node.token);
+          }
+         else
+          {
+             // Walk down the indices, remembering each container, then let Assignment::store rebuild the containers on the way back up.
+             // STORE wants the containers, then the indices, then the value in consecutive registers.
+            std::vector<const RecAssignState*> levels;
+            for (const RecAssignState* level = node.index.get(); nullptr != level; level = level->next.get())
+             {
+               levels.emplace_back(level);
+             }
+            uint32_t count = static_cast<uint32_t>(levels.size());
+            uint32_t containers = top;
+            for (uint32_t i = 0U; i < 2U * count + 1U; ++i)
+             {
+               (void) allocate();
+             }
+            uint32_t indices = containers + count;
+            uint32_t value = indices + count;
+            chunk.getters.emplace_back(node.getter);
+            emit(Instruction::GET, containers, static_cast<uint32_t>(chunk.getters.size() - 1U), 0U, node.token);
+            for (uint32_t i = 0U; i < count; ++i)
+             {
+               expression(*levels[i]->index, indices + i);
+               if (i + 1U < count)
+                {
+                  pushRegion(levels[i]->token, true);
+                  emit(Instruction::INDEX, containers + i + 1U, containers + i, indices + i, levels[i]->token);
+                  popRegion();
+                }
+             }
+            expression(*node.rhs, value);
+            pushRegion(levels.back()->token, true);
+            emit(Instruction::STORE, static_cast<uint32_t>(chunk.setters.size() - 1U), containers, count, levels.back()->token);
+            popRegion();
+          }
+       }
+      else if (typeid(IfStatement) == typeid(source))
+       {
+         const IfStatement& node = static_cast<const IfStatement&>(source);
+         line(node);
+         uint32_t condition = allocate();
+         pushRegion(node.token, true);
+         expression(*node.condition, condition);
+         size_t toElse = emit(Instruction::JMPF, condition, 0U, 0U, node.token);
+         popRegion();
+         statement(*node.thenSeq);
+         size_t toEnd = emit(Instruction::JMP, 0U, 0U, 0U, node.token);
+         patch(toElse, chunk.code.size());
+         if (nullptr != node.elseSeq.get())
+          {
+            statement(*node.elseSeq);
+          }
+         patch(toEnd, chunk.code.size());
+       }
+      else if (typeid(WhileStatement) == typeid(source))
+       {
+         const WhileStatement& node = static_cast<const WhileStatement&>(source);
+         line(node);
+         uint32_t condition = allocate();
+         size_t start = chunk.code.size();
+         pushRegion(node.token, true);
+         expression(*node.condition, condition);
+         size_t toEnd = emit(Instruction::JMPF, condition, 0U, 0U, node.token);
+         popRegion();
+         activeLoops.emplace_back(node.id);
+         statement(*node.seq);
+         emit(Instruction::JMP, static_cast<uint32_t>(start), 0U, 0U, node.token);
+         patch(toEnd, chunk.code.size());
+         patch(activeLoops.back().breaks, chunk.code.size());
+         patch(activeLoops.back().continues, start);
+         activeLoops.pop_back();
+         chunk.loops.emplace_back(node.id, chunk.code.size(), start);
+       }
+      else if (typeid(SelectStatement) == typeid(source))
+       {
+         const SelectStatement& node = static_cast<const SelectStatement&>(source);
+         line(node);
+         uint32_t control = allocate();
+         expression(*node.control, control);
+
+         std::vector<size_t> toBody;
+         for (const std::shared_ptr<CaseContainer>& item : node.cases)
+          {
+            std::vector<size_t> toNext;
+            if (nullptr != item->condition.get())
+             {
+               uint32_t caseMark = top;
+               uint32_t result = allocate();
+               pushRegion(item->token, true);
+               if (nullptr == item->lower.get())
+                {
+                  uint32_t value = allocate();
+                  expression(*item->condition, value);
+                  switch (item->type)
+                   {
+                  case CaseContainer::AT:
+                     emit(Instruction::EQ, result, value, control, item->token);
+                     break;
+                  case CaseContainer::ABOVE: // This is inverted because we have inverted the condition.
+                     emit(Instruction::LE, result, value, control, item->token);
+                     break;
+                  case CaseContainer::BELOW: // This is inverted because we have inverted the condition.
+                     emit(Instruction::GE, result, value, control, item->token);
+                     break;
+                   }
+                  toNext.emplace_back(emit(Instruction::JMPF, result, 0U, 0U, item->token));
+                }
+               else
+                {
+                  uint32_t upper = allocate();
+                  expression(*item->condition, upper);
+                  uint32_t lower = allocate();
+                  expression(*item->lower, lower);
+                  emit(Instruction::LE, result, lower, control, item->token);
+                  toNext.emplace_back(emit(Instruction::JMPF, result, 0U, 0U, item->token));
+                  emit(Instruction::GE, result, upper, control, item->token);
+                  toNext.emplace_back(emit(Instruction::JMPF, result, 0U, 0U, item->token));
+                }
+               popRegion();
+               top = caseMark;
+             }
+            toBody.emplace_back(emit(Instruction::JMP, 0U, 0U, 0U, item->token));
+            patch(toNext, chunk.code.size());
+          }
+
+         std::vector<size_t> toEnd;
+         toEnd.emplace_back(emit(Instruction::JMP, 0U, 0U, 0U, node.token));
+         for (size_t i = 0U; i < node.cases.size(); ++i)
+          {
+            patch(toBody[i], chunk.code.size());
+            statement(*node.cases[i]->seq);
+             // Fall through to the next case, unless it breaks.
+            if (((i + 1U) < node.cases.size()) && (true == node.cases[i + 1U]->breaking))
+             {
+               toEnd.emplace_back(emit(Instruction::JMP, 0U, 0U, 0U, node.cases[i]->token));
+             }
+          }
+         patch(toEnd, chunk.code.size());
+       }
+      else if (typeid(ForStatement) == typeid(source))
+       {
+         const ForStatement& node = static_cast<const ForStatement&>(source);
+         line(node);
+         chunk.setters.emplace_back(node.setter);
+         uint32_t setter = static_cast<uint32_t>(chunk.setters.size() - 1U);
+         uint32_t current = allocate();
+         expression(*node.lower, current);
+         activeLoops.emplace_back(node.id);
+         size_t start;
+         size_t next;
+         if (nullptr == node.upper.get())
+          {
+            uint32_t iterator = static_cast<uint32_t>(chunk.iterators);
+            ++chunk.iterators;
+            pushRegion(node.token, true);
+            emit(Instruction::ITERPREP, iterator, current, 0U, node.token);
+            popRegion();
+            start = chunk.code.size();
+            next = start;
+            size_t toEnd = emit(Instruction::ITERNEXT, current, iterator, 0U, node.token);
+            emit(Instruction::SET, setter, current, 0U, node.token);
+            statement(*node.seq);
+            emit(Instruction::JMP, static_cast<uint32_t>(start), 0U, 0U, node.token);
+            patch(toEnd, chunk.code.size());
+          }
+         else
+          {
+            uint32_t upper = allocate();
+            expression(*node.upper, upper);
+            uint32_t step = allocate();
+            if (nullptr != node.step.get())
+             {
+               expression(*node.step, step);
+             }
+            else if (true == node.to)
+             {
+               emit(Instruction::LOADK, step, constant(constants.FLOAT_ONE), 0U, node.token);
+             }
+            else
+             {
+               emit(Instruction::LOADK, step, constant(std::make_shared<Types::FloatValue>(SlowFloat::SlowFloat(-1.0))), 0U, node.token);
+             }
+            uint32_t counter = static_cast<uint32_t>(chunk.counters);
+            ++chunk.counters;
+            emit(Instruction::FORPREP, counter, current, step, node.token);
+            uint32_t condition = allocate();
+            start = chunk.code.size();
+            emit(Instruction::SET, setter, current, 0U, node.token);
+             // The comparison reports its error, and then the loop reports it again.
+            pushRegion(node.token, true);
+            pushRegion(node.token, true);
+            emit((true == node.to) ? Instruction::LE : Instruction::GE, condition, current, upper, node.token);
+            popRegion();
+            popRegion();
+            size_t toEnd = emit(Instruction::JMPF, condition, 0U, 0U, node.token);
+            statement(*node.seq);
+            next = chunk.code.size();
+            pushRegion(node.token, true);
+            emit(Instruction::FORSTEP, counter, current, step, node.token);
+            popRegion();
+            emit(Instruction::JMP, static_cast<uint32_t>(start), 0U, 0U, node.token);
+            patch(toEnd, chunk.code.size());
+          }
+         patch(activeLoops.back().breaks, chunk.code.size());
+         patch(activeLoops.back().continues, next);
+         activeLoops.pop_back();
+         chunk.loops.emplace_back(node.id, chunk.code.size(), next);
+       }
+      else if (typeid(FlowControlStatement) == typeid(source))
+       {
+         const FlowControlStatement& node = static_cast<const FlowControlStatement&>(source);
+         line(node);
+         if (true == node.tailCall)
+          {
+            const FunctionCall& call = static_cast<const FunctionCall&>(*node.value);
+            uint32_t function = allocate();
+            for (size_t i = 0U; i < call.args.size(); ++i)
+             {
+               (void) allocate();
+             }
+            pushRegion(node.token, true);
+            expression(*call.location, function);
+            emit(Instruction::CHECK, function, static_cast<uint32_t>(call.args.size()), 0U, call.token);
+            for (size_t i = 0U; i < call.args.size(); ++i)
+             {
+               expression(*call.args[i], function + 1U + static_cast<uint32_t>(i));
+             }
+            popRegion();
+            emit(Instruction::TAILCALL, function, static_cast<uint32_t>(call.args.size()), 0U, node.token);
+          }
+         else if (FlowControl::RETURN == node.type)
+          {
+            uint32_t value = Instruction::NO_REGISTER;
+            if (nullptr != node.value.get())
+             {
+               value = allocate();
+               pushRegion(node.token, true);
+               expression(*node.value, value);
+               popRegion();
+             }
+            emit(Instruction::RET, value, 0U, 0U, node.token);
+          }
+         else
+          {
+            bool found = false;
+            for (size_t i = activeLoops.size(); (false == found) && (i > 0U); --i)
+             {
+               if (node.target == activeLoops[i - 1U].id)
+                {
+                  found = true;
+                  size_t jump = emit(Instruction::JMP, 0U, 0U, 0U, node.token);
+                  if (FlowControl::BREAK == node.type)
+                   {
+                     activeLoops[i - 1U].breaks.emplace_back(jump);
+                   }
+                  else
+                   {
+                     activeLoops[i - 1U].continues.emplace_back(jump);
+                   }
+                }
+             }
+            if (false == found) // Not for any loop in this Chunk: pass it up.
+             {
+               emit(Instruction::FLOW, static_cast<uint32_t>(node.target), static_cast<uint32_t>(node.type), 0U, node.token);
+             }
+          }
+       }
+      else
+       {
+         chunk.statements.emplace_back(&source);
+         emit(Instruction::EXEC, static_cast<uint32_t>(chunk.statements.size() - 1U), 0U, 0U, source.token);
+       }
+      top = mark;
+    }
+
+ } // namespace Engine
+
+ } // namespace Backwards
@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Engine/CallingContext.h"
 
 #include "Backwards/Engine/FatalException.h"
+#include "Backwards/Engine/Profiler.h"
 #include "Backwards/Engine/StackFrame.h"
 
 namespace Backwards
@@ -40,7 +41,7 @@ namespace Backwards
 namespace Engine
  {
 
-   CallingContext::CallingContext() : logger(nullptr), debugger(nullptr), currentFrame(nullptr), globalScope(nullptr)
+   CallingContext::CallingContext() : logger(nullptr), debugger(nullptr), profiler(nullptr), currentFrame(nullptr), globalScope(nullptr), useBytecode(false), values()
     {
     }
 
@@ -56,10 +57,18 @@ namespace Engine
          currentFrame->next = newFrame;
        }
       currentFrame = newFrame;
+      if (nullptr != profiler)
+       {
+         profiler->enter(newFrame->function);
+       }
     }
 
    void CallingContext::popContext()
     {
+      if (nullptr != profiler)
+       {
+         profiler->leave();
+       }
       currentFrame = currentFrame->prev;
       if (nullptr != currentFrame)
        {
@@ -67,15 +76,6 @@ namespace Engine
        }
     }
 
-   Scope* CallingContext::topScope()
-    {
-      if (false == scopes.empty())
-       {
-         return scopes.back();
-       }
-      return nullptr;
-    }
-
    void CallingContext::pushScope(Scope* scope)
     {
       scopes.emplace_back(scope);
@@ -97,7 +97,9 @@ namespace Engine
     {
       result->logger = logger;
       result->debugger = nullptr; // Prevent Debugger-ception
+      result->profiler = nullptr; // What the debugger does isn't what's being profiled.
       result->globalScope = globalScope;
+      result->useBytecode = useBytecode;
       result->pushScope(topScope());
     }
 
@@ -105,7 +107,7 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<Types::ValueType> LocalGetter::get(CallingContext& context) const
+   Types::Value LocalGetter::get(CallingContext& context) const
     {
       if (nullptr == context.currentFrame->locals[location].get())
        {
@@ -118,7 +120,7 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<Types::ValueType> ArgGetter::get(CallingContext& context) const
+   Types::Value ArgGetter::get(CallingContext& context) const
     {
       return context.currentFrame->args[location];
     }
@@ -127,16 +129,16 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<Types::ValueType> CaptureGetter::get(CallingContext& context) const
+   Types::Value CaptureGetter::get(CallingContext& context) const
     {
-      return context.currentFrame->captures[location];
+      return context.currentFrame->captures.get(location);
     }
 
    LocalSetter::LocalSetter(size_t location) : location(location)
     {
     }
 
-   void LocalSetter::set(CallingContext& context, const std::shared_ptr<Types::ValueType>& value) const
+   void LocalSetter::set(CallingContext& context, const Types::Value& value) const
     {
       context.currentFrame->locals[location] = value;
     }
@@ -145,7 +147,7 @@ namespace Engine
     {
     }
 
-   void ArgSetter::set(CallingContext& context, const std::shared_ptr<Types::ValueType>& value) const
+   void ArgSetter::set(CallingContext& context, const Types::Value& value) const
     {
       context.currentFrame->args[location] = value;
     }
@@ -154,16 +156,16 @@ namespace Engine
     {
     }
 
-   void CaptureSetter::set(CallingContext& context, const std::shared_ptr<Types::ValueType>& value) const
+   void CaptureSetter::set(CallingContext& context, const Types::Value& value) const
     {
-      context.currentFrame->captures[location] = value;
+      context.currentFrame->captures.set(location, value);
     }
 
    GlobalGetter::GlobalGetter(size_t location) : location(location)
     {
     }
 
-   std::shared_ptr<Types::ValueType> GlobalGetter::get(CallingContext& context) const
+   Types::Value GlobalGetter::get(CallingContext& context) const
     {
       if (nullptr == context.globalScope->vars[location].get())
        {
@@ -176,7 +178,7 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<Types::ValueType> ScopeGetter::get(CallingContext& context) const
+   Types::Value ScopeGetter::get(CallingContext& context) const
     {
       if (nullptr == context.topScope())
        {
@@ -186,7 +188,7 @@ namespace Engine
        {
          throw FatalException("Read of local variable with bad location.");
        }
-      if (nullptr == context.globalScope->vars[location].get())
+      if (nullptr == context.topScope()->vars[location].get())
        {
          throw FatalException("Read of local variable before set.");
        }
@@ -197,7 +199,7 @@ namespace Engine
     {
     }
 
-   void GlobalSetter::set(CallingContext& context, const std::shared_ptr<Types::ValueType>& value) const
+   void GlobalSetter::set(CallingContext& context, const Types::Value& value) const
     {
       context.globalScope->vars[location] = value;
     }
@@ -206,7 +208,7 @@ namespace Engine
     {
     }
 
-   void ScopeSetter::set(CallingContext& context, const std::shared_ptr<Types::ValueType>& value) const
+   void ScopeSetter::set(CallingContext& context, const Types::Value& value) const
     {
       if (nullptr == context.topScope())
        {
@@ -40,8 +40,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Engine/DebuggerHook.h"
 #include "Backwards/Engine/FunctionContext.h"
 #include "Backwards/Engine/StackFrame.h"
+#include "Backwards/Engine/VirtualMachine.h"
+#include "Backwards/Engine/Profiler.h"
 
+#include <iterator>
 #include <sstream>
+#include <typeinfo>
 
 namespace Backwards
  {
@@ -71,18 +75,73 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<Types::ValueType> Constant::evaluate (CallingContext&) const
+   Types::Value Constant::evaluate (CallingContext&) const
     {
       return value;
     }
 
 
-   Variable::Variable(const Input::Token& token, const std::shared_ptr<Getter>& getter) : Expression(token), getter(getter)
+   Variable::Variable(const Input::Token& token, const std::shared_ptr<Getter>& getter) :
+      Expression(token), getter(getter), access(GETTER), location(0U), epoch(0U)
     {
+      const Getter& source = *getter;
+      if (typeid(GlobalGetter) == typeid(source))
+       {
+         access = GLOBAL;
+         location = static_cast<const GlobalGetter&>(source).getLocation();
+       }
+      else if (typeid(ScopeGetter) == typeid(source))
+       {
+         access = SCOPE;
+         location = static_cast<const ScopeGetter&>(source).getLocation();
+       }
+      else if (typeid(LocalGetter) == typeid(source))
+       {
+         access = LOCAL;
+         location = static_cast<const LocalGetter&>(source).getLocation();
+       }
+      else if (typeid(ArgGetter) == typeid(source))
+       {
+         access = ARG;
+         location = static_cast<const ArgGetter&>(source).getLocation();
+       }
     }
 
-   std::shared_ptr<Types::ValueType> Variable::evaluate (CallingContext& context) const
+   Types::Value Variable::evaluate (CallingContext& context) const
     {
+      switch (access)
+       {
+      case GLOBAL:
+         if (nullptr != context.globalScope->vars[location].get())
+          {
+            return context.globalScope->vars[location];
+          }
+         break;
+      case SET_GLOBAL:
+         return context.globalScope->vars[location];
+      case SCOPE:
+       {
+         const Scope* scope = context.topScope();
+         if ((nullptr != scope) && (scope->epoch == epoch.load(std::memory_order_relaxed)) && (nullptr != scope->vars[location].get()))
+          {
+            return scope->vars[location];
+          }
+         Types::Value result = getter->get(context);
+          // Scopes only grow, so the location will stay in bounds.
+         epoch.store(context.topScope()->epoch, std::memory_order_relaxed);
+         return result;
+       }
+      case LOCAL:
+         if (nullptr != context.currentFrame->locals[location].get())
+          {
+            return context.currentFrame->locals[location];
+          }
+         break;
+      case ARG:
+         return context.currentFrame->args[location];
+      case GETTER:
+         break;
+       }
       return getter->get(context);
     }
 
@@ -92,13 +151,13 @@ namespace Engine
       Expression(token), lhs(lhs), rhs(rhs) \
     { \
     } \
-   std::shared_ptr<Types::ValueType> x::evaluate (CallingContext& context) const \
+   Types::Value x::evaluate (CallingContext& context) const \
     { \
       /* We don't want to catch an exception generated while evaluating the arguments, */ \
       /* just the one from performing this operation. */ \
-      std::shared_ptr<Types::ValueType> LHS = lhs->evaluate(context); \
-      std::shared_ptr<Types::ValueType> RHS = rhs->evaluate(context); \
-      std::shared_ptr<Types::ValueType> result; \
+      Types::Value LHS = lhs->evaluate(context); \
+      Types::Value RHS = rhs->evaluate(context); \
+      Types::Value result; \
       try \
        { \
          result = LHS->y(*RHS); \
@@ -127,11 +186,11 @@ namespace Engine
       Expression(token), lhs(lhs), rhs(rhs) \
     { \
     } \
-   std::shared_ptr<Types::ValueType> x::evaluate (CallingContext& context) const \
+   Types::Value x::evaluate (CallingContext& context) const \
     { \
       /* We don't want to catch an exception generated while evaluating the arguments, */ \
       /* just the one from performing this operation. */ \
-      std::shared_ptr<Types::ValueType> LHS = lhs->evaluate(context); \
+      Types::Value LHS = lhs->evaluate(context); \
       bool value; \
       try \
        { \
@@ -152,7 +211,7 @@ namespace Engine
             ConstantsSingleton::getInstance().FLOAT_ONE : \
             ConstantsSingleton::getInstance().FLOAT_ZERO; \
        } \
-      std::shared_ptr<Types::ValueType> RHS = rhs->evaluate(context); \
+      Types::Value RHS = rhs->evaluate(context); \
       try \
        { \
          value = RHS->logical(); \
@@ -180,12 +239,12 @@ namespace Engine
       Expression(token), lhs(lhs), rhs(rhs) \
     { \
     } \
-   std::shared_ptr<Types::ValueType> x::evaluate (CallingContext& context) const \
+   Types::Value x::evaluate (CallingContext& context) const \
     { \
       /* We don't want to catch an exception generated while evaluating the arguments, */ \
       /* just the one from performing this operation. */ \
-      std::shared_ptr<Types::ValueType> LHS = lhs->evaluate(context); \
-      std::shared_ptr<Types::ValueType> RHS = rhs->evaluate(context); \
+      Types::Value LHS = lhs->evaluate(context); \
+      Types::Value RHS = rhs->evaluate(context); \
       bool result; \
       try \
        { \
@@ -218,20 +277,20 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<Types::ValueType> DerefVar::evaluate (CallingContext& context) const
+   Types::Value DerefVar::evaluate (CallingContext& context) const
     {
       /* We don't want to catch an exception generated while evaluating the arguments, */
       /* just the one from performing this operation. */
-      std::shared_ptr<Types::ValueType> LHS = lhs->evaluate(context);
-      std::shared_ptr<Types::ValueType> RHS = rhs->evaluate(context);
-      std::shared_ptr<Types::ValueType> result;
+      Types::Value LHS = lhs->evaluate(context);
+      Types::Value RHS = rhs->evaluate(context);
+      Types::Value result;
       try
        {
-         if (typeid(Types::ArrayValue) == typeid(*LHS))
+         if (Types::ValueType::ARRAY == LHS->getType())
           {
-            result = GetIndex(LHS, RHS);
+            result = GetElement(LHS, RHS);
           }
-         else if (typeid(Types::DictionaryValue) == typeid(*LHS))
+         else if (Types::ValueType::DICTIONARY == LHS->getType())
           {
             result = GetValue(LHS, RHS);
           }
@@ -257,11 +316,11 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<Types::ValueType> Not::evaluate (CallingContext& context) const
+   Types::Value Not::evaluate (CallingContext& context) const
     {
       /* We don't want to catch an exception generated while evaluating the arguments, */
       /* just the one from performing this operation. */
-      std::shared_ptr<Types::ValueType> ARG = arg->evaluate(context);
+      Types::Value ARG = arg->evaluate(context);
       bool result;
       try
        {
@@ -286,12 +345,12 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<Types::ValueType> Negate::evaluate (CallingContext& context) const
+   Types::Value Negate::evaluate (CallingContext& context) const
     {
       /* We don't want to catch an exception generated while evaluating the arguments, */
       /* just the one from performing this operation. */
-      std::shared_ptr<Types::ValueType> ARG = arg->evaluate(context);
-      std::shared_ptr<Types::ValueType> result;
+      Types::Value ARG = arg->evaluate(context);
+      Types::Value result;
       try
        {
          result = ARG->neg();
@@ -310,7 +369,19 @@ namespace Engine
 
 
    StackFrame::StackFrame(std::shared_ptr<FunctionContext> function, const Input::Token& callingToken, StackFrame* prev) :
-      function(function), args(function->nargs), locals(function->nlocals), prev(prev), next(nullptr), callingToken(callingToken), depth(1U)
+      function(std::move(function)), args(this->function->nargs), locals(this->function->nlocals), captures(),
+      prev(prev), next(nullptr), callingToken(callingToken), depth(1U), tailCalls(0U)
+    {
+      if (nullptr != prev)
+       {
+         depth = prev->depth + 1U;
+       }
+    }
+
+   StackFrame::StackFrame(CallingContext& context, std::shared_ptr<FunctionContext> function, const Input::Token& callingToken,
+         const std::vector<std::shared_ptr<Types::ValueType> >& captures) :
+      function(std::move(function)), args(context.values, this->function->nargs), locals(context.values, this->function->nlocals), captures(captures),
+      prev(context.currentFrame), next(nullptr), callingToken(callingToken), depth(1U), tailCalls(0U)
     {
       if (nullptr != prev)
        {
@@ -319,17 +390,43 @@ namespace Engine
     }
 
 
+   void StackFrame::retarget (CallingContext& context, const Types::FunctionValue& callee)
+    {
+      function = (nullptr != callee.value.get()) ?
+         std::static_pointer_cast<FunctionContext>(callee.value) : std::static_pointer_cast<FunctionContext>(callee.valueToo.lock());
+       // The locals were carved after the args, so they go back first.
+      locals.reset(0U);
+      args.reset(function->nargs);
+      locals.reset(function->nlocals);
+      for (size_t i = 0U; i < args.size(); ++i)
+       {
+         args[i] = std::move(context.tailArgs[i]);
+       }
+      context.tailArgs.clear();
+      captures = CaptureValues(callee.captures);
+      ++tailCalls;
+      if (nullptr != context.profiler)
+       {
+         context.profiler->leave();
+         context.profiler->enter(function);
+       }
+    }
+
+
    FunctionCall::FunctionCall(const Input::Token& token, const std::shared_ptr<Expression>& location, const std::vector<std::shared_ptr<Expression> >& args) :
       Expression(token), location(location), args(args)
     {
     }
 
-   std::shared_ptr<Types::ValueType> FunctionCall::evaluate (CallingContext& context) const
+   Types::Value FunctionCall::evaluate (CallingContext& context) const
     {
-      /* We don't want to catch an exception generated while evaluating the arguments, */
-      /* just the one from performing this operation. */
-      std::shared_ptr<Types::ValueType> LOC = location->evaluate(context);
-      if (false == (typeid(Types::FunctionValue) == typeid(*LOC)))
+      return evaluate(context, location->evaluate(context));
+    }
+
+    // The checks made before the arguments are evaluated.
+   static std::shared_ptr<FunctionContext> checkCall (const Types::Value& LOC, size_t nargs, const Input::Token& token, CallingContext& context)
+    {
+      if (Types::ValueType::FUNCTION != LOC->getType())
        {
          std::stringstream str;
          str << "Call to not a Function at " << token.lineLocation << " on line " << token.lineNumber << " in file " << token.sourceFile;
@@ -339,15 +436,13 @@ namespace Engine
           }
          throw FatalException(str.str());
        }
-      std::shared_ptr<FunctionContext> function = std::dynamic_pointer_cast<FunctionContext>((std::dynamic_pointer_cast<Types::FunctionValue>(LOC)->valueToo).lock());
-      if (nullptr == function.get())
-       {
-         function = std::dynamic_pointer_cast<FunctionContext>(std::dynamic_pointer_cast<Types::FunctionValue>(LOC)->value);
-       }
-      if (args.size() != function->nargs)
+      const Types::FunctionValue& FUN = static_cast<const Types::FunctionValue&>(*LOC);
+      std::shared_ptr<FunctionContext> function = (nullptr != FUN.value.get()) ?
+         std::static_pointer_cast<FunctionContext>(FUN.value) : std::static_pointer_cast<FunctionContext>(FUN.valueToo.lock());
+      if (nargs != function->nargs)
        {
          std::stringstream str;
-         str << "Call to function with " << args.size() << " arguments, but function takes " << function->nargs <<
+         str << "Call to function with " << nargs << " arguments, but function takes " << function->nargs <<
             " arguments at " << token.lineLocation << " on line " << token.lineNumber << " in file " << token.sourceFile;
          if (nullptr != context.debugger)
           {
@@ -355,8 +450,24 @@ namespace Engine
           }
          throw FatalException(str.str());
        }
-      StackFrame frame (function, token, context.currentFrame);
-      frame.captures = std::dynamic_pointer_cast<Types::FunctionValue>(LOC)->captures;
+      return function;
+    }
+
+   static FlowControl run (FunctionContext& function, CallingContext& context)
+    {
+      if (true == context.useBytecode)
+       {
+         return VirtualMachine::Invoke(function, context);
+       }
+      return function.function->execute(context);
+    }
+
+   Types::Value FunctionCall::evaluate (CallingContext& context, const Types::Value& LOC) const
+    {
+      /* We don't want to catch an exception generated while evaluating the arguments, */
+      /* just the one from performing this operation. */
+      std::shared_ptr<FunctionContext> function = checkCall(LOC, args.size(), token, context);
+      StackFrame frame (context, function, token, static_cast<const Types::FunctionValue&>(*LOC).captures);
       for (size_t i = 0U; i < args.size(); ++i)
        {
          frame.args[i] = args[i]->evaluate(context);
@@ -366,23 +477,30 @@ namespace Engine
       context.pushContext(&frame);
       try
        {
-         std::shared_ptr<FlowControl> result;
+         FlowControl result;
+         Types::Value callee; // The function of the last tail call, whose captures the frame uses.
          try
           {
-            result = function->function->execute(context);
+            result = run(*frame.function, context);
+            while (FlowControl::TAIL_CALL == result.type)
+             {
+               callee = result.value;
+               frame.retarget(context, static_cast<const Types::FunctionValue&>(*callee));
+               result = run(*frame.function, context);
+             }
           }
          catch (const Types::TypedOperationException& e)
           {
             std::string msg = constructMessage(e);
             throw Types::TypedOperationException(msg);
           }
-         if (nullptr == result.get())
+         if (FlowControl::NONE == result.type)
           {
             std::stringstream str;
             str << "Function failed to return a value at " << token.lineLocation << " on line " << token.lineNumber << " in file " << token.sourceFile;
             throw FatalException(str.str());
           }
-         if (FlowControl::RETURN != result->type)
+         if (FlowControl::RETURN != result.type)
           {
             std::stringstream str;
             str << "Function had a 'break' or 'continue' outside of a loop at " << token.lineLocation << " on line " << token.lineNumber << " in file " << token.sourceFile;
@@ -393,7 +511,7 @@ namespace Engine
             throw FatalException(str.str());
           }
          context.popContext();
-         return result->value;
+         return result.value;
        }
       catch (...)
        {
@@ -402,6 +520,112 @@ namespace Engine
        }
     }
 
+   Types::Value FunctionCall::prepare (CallingContext& context) const
+    {
+      Types::Value LOC = location->evaluate(context);
+      (void) checkCall(LOC, args.size(), token, context);
+       // An argument may make calls of its own: they all finish before the arguments are handed over.
+      FrameValues values (context.values, args.size());
+      for (size_t i = 0U; i < args.size(); ++i)
+       {
+         values[i] = args[i]->evaluate(context);
+       }
+      context.tailArgs.assign(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+      return LOC;
+    }
+
+
+   NativeCall::NativeCall(const std::shared_ptr<FunctionCall>& call, const std::shared_ptr<Types::ValueType>& expected) :
+      Expression(call->token), call(call), expected(expected), constant(nullptr), unary(nullptr), binary(nullptr), ternary(nullptr)
+    {
+    }
+
+   std::shared_ptr<Expression> NativeCall::bind (const std::shared_ptr<FunctionCall>& call, const std::shared_ptr<Types::ValueType>& value)
+    {
+      if ((nullptr == value.get()) || (Types::ValueType::FUNCTION != value->getType()))
+       {
+         return call;
+       }
+      const std::shared_ptr<Types::FunctionObjectHolder>& holder = static_cast<const Types::FunctionValue&>(*value).value;
+      if (nullptr == holder.get())
+       {
+         return call;
+       }
+      const FunctionContext& function = static_cast<const FunctionContext&>(*holder);
+      if ((nullptr == function.function.get()) || (call->args.size() != function.nargs))
+       {
+         return call;
+       }
+
+       // The functions that take the CallingContext are left alone: they can see the frame.
+      std::shared_ptr<NativeCall> result = std::make_shared<NativeCall>(call, value);
+      const Statement& body = *function.function;
+      if (typeid(StandardConstantFunction) == typeid(body))
+       {
+         result->constant = static_cast<const StandardConstantFunction&>(body).function;
+       }
+      else if (typeid(StandardUnaryFunction) == typeid(body))
+       {
+         result->unary = static_cast<const StandardUnaryFunction&>(body).function;
+       }
+      else if (typeid(StandardBinaryFunction) == typeid(body))
+       {
+         result->binary = static_cast<const StandardBinaryFunction&>(body).function;
+       }
+      else if (typeid(StandardTernaryFunction) == typeid(body))
+       {
+         result->ternary = static_cast<const StandardTernaryFunction&>(body).function;
+       }
+      else
+       {
+         return call;
+       }
+      return result;
+    }
+
+   Types::Value NativeCall::evaluate (CallingContext& context) const
+    {
+      Types::Value LOC = call->location->evaluate(context);
+      if (LOC.get() != expected.get())
+       {
+         return call->evaluate(context, LOC);
+       }
+      Types::Value args [3U];
+      for (size_t i = 0U; i < call->args.size(); ++i)
+       {
+         args[i] = call->args[i]->evaluate(context);
+       }
+      try
+       {
+         return apply(args);
+       }
+      catch (const Types::TypedOperationException& e)
+       {
+         if (nullptr != context.debugger)
+          {
+            context.debugger->EnterDebugger(e.what(), context);
+          }
+         throw Types::TypedOperationException(constructMessage(e));
+       }
+    }
+
+   Types::Value NativeCall::apply (const Types::Value* args) const
+    {
+      if (nullptr != unary)
+       {
+         return unary(args[0U]);
+       }
+      else if (nullptr != binary)
+       {
+         return binary(args[0U], args[1U]);
+       }
+      else if (nullptr != ternary)
+       {
+         return ternary(args[0U], args[1U], args[2U]);
+       }
+      return constant();
+    }
+
 
    BuildFunction::BuildFunction(const Input::Token& token, const std::shared_ptr<FunctionContext>& prototype, const std::vector<std::shared_ptr<Expression> >& captures) :
       Expression(token), prototype(prototype), captures(captures)
@@ -413,7 +637,7 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<Types::ValueType> BuildFunction::evaluate (CallingContext& context) const
+   Types::Value BuildFunction::evaluate (CallingContext& context) const
     {
        /* This doesn't perform an operation that can fail. */
       std::vector<std::shared_ptr<Types::ValueType> > captured;
@@ -435,11 +659,11 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<Types::ValueType> TernaryOperation::evaluate (CallingContext& context) const
+   Types::Value TernaryOperation::evaluate (CallingContext& context) const
     {
       /* We don't want to catch an exception generated while evaluating the arguments, */
       /* just the one from performing this operation. */
-      std::shared_ptr<Types::ValueType> COND = condition->evaluate(context);
+      Types::Value COND = condition->evaluate(context);
       bool result;
       try
        {
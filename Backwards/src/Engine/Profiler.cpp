@@ -0,0 +1,246 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Backwards/Engine/Profiler.h"
+#include "Backwards/Engine/FunctionContext.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace Backwards
+ {
+
+namespace Engine
+ {
+
+   Profiler::FunctionStats::FunctionStats(const std::shared_ptr<FunctionContext>& function) :
+      function(function), calls(0U), inclusive(0U), exclusive(0U), active(0U)
+    {
+    }
+
+   Profiler::LineStats::LineStats(const std::string& sourceFile, size_t lineNumber, size_t hits) :
+      sourceFile(sourceFile), lineNumber(lineNumber), hits(hits)
+    {
+    }
+
+   Profiler::Node::Node(size_t function, size_t parent) : function(function), parent(parent), children(), exclusive(0U)
+    {
+    }
+
+   Profiler::Active::Active(size_t node, std::chrono::steady_clock::time_point start) : node(node), start(start), children(0U)
+    {
+    }
+
+   Profiler::Profiler() : functions(), functionIndex(), nodes(), stack(), tokens()
+    {
+      clear();
+    }
+
+   void Profiler::clear()
+    {
+      functions.clear();
+      functionIndex.clear();
+      nodes.clear();
+      nodes.emplace_back(0U, 0U);
+      stack.clear();
+      tokens.clear();
+    }
+
+   void Profiler::enter (const std::shared_ptr<FunctionContext>& function)
+    {
+      std::unordered_map<const FunctionContext*, size_t>::iterator found = functionIndex.find(function.get());
+      size_t index;
+      if (functionIndex.end() == found)
+       {
+         index = functions.size();
+         functions.emplace_back(function);
+         functionIndex.emplace(function.get(), index);
+       }
+      else
+       {
+         index = found->second;
+       }
+      ++functions[index].calls;
+      ++functions[index].active;
+
+      size_t parent = (true == stack.empty()) ? 0U : stack.back().node;
+      std::map<size_t, size_t>::iterator child = nodes[parent].children.find(index);
+      size_t node;
+      if (nodes[parent].children.end() == child)
+       {
+         node = nodes.size();
+         nodes.emplace_back(index, parent);
+         nodes[parent].children.emplace(index, node);
+       }
+      else
+       {
+         node = child->second;
+       }
+
+       // Read the clock last, so that the bookkeeping isn't counted against the function.
+      stack.emplace_back(node, std::chrono::steady_clock::now());
+    }
+
+   void Profiler::leave ()
+    {
+      std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+       // The Profiler may have been hooked on in the middle of a call.
+      if (true == stack.empty())
+       {
+         return;
+       }
+      const Active& top = stack.back();
+      uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - top.start).count());
+      uint64_t self = (elapsed > top.children) ? elapsed - top.children : 0U;
+
+      Node& node = nodes[top.node];
+      FunctionStats& function = functions[node.function];
+      node.exclusive += self;
+      function.exclusive += self;
+      if (0U == --function.active)
+       {
+         function.inclusive += elapsed;
+       }
+
+      stack.pop_back();
+      if (false == stack.empty())
+       {
+         stack.back().children += elapsed;
+       }
+    }
+
+   void Profiler::line (const Input::Token& token)
+    {
+      std::unordered_map<const Input::Token*, LineStats>::iterator found = tokens.find(&token);
+      if (tokens.end() == found)
+       {
+         tokens.emplace(&token, LineStats(token.sourceFile, token.lineNumber, 1U));
+       }
+      else
+       {
+         ++found->second.hits;
+       }
+    }
+
+   const std::string& Profiler::nameOf (const FunctionContext& function)
+    {
+      static const std::string anonymous ("(anonymous)");
+      return (true == function.name.empty()) ? anonymous : function.name;
+    }
+
+   static bool byExclusive (const Profiler::FunctionStats& lhs, const Profiler::FunctionStats& rhs)
+    {
+      if (lhs.exclusive != rhs.exclusive)
+       {
+         return lhs.exclusive > rhs.exclusive;
+       }
+      return Profiler::nameOf(*lhs.function) < Profiler::nameOf(*rhs.function);
+    }
+
+   static bool byHits (const Profiler::LineStats& lhs, const Profiler::LineStats& rhs)
+    {
+      return lhs.hits > rhs.hits;
+    }
+
+   std::vector<Profiler::FunctionStats> Profiler::getFunctions () const
+    {
+      std::vector<FunctionStats> result (functions);
+      std::stable_sort(result.begin(), result.end(), byExclusive);
+      return result;
+    }
+
+   std::vector<Profiler::LineStats> Profiler::getLines () const
+    {
+      std::map<std::pair<std::string, size_t>, size_t> lines;
+      for (const std::pair<const Input::Token* const, LineStats>& token : tokens)
+       {
+         lines[std::make_pair(token.second.sourceFile, token.second.lineNumber)] += token.second.hits;
+       }
+      std::vector<LineStats> result;
+      for (const std::pair<const std::pair<std::string, size_t>, size_t>& line : lines)
+       {
+         result.emplace_back(line.first.first, line.first.second, line.second);
+       }
+      std::stable_sort(result.begin(), result.end(), byHits);
+      return result;
+    }
+
+   std::string Profiler::folded () const
+    {
+      std::stringstream str;
+      for (size_t i = 1U; i < nodes.size(); ++i)
+       {
+         if (0U == nodes[i].exclusive)
+          {
+            continue;
+          }
+         std::vector<size_t> path;
+         for (size_t node = i; 0U != node; node = nodes[node].parent)
+          {
+            path.emplace_back(nodes[node].function);
+          }
+         for (std::vector<size_t>::const_reverse_iterator iter = path.rbegin(); path.rend() != iter; ++iter)
+          {
+            if (path.rbegin() != iter)
+             {
+               str << ";";
+             }
+            str << nameOf(*functions[*iter].function);
+          }
+         str << " " << nodes[i].exclusive << std::endl;
+       }
+      return str.str();
+    }
+
+   std::string Profiler::report (size_t count) const
+    {
+      std::stringstream str;
+      str << "Functions by exclusive time (microseconds):" << std::endl;
+      str << std::setw(10) << "calls" << std::setw(14) << "inclusive" << std::setw(14) << "exclusive" << "  name" << std::endl;
+      std::vector<FunctionStats> ranked = getFunctions();
+      for (size_t i = 0U; (i < count) && (i < ranked.size()); ++i)
+       {
+         str << std::setw(10) << ranked[i].calls << std::setw(14) << (ranked[i].inclusive / 1000U) <<
+            std::setw(14) << (ranked[i].exclusive / 1000U) << "  " << nameOf(*ranked[i].function) << std::endl;
+       }
+      str << "Lines by hits:" << std::endl;
+      std::vector<LineStats> lines = getLines();
+      for (size_t i = 0U; (i < count) && (i < lines.size()); ++i)
+       {
+         str << std::setw(10) << lines[i].hits << "  line " << lines[i].lineNumber << " in file " << lines[i].sourceFile << std::endl;
+       }
+      return str.str();
+    }
+
+ } // namespace Engine
+
+ } // namespace Backwards
@@ -39,6 +39,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Backwards/Engine/ConstantsSingleton.h"
 #include "Backwards/Engine/DebuggerHook.h"
+#include "Backwards/Engine/Profiler.h"
 
 #include <sstream>
 
@@ -48,7 +49,11 @@ namespace Backwards
 namespace Engine
  {
 
-   FlowControl::FlowControl(const Input::Token& source, Type type, size_t target, const std::shared_ptr<Types::ValueType>& value) : source(source), type(type), target(target), value(value)
+   FlowControl::FlowControl() : source(nullptr), type(NONE), target(NO_TARGET)
+    {
+    }
+
+   FlowControl::FlowControl(const Input::Token& source, Type type, size_t target, const Types::Value& value) : source(&source), type(type), target(target), value(value)
     {
     }
 
@@ -58,14 +63,23 @@ namespace Engine
     {
     }
 
+    // Count the line of a statement, if the run is being profiled.
+   static void countLine (CallingContext& context, const Input::Token& token)
+    {
+      if (nullptr != context.profiler)
+       {
+         context.profiler->line(token);
+       }
+    }
+
 
    NOP::NOP(const Input::Token& token) : Statement(token)
     {
     }
 
-   std::shared_ptr<FlowControl> NOP::execute (CallingContext&) const
+   FlowControl NOP::execute (CallingContext&) const
     {
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
 
@@ -73,10 +87,11 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> Expr::execute (CallingContext& context) const
+   FlowControl Expr::execute (CallingContext& context) const
     {
+      countLine(context, token);
       (void) expr->evaluate(context);
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
 
@@ -85,18 +100,18 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> StatementSeq::execute (CallingContext& context) const
+   FlowControl StatementSeq::execute (CallingContext& context) const
     {
       for (std::vector<std::shared_ptr<Statement> >::const_iterator iter = statements.begin();
          statements.end() != iter; ++iter)
        {
-         std::shared_ptr<FlowControl> temp = (*iter)->execute(context);
-         if (nullptr != temp.get())
+         FlowControl temp = (*iter)->execute(context);
+         if (FlowControl::NONE != temp.type)
           {
             return temp;
           }
        }
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
 
@@ -105,35 +120,17 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<Types::ValueType> RecAssignState::evaluate
-      (CallingContext& context, const std::shared_ptr<Types::ValueType>& lhs, const std::shared_ptr<Expression>& rhs) const
-    {
-      std::shared_ptr<Types::ValueType> result;
-      if (nullptr == next.get())
-       {
-         result = setIndex(lhs, index->evaluate(context), rhs->evaluate(context), context);
-       }
-      else
-       {
-         std::shared_ptr<Types::ValueType> arrayIndex = index->evaluate(context);
-          {
-            result = setIndex(lhs, arrayIndex, next->evaluate(context, getIndex(lhs, arrayIndex, context), rhs), context);
-          }
-       }
-      return result;
-    }
-
    std::shared_ptr<Types::ValueType> RecAssignState::getIndex (std::shared_ptr<Types::ValueType> container, std::shared_ptr<Types::ValueType> index,
       CallingContext& context) const
     {
       std::shared_ptr<Types::ValueType> result;
       try
        {
-         if (typeid(Types::ArrayValue) == typeid(*container))
+         if (Types::ValueType::ARRAY == container->getType())
           {
             result = GetIndex(container, index);
           }
-         else if (typeid(Types::DictionaryValue) == typeid(*container))
+         else if (Types::ValueType::DICTIONARY == container->getType())
           {
             result = GetValue(container, index);
           }
@@ -154,35 +151,26 @@ namespace Engine
       return result;
     }
 
-   std::shared_ptr<Types::ValueType> RecAssignState::setIndex (std::shared_ptr<Types::ValueType> container, std::shared_ptr<Types::ValueType> index,
-      std::shared_ptr<Types::ValueType> value, CallingContext& context) const
+   static std::shared_ptr<Types::ValueType> update (std::shared_ptr<Types::ValueType>&& container, const std::shared_ptr<Types::ValueType>& index,
+      const std::shared_ptr<Types::ValueType>& value)
     {
-      std::shared_ptr<Types::ValueType> result;
-      try
+      if (Types::ValueType::ARRAY == container->getType())
        {
-         if (typeid(Types::ArrayValue) == typeid(*container))
-          {
-            result = SetIndex(container, index, value);
-          }
-         else if (typeid(Types::DictionaryValue) == typeid(*container))
-          {
-            result = Insert(container, index, value);
-          }
-         else
-          {
-            throw Types::TypedOperationException("Error indexing non-Collection.");
-          }
+         return SetIndexInPlace(std::move(container), index, value);
        }
-      catch (const Types::TypedOperationException& e)
+      else if (Types::ValueType::DICTIONARY == container->getType())
        {
-         std::string msg = Expression::constructMessage(e, token);
-         if (nullptr != context.debugger)
-          {
-            context.debugger->EnterDebugger(msg, context);
-          }
-         throw Types::TypedOperationException(msg);
+         return InsertInPlace(std::move(container), index, value);
+       }
+      else
+       {
+         throw Types::TypedOperationException("Error indexing non-Collection.");
        }
-      return result;
+    }
+
+   static bool isCollection (const std::shared_ptr<Types::ValueType>& value)
+    {
+      return (Types::ValueType::ARRAY == value->getType()) || (Types::ValueType::DICTIONARY == value->getType());
     }
 
 
@@ -192,17 +180,89 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> Assignment::execute (CallingContext& context) const
+   FlowControl Assignment::execute (CallingContext& context) const
     {
+      countLine(context, token);
       if (nullptr == index.get())
        {
          setter->set(context, rhs->evaluate(context));
        }
       else
        {
-         setter->set(context, index->evaluate(context, getter->get(context), rhs));
+          // Walk down the indices, remembering each container, then rebuild the containers on the way back up.
+         std::vector<Types::Value> containers;
+         std::vector<Types::Value> indices;
+         const RecAssignState* last = nullptr;
+         containers.emplace_back(getter->get(context));
+         for (const RecAssignState* level = index.get(); nullptr != level; level = level->next.get())
+          {
+            indices.emplace_back(level->index->evaluate(context));
+            if (nullptr != level->next.get())
+             {
+               containers.emplace_back(level->getIndex(containers.back(), indices.back(), context));
+             }
+            last = level;
+          }
+         Types::Value value = rhs->evaluate(context);
+         try
+          {
+            store(context, *setter, containers.data(), indices.data(), containers.size(), value);
+          }
+         catch (const Types::TypedOperationException& e)
+          {
+            std::string msg = Expression::constructMessage(e, last->token);
+            if (nullptr != context.debugger)
+             {
+               context.debugger->EnterDebugger(msg, context);
+             }
+            throw Types::TypedOperationException(msg);
+          }
+       }
+      return FlowControl();
+    }
+
+   void Assignment::store (CallingContext& context, const Setter& setter, Types::Value* containers, const Types::Value* indices, size_t count,
+      const Types::Value& value)
+    {
+       // Script code can't run from here on, so nobody can see the containers while we work on them.
+       // Release every reference to them that we can: the variable's, then each container's reference to the next one down,
+       // when we hold the only reference to that container. Whatever is left with one reference can then be updated in place.
+      setter.set(context, Types::Value());
+      std::vector<std::shared_ptr<Types::ValueType> > owned;
+      owned.reserve(count);
+      for (size_t i = 0U; i < count; ++i)
+       {
+         owned.emplace_back(containers[i].take());
+       }
+       // Only detach a child that is itself a collection: a float in a packed array has no reference to release,
+       // and anything else can't be indexed, so the update below must fail with the variable left as it was.
+      for (size_t i = 1U; (i < count) && (1 == owned[i - 1U].use_count()) && (true == isCollection(owned[i])); ++i)
+       {
+         owned[i - 1U] = update(std::move(owned[i - 1U]), indices[i - 1U], std::shared_ptr<Types::ValueType>());
        }
-      return std::shared_ptr<FlowControl>();
+
+      std::shared_ptr<Types::ValueType> result;
+      try
+       {
+         result = update(std::move(owned[count - 1U]), indices[count - 1U], value);
+       }
+      catch (...)
+       {
+          // Only the last container can fail: we have already indexed the others with these indices.
+          // The failed update didn't take the container, so rebuild the variable as it was.
+         result = std::move(owned[count - 1U]);
+         for (size_t i = count - 1U; i > 0U; --i)
+          {
+            result = update(std::move(owned[i - 1U]), indices[i - 1U], result);
+          }
+         setter.set(context, result);
+         throw;
+       }
+      for (size_t i = count - 1U; i > 0U; --i)
+       {
+         result = update(std::move(owned[i - 1U]), indices[i - 1U], result);
+       }
+      setter.set(context, result);
     }
 
 
@@ -212,8 +272,9 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> IfStatement::execute (CallingContext& context) const
+   FlowControl IfStatement::execute (CallingContext& context) const
     {
+      countLine(context, token);
       bool conditional = true;
       try
        {
@@ -244,8 +305,9 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> WhileStatement::execute (CallingContext& context) const
+   FlowControl WhileStatement::execute (CallingContext& context) const
     {
+      countLine(context, token);
       bool conditional = true;
       try
        {
@@ -262,32 +324,33 @@ namespace Engine
        }
       while (true == conditional)
        {
-         std::shared_ptr<FlowControl> temp = seq->execute(context);
+         FlowControl temp = seq->execute(context);
 
-         if (nullptr != temp.get())
+         switch (temp.type)
           {
-            switch (temp->type)
+         case FlowControl::NONE:
+            break; // Carry on.
+         case FlowControl::RETURN:
+         case FlowControl::TAIL_CALL:
+            return temp; // Pass it up.
+         case FlowControl::BREAK:
+            if (id == temp.target)
              {
-            case FlowControl::RETURN:
-               return temp; // Pass it up.
-            case FlowControl::BREAK:
-               if (id == temp->target)
-                {
-                  return std::shared_ptr<FlowControl>(); // Loop is done.
-                }
-               else
-                {
-                  return temp; // Not for me, pass it up.
-                }
-            case FlowControl::CONTINUE:
-               if (id != temp->target)
-                {
-                  return temp; // Not for me, pass it up.
-                }
-               // Else do nothing: the previous iteration has stopped and we will move on to the next.
+               return FlowControl(); // Loop is done.
              }
+            else
+             {
+               return temp; // Not for me, pass it up.
+             }
+         case FlowControl::CONTINUE:
+            if (id != temp.target)
+             {
+               return temp; // Not for me, pass it up.
+             }
+            // Else do nothing: the previous iteration has stopped and we will move on to the next.
           }
 
+         countLine(context, token); // Each test of the condition is counted, as the VirtualMachine jumps back to the statement's start.
          try
           {
             conditional = condition->evaluate(context)->logical();
@@ -302,7 +365,7 @@ namespace Engine
             throw Types::TypedOperationException(msg);
           }
        }
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
 
@@ -311,7 +374,7 @@ namespace Engine
     {
     }
 
-   bool CaseContainer::evaluate (CallingContext& context, const std::shared_ptr<Types::ValueType>& controlVal) const
+   bool CaseContainer::evaluate (CallingContext& context, const Types::Value& controlVal) const
     {
       bool result = false;
       try
@@ -337,8 +400,8 @@ namespace Engine
           }
          else // two comparisons
           {
-            std::shared_ptr<Types::ValueType> TOP = condition->evaluate(context);
-            std::shared_ptr<Types::ValueType> BOTTOM = lower->evaluate(context);
+            Types::Value TOP = condition->evaluate(context);
+            Types::Value BOTTOM = lower->evaluate(context);
             result = BOTTOM->leq(*controlVal) && TOP->geq(*controlVal);
           }
        }
@@ -359,9 +422,10 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> SelectStatement::execute (CallingContext& context) const
+   FlowControl SelectStatement::execute (CallingContext& context) const
     {
-      std::shared_ptr<Types::ValueType> controlVal = control->evaluate(context);
+      countLine(context, token);
+      Types::Value controlVal = control->evaluate(context);
 
       bool end = false;
       for (std::vector<std::shared_ptr<CaseContainer> >::const_iterator iter = cases.begin();
@@ -371,8 +435,8 @@ namespace Engine
           {
             do
              {
-               std::shared_ptr<FlowControl> temp = (*iter)->seq->execute(context);
-               if (nullptr != temp.get())
+               FlowControl temp = (*iter)->seq->execute(context);
+               if (FlowControl::NONE != temp.type)
                 {
                   return temp;
                 }
@@ -382,10 +446,12 @@ namespace Engine
             end = true;
           }
        }
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
 
+   const int64_t ForStatement::MAX_COUNTER = 999999999;
+
    ForStatement::ForStatement(const Input::Token& token, const std::shared_ptr<Getter>& getter, const std::shared_ptr<Setter>& setter,
          const std::shared_ptr<Expression>& lower, bool to, const std::shared_ptr<Expression>& upper,
          const std::shared_ptr<Expression>& step, const std::shared_ptr<Statement>& seq, size_t id) :
@@ -393,9 +459,10 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> ForStatement::execute (CallingContext& context) const
+   FlowControl ForStatement::execute (CallingContext& context) const
     {
-      std::shared_ptr<Types::ValueType> currentValue = lower->evaluate(context);
+      countLine(context, token);
+      Types::Value currentValue = lower->evaluate(context);
 
       if (nullptr == upper.get())
        {
@@ -407,10 +474,10 @@ namespace Engine
        }
     }
 
-   std::shared_ptr<FlowControl> ForStatement::loopIter (CallingContext& context, std::shared_ptr<Types::ValueType> currentValue) const
+   FlowControl ForStatement::loopIter (CallingContext& context, Types::Value currentValue) const
     {
-      std::shared_ptr<Types::ValueType> UPPER = upper->evaluate(context);
-      std::shared_ptr<Types::ValueType> STEP;
+      Types::Value UPPER = upper->evaluate(context);
+      Types::Value STEP;
       if (nullptr == step.get())
        {
          if (true == to)
@@ -419,35 +486,86 @@ namespace Engine
           }
          else
           {
-            STEP = std::make_shared<Types::FloatValue>(SlowFloat::SlowFloat(-1.0));
+            STEP = Types::Value(SlowFloat::SlowFloat(-1.0));
           }
        }
       else
        {
          STEP = step->evaluate(context);
        }
-      std::shared_ptr<Expression> del = std::make_shared<Constant>(token, STEP);
+
+       // Neither the comparison nor the increment can fail if everything is a Float.
+      if ((Types::ValueType::FLOAT == currentValue->getType()) && (Types::ValueType::FLOAT == UPPER->getType()) && (Types::ValueType::FLOAT == STEP->getType()))
+       {
+         return numericIter(context, currentValue, static_cast<const Types::FloatValue&>(*UPPER).value, static_cast<const Types::FloatValue&>(*STEP).value);
+       }
 
       while (true)
        {
          setter->set(context, currentValue);
 
-         std::shared_ptr<Expression> lcv = std::make_shared<Constant>(token, currentValue);
-         std::shared_ptr<Expression> limit = std::make_shared<Constant>(token, UPPER);
-         std::shared_ptr<Expression> comparator;
-         if (true == to)
+         bool conditional = false;
+         try
           {
-            comparator = std::make_shared<LEQ>(token, lcv, limit);
+             // This used to be a LEQ or GEQ node, which reported the error before we reported it again.
+            try
+             {
+               conditional = (true == to) ? currentValue->leq(*UPPER) : currentValue->geq(*UPPER);
+             }
+            catch (const Types::TypedOperationException& e)
+             {
+               std::string msg = Expression::constructMessage(e, token);
+               if (nullptr != context.debugger)
+                {
+                  context.debugger->EnterDebugger(msg, context);
+                }
+               throw Types::TypedOperationException(msg);
+             }
           }
-         else
+         catch (const Types::TypedOperationException& e)
           {
-            comparator = std::make_shared<GEQ>(token, lcv, limit);
+            std::string msg = Expression::constructMessage(e, token);
+            if (nullptr != context.debugger)
+             {
+               context.debugger->EnterDebugger(msg, context);
+             }
+            throw Types::TypedOperationException(msg);
+          }
+
+         if (false == conditional)
+          {
+            break;
+          }
+
+         FlowControl temp = seq->execute(context);
+
+         switch (temp.type)
+          {
+         case FlowControl::NONE:
+            break; // Carry on.
+         case FlowControl::RETURN:
+         case FlowControl::TAIL_CALL:
+            return temp; // Pass it up.
+         case FlowControl::BREAK:
+            if (id == temp.target)
+             {
+               return FlowControl(); // Loop is done.
+             }
+            else
+             {
+               return temp; // Not for me, pass it up.
+             }
+         case FlowControl::CONTINUE:
+            if (id != temp.target)
+             {
+               return temp; // Not for me, pass it up.
+             }
+            // Else do nothing: the previous iteration has stopped and we will move on to the next.
           }
 
-         bool conditional = false;
          try
           {
-            conditional = comparator->evaluate(context)->logical();
+            currentValue = currentValue->add(*STEP);
           }
          catch (const Types::TypedOperationException& e)
           {
@@ -458,80 +576,119 @@ namespace Engine
              }
             throw Types::TypedOperationException(msg);
           }
+       }
+      return FlowControl();
+    }
 
-         if (false == conditional)
+   FlowControl ForStatement::numericIter (CallingContext& context, Types::Value currentValue,
+      const SlowFloat::SlowFloat& limit, const SlowFloat::SlowFloat& delta) const
+    {
+      SlowFloat::SlowFloat current = static_cast<const Types::FloatValue&>(*currentValue).value;
+
+       // While the counter is an integer that a Float holds exactly, count with an integer.
+      int64_t count, last, stride;
+      bool integral = (true == SlowFloat::toInt64(current, count)) && (true == SlowFloat::toInt64(limit, last)) &&
+         (true == SlowFloat::toInt64(delta, stride)) && (0 != stride) && (count >= -MAX_COUNTER) && (count <= MAX_COUNTER) &&
+         (stride >= -MAX_COUNTER) && (stride <= MAX_COUNTER);
+
+      while (true)
+       {
+         setter->set(context, currentValue);
+
+         if (true == integral)
+          {
+            if (false == ((true == to) ? (count <= last) : (count >= last)))
+             {
+               break;
+             }
+          }
+         else if (false == ((true == to) ? (current <= limit) : (current >= limit)))
           {
             break;
           }
 
-         std::shared_ptr<FlowControl> temp = seq->execute(context);
+         FlowControl temp = seq->execute(context);
 
-         if (nullptr != temp.get())
+         switch (temp.type)
           {
-            switch (temp->type)
+         case FlowControl::NONE:
+            break; // Carry on.
+         case FlowControl::RETURN:
+         case FlowControl::TAIL_CALL:
+            return temp; // Pass it up.
+         case FlowControl::BREAK:
+            if (id == temp.target)
              {
-            case FlowControl::RETURN:
-               return temp; // Pass it up.
-            case FlowControl::BREAK:
-               if (id == temp->target)
-                {
-                  return std::shared_ptr<FlowControl>(); // Loop is done.
-                }
-               else
-                {
-                  return temp; // Not for me, pass it up.
-                }
-            case FlowControl::CONTINUE:
-               if (id != temp->target)
-                {
-                  return temp; // Not for me, pass it up.
-                }
-               // Else do nothing: the previous iteration has stopped and we will move on to the next.
+               return FlowControl(); // Loop is done.
              }
+            else
+             {
+               return temp; // Not for me, pass it up.
+             }
+         case FlowControl::CONTINUE:
+            if (id != temp.target)
+             {
+               return temp; // Not for me, pass it up.
+             }
+            // Else do nothing: the previous iteration has stopped and we will move on to the next.
           }
 
-         Plus plus (token, lcv, del);
-         currentValue = plus.evaluate(context);
+         if ((true == integral) && (count + stride >= -MAX_COUNTER) && (count + stride <= MAX_COUNTER) && (0 != count + stride))
+          {
+            count += stride;
+            current = SlowFloat::fromInt64(count);
+          }
+         else
+          {
+             // Zero takes its sign from the rounding mode, so let the Float arithmetic make it.
+            current = current + delta;
+            if (true == integral)
+             {
+               count += stride;
+               integral = (count >= -MAX_COUNTER) && (count <= MAX_COUNTER);
+             }
+          }
+         currentValue = Types::Value(current);
        }
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
-   static std::shared_ptr<FlowControl> arrayIter(CallingContext& context, std::shared_ptr<Types::ArrayValue> currentValue, const std::shared_ptr<Setter>& setter, const std::shared_ptr<Statement>& seq, size_t id)
+   static FlowControl arrayIter(CallingContext& context, std::shared_ptr<Types::ArrayValue> currentValue, const std::shared_ptr<Setter>& setter, const std::shared_ptr<Statement>& seq, size_t id)
     {
-      for (std::shared_ptr<Types::ValueType> iter : currentValue->value)
+      for (Types::Value iter : currentValue->value)
        {
          setter->set(context, iter);
 
-         std::shared_ptr<FlowControl> temp = seq->execute(context);
+         FlowControl temp = seq->execute(context);
 
-         if (nullptr != temp.get())
+         switch (temp.type)
           {
-            switch (temp->type)
+         case FlowControl::NONE:
+            break; // Carry on.
+         case FlowControl::RETURN:
+         case FlowControl::TAIL_CALL:
+            return temp; // Pass it up.
+         case FlowControl::BREAK:
+            if (id == temp.target)
              {
-            case FlowControl::RETURN:
-               return temp; // Pass it up.
-            case FlowControl::BREAK:
-               if (id == temp->target)
-                {
-                  return std::shared_ptr<FlowControl>(); // Loop is done.
-                }
-               else
-                {
-                  return temp; // Not for me, pass it up.
-                }
-            case FlowControl::CONTINUE:
-               if (id != temp->target)
-                {
-                  return temp; // Not for me, pass it up.
-                }
-               // Else do nothing: the previous iteration has stopped and we will move on to the next.
+               return FlowControl(); // Loop is done.
              }
+            else
+             {
+               return temp; // Not for me, pass it up.
+             }
+         case FlowControl::CONTINUE:
+            if (id != temp.target)
+             {
+               return temp; // Not for me, pass it up.
+             }
+            // Else do nothing: the previous iteration has stopped and we will move on to the next.
           }
        }
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
-   static std::shared_ptr<FlowControl> dictIter(CallingContext& context, std::shared_ptr<Types::DictionaryValue> currentValue, const std::shared_ptr<Setter>& setter, const std::shared_ptr<Statement>& seq, size_t id)
+   static FlowControl dictIter(CallingContext& context, std::shared_ptr<Types::DictionaryValue> currentValue, const std::shared_ptr<Setter>& setter, const std::shared_ptr<Statement>& seq, size_t id)
     {
       for (auto iter : currentValue->value)
        {
@@ -540,44 +697,44 @@ namespace Engine
          currIter->value.push_back(iter.second);
          setter->set(context, currIter);
 
-         std::shared_ptr<FlowControl> temp = seq->execute(context);
+         FlowControl temp = seq->execute(context);
 
-         if (nullptr != temp.get())
+         switch (temp.type)
           {
-            switch (temp->type)
+         case FlowControl::NONE:
+            break; // Carry on.
+         case FlowControl::RETURN:
+         case FlowControl::TAIL_CALL:
+            return temp; // Pass it up.
+         case FlowControl::BREAK:
+            if (id == temp.target)
              {
-            case FlowControl::RETURN:
-               return temp; // Pass it up.
-            case FlowControl::BREAK:
-               if (id == temp->target)
-                {
-                  return std::shared_ptr<FlowControl>(); // Loop is done.
-                }
-               else
-                {
-                  return temp; // Not for me, pass it up.
-                }
-            case FlowControl::CONTINUE:
-               if (id != temp->target)
-                {
-                  return temp; // Not for me, pass it up.
-                }
-               // Else do nothing: the previous iteration has stopped and we will move on to the next.
+               return FlowControl(); // Loop is done.
              }
+            else
+             {
+               return temp; // Not for me, pass it up.
+             }
+         case FlowControl::CONTINUE:
+            if (id != temp.target)
+             {
+               return temp; // Not for me, pass it up.
+             }
+            // Else do nothing: the previous iteration has stopped and we will move on to the next.
           }
        }
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
-   std::shared_ptr<FlowControl> ForStatement::collIter (CallingContext& context, std::shared_ptr<Types::ValueType> currentValue) const
+   FlowControl ForStatement::collIter (CallingContext& context, std::shared_ptr<Types::ValueType> currentValue) const
     {
-      if (typeid(Types::ArrayValue) == typeid(*currentValue.get()))
+      if (Types::ValueType::ARRAY == currentValue->getType())
        {
-         return arrayIter(context, std::dynamic_pointer_cast<Types::ArrayValue>(currentValue), setter, seq, id);
+         return arrayIter(context, std::static_pointer_cast<Types::ArrayValue>(currentValue), setter, seq, id);
        }
-      else if (typeid(Types::DictionaryValue) == typeid(*currentValue.get()))
+      else if (Types::ValueType::DICTIONARY == currentValue->getType())
        {
-         return dictIter(context, std::dynamic_pointer_cast<Types::DictionaryValue>(currentValue), setter, seq, id);
+         return dictIter(context, std::static_pointer_cast<Types::DictionaryValue>(currentValue), setter, seq, id);
        }
       else
        {
@@ -593,17 +750,22 @@ namespace Engine
 
 
    FlowControlStatement::FlowControlStatement(const Input::Token& token, FlowControl::Type type, size_t target, const std::shared_ptr<Expression>& value) :
-      Statement(token), type(type), target(target), value(value)
+      Statement(token), type(type), target(target), value(value), tailCall(false)
     {
     }
 
-   std::shared_ptr<FlowControl> FlowControlStatement::execute (CallingContext& context) const
+   FlowControl FlowControlStatement::execute (CallingContext& context) const
     {
-      std::shared_ptr<Types::ValueType> VALUE;
+      countLine(context, token);
+      Types::Value VALUE;
       if (nullptr != value.get())
        {
          try
           {
+            if (true == tailCall)
+             {
+               return FlowControl(token, FlowControl::TAIL_CALL, target, static_cast<const FunctionCall&>(*value).prepare(context));
+             }
             VALUE = value->evaluate(context);
           }
          catch (const Types::TypedOperationException& e)
@@ -616,7 +778,7 @@ namespace Engine
             throw Types::TypedOperationException(msg);
           }
        }
-      return std::make_shared<FlowControl>(token, type, target, VALUE);
+      return FlowControl(token, type, target, VALUE);
     }
 
 
@@ -624,9 +786,9 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> StandardConstantFunction::execute (CallingContext&) const
+   FlowControl StandardConstantFunction::execute (CallingContext&) const
     {
-      return std::make_shared<FlowControl>(token, FlowControl::RETURN, FlowControl::NO_TARGET, function());
+      return FlowControl(token, FlowControl::RETURN, FlowControl::NO_TARGET, function());
     }
 
 
@@ -634,9 +796,9 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> StandardConstantFunctionWithContext::execute (CallingContext& context) const
+   FlowControl StandardConstantFunctionWithContext::execute (CallingContext& context) const
     {
-      return std::make_shared<FlowControl>(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(context));
+      return FlowControl(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(context));
     }
 
 
@@ -644,12 +806,12 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> StandardUnaryFunction::execute (CallingContext& context) const
+   FlowControl StandardUnaryFunction::execute (CallingContext& context) const
     {
       std::shared_ptr<Types::ValueType> arg = context.currentFrame->args[0U];
       try
        {
-         return std::make_shared<FlowControl>(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(arg));
+         return FlowControl(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(arg));
        }
       catch (const Types::TypedOperationException& e)
        {
@@ -666,12 +828,12 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> StandardUnaryFunctionWithContext::execute (CallingContext& context) const
+   FlowControl StandardUnaryFunctionWithContext::execute (CallingContext& context) const
     {
       std::shared_ptr<Types::ValueType> arg = context.currentFrame->args[0U];
       try
        {
-         return std::make_shared<FlowControl>(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(context, arg));
+         return FlowControl(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(context, arg));
        }
       catch (const Types::TypedOperationException& e)
        {
@@ -688,13 +850,13 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> StandardBinaryFunction::execute (CallingContext& context) const
+   FlowControl StandardBinaryFunction::execute (CallingContext& context) const
     {
       std::shared_ptr<Types::ValueType> lhs = context.currentFrame->args[0U];
       std::shared_ptr<Types::ValueType> rhs = context.currentFrame->args[1U];
       try
        {
-         return std::make_shared<FlowControl>(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(lhs, rhs));
+         return FlowControl(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(lhs, rhs));
        }
       catch (const Types::TypedOperationException& e)
        {
@@ -711,14 +873,14 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> StandardTernaryFunction::execute (CallingContext& context) const
+   FlowControl StandardTernaryFunction::execute (CallingContext& context) const
     {
       std::shared_ptr<Types::ValueType> first = context.currentFrame->args[0U];
       std::shared_ptr<Types::ValueType> second = context.currentFrame->args[1U];
       std::shared_ptr<Types::ValueType> third = context.currentFrame->args[2U];
       try
        {
-         return std::make_shared<FlowControl>(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(first, second, third));
+         return FlowControl(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(first, second, third));
        }
       catch (const Types::TypedOperationException& e)
        {
@@ -57,6 +57,60 @@ namespace Backwards
 namespace Engine
  {
 
+    // Containers are treated as immutable, so a modification constructs a new container.
+    // The exception is a container that nobody else can see: that one can be changed in place.
+    // The shared empty containers are never changed, even if the ConstantsSingleton has let go of them.
+   static bool isUnique (const std::shared_ptr<Types::ValueType>& container)
+    {
+      return (1 == container.use_count()) &&
+         (ConstantsSingleton::getInstance().EMPTY_ARRAY.get() != container.get()) &&
+         (ConstantsSingleton::getInstance().EMPTY_DICTIONARY.get() != container.get());
+    }
+
+   static std::shared_ptr<Types::ArrayValue> editArray (std::shared_ptr<Types::ValueType>&& container)
+    {
+      if (true == isUnique(container))
+       {
+         return std::static_pointer_cast<Types::ArrayValue>(std::move(container));
+       }
+      std::shared_ptr<Types::ArrayValue> result = std::make_shared<Types::ArrayValue>();
+      result->value = static_cast<const Types::ArrayValue&>(*container).value;
+      return result;
+    }
+
+   static std::shared_ptr<Types::DictionaryValue> editDictionary (std::shared_ptr<Types::ValueType>&& container)
+    {
+      if (true == isUnique(container))
+       {
+         return std::static_pointer_cast<Types::DictionaryValue>(std::move(container));
+       }
+      std::shared_ptr<Types::DictionaryValue> result = std::make_shared<Types::DictionaryValue>();
+      result->value = static_cast<const Types::DictionaryValue&>(*container).value;
+      return result;
+    }
+
+    // Indices are truncated toward zero, and must be less than limit. Integers, the usual case, don't go through double.
+   static bool toIndex (const SlowFloat::SlowFloat& arg, size_t limit, size_t& result)
+    {
+      int64_t index;
+      if (true == SlowFloat::toInt64(arg, index))
+       {
+         if ((index < 0) || (static_cast<uint64_t>(index) >= limit))
+          {
+            return false;
+          }
+         result = static_cast<size_t>(index);
+         return true;
+       }
+      double value = static_cast<double>(arg);
+      if ((value >= 0.0) && (value < static_cast<double>(limit)))
+       {
+         result = static_cast<size_t>(value);
+         return true;
+       }
+      return false;
+    }
+
    //////////
    // Expression and Statement are built on these first 7 functions.
    //////////
@@ -73,12 +127,14 @@ namespace Engine
 
    STDLIB_BINARY_DECL(PushBack)
     {
-      if (typeid(Types::ArrayValue) == typeid(*first))
+      return PushBackInPlace(std::shared_ptr<Types::ValueType>(first), second);
+    }
+
+   STDLIB_BINARY_INPLACE_DECL(PushBack)
+    {
+      if (Types::ValueType::ARRAY == first->getType())
        {
-         // Yes, construct a new container on modification.
-         // All operations treat ValueTypes as immutable, so this is safe.
-         std::shared_ptr<Types::ArrayValue> result = std::make_shared<Types::ArrayValue>();
-         result->value = static_cast<const Types::ArrayValue&>(*first).value;
+         std::shared_ptr<Types::ArrayValue> result = editArray(std::move(first));
          result->value.push_back(second);
          return result;
        }
@@ -90,12 +146,15 @@ namespace Engine
 
    STDLIB_TERNARY_DECL(Insert)
     {
-      if (typeid(Types::DictionaryValue) == typeid(*first))
+      return InsertInPlace(std::shared_ptr<Types::ValueType>(first), second, third);
+    }
+
+   STDLIB_TERNARY_INPLACE_DECL(Insert)
+    {
+      if (Types::ValueType::DICTIONARY == first->getType())
        {
-         // Yes, construct a new container on modification.
-         std::shared_ptr<Types::DictionaryValue> result = std::make_shared<Types::DictionaryValue>();
-         result->value = static_cast<const Types::DictionaryValue&>(*first).value;
-         result->value[second] = third;
+         std::shared_ptr<Types::DictionaryValue> result = editDictionary(std::move(first));
+         result->value.set(second, third);
          return result;
        }
       else
@@ -106,13 +165,12 @@ namespace Engine
 
    STDLIB_BINARY_DECL(GetValue)
     {
-      if (typeid(Types::DictionaryValue) == typeid(*first))
+      if (Types::ValueType::DICTIONARY == first->getType())
        {
-         std::map<std::shared_ptr<Types::ValueType>, std::shared_ptr<Types::ValueType>, Types::ChristHowHorrifying>::const_iterator iter =
-            static_cast<const Types::DictionaryValue&>(*first).value.find(second);
-         if (static_cast<const Types::DictionaryValue&>(*first).value.end() != iter)
+         const std::shared_ptr<Types::ValueType>* found = static_cast<const Types::DictionaryValue&>(*first).value.find(second);
+         if (nullptr != found)
           {
-            return iter->second;
+            return *found;
           }
          else
           {
@@ -127,14 +185,19 @@ namespace Engine
 
    STDLIB_BINARY_DECL(GetIndex)
     {
-      if (typeid(Types::ArrayValue) == typeid(*first))
+      return GetElement(first, second);
+    }
+
+   Types::Value GetElement (const Types::Value& first, const Types::Value& second)
+    {
+      if (Types::ValueType::ARRAY == first->getType())
        {
-         if (typeid(Types::FloatValue) == typeid(*second))
+         if (Types::ValueType::FLOAT == second->getType())
           {
-            double index = static_cast<double>(static_cast<const Types::FloatValue&>(*second).value);
-            if ((index >= 0.0) && (index < static_cast<double>(static_cast<const Types::ArrayValue&>(*first).value.size())))
+            size_t index;
+            if (true == toIndex(static_cast<const Types::FloatValue&>(*second).value, static_cast<const Types::ArrayValue&>(*first).value.size(), index))
              {
-               return static_cast<const Types::ArrayValue&>(*first).value[static_cast<size_t>(index)];
+               return static_cast<const Types::ArrayValue&>(*first).value.element(index);
              }
             else
              {
@@ -154,17 +217,20 @@ namespace Engine
 
    STDLIB_TERNARY_DECL(SetIndex)
     {
-      if (typeid(Types::ArrayValue) == typeid(*first))
+      return SetIndexInPlace(std::shared_ptr<Types::ValueType>(first), second, third);
+    }
+
+   STDLIB_TERNARY_INPLACE_DECL(SetIndex)
+    {
+      if (Types::ValueType::ARRAY == first->getType())
        {
-         if (typeid(Types::FloatValue) == typeid(*second))
+         if (Types::ValueType::FLOAT == second->getType())
           {
-            double index = static_cast<double>(static_cast<const Types::FloatValue&>(*second).value);
-            if ((index >= 0.0) && (index < static_cast<double>(static_cast<const Types::ArrayValue&>(*first).value.size())))
+            size_t index;
+            if (true == toIndex(static_cast<const Types::FloatValue&>(*second).value, static_cast<const Types::ArrayValue&>(*first).value.size(), index))
              {
-               // Yes, construct a new container on modification.
-               std::shared_ptr<Types::ArrayValue> result = std::make_shared<Types::ArrayValue>();
-               result->value = static_cast<const Types::ArrayValue&>(*first).value;
-               result->value[static_cast<size_t>(index)] = third;
+               std::shared_ptr<Types::ArrayValue> result = editArray(std::move(first));
+               result->value.set(index, third);
                return result;
              }
             else
@@ -190,9 +256,9 @@ namespace Engine
 #define LOGGINGFUNCTIONDEFN(x,y) \
    STDLIB_UNARY_DECL_WITH_CONTEXT(x) \
     { \
-      if (typeid(Types::StringValue) == typeid(*arg)) \
+      if (Types::ValueType::STRING == arg->getType()) \
        { \
-         context.logger->log(y + static_cast<const Types::StringValue&>(*arg).value); \
+         context.logger->log(y + static_cast<const Types::StringValue&>(*arg).value.str()); \
          return arg; \
        } \
       else \
@@ -207,9 +273,9 @@ namespace Engine
 
    STDLIB_UNARY_DECL_WITH_CONTEXT(Fatal)
     {
-      if (typeid(Types::StringValue) == typeid(*arg))
+      if (Types::ValueType::STRING == arg->getType())
        {
-         context.logger->log("FATAL: " + static_cast<const Types::StringValue&>(*arg).value);
+         context.logger->log("FATAL: " + static_cast<const Types::StringValue&>(*arg).value.str());
          throw FatalException(static_cast<const Types::StringValue&>(*arg).value);
        }
       else
@@ -220,7 +286,7 @@ namespace Engine
 
    STDLIB_UNARY_DECL(ToString)
     {
-      if (typeid(Types::FloatValue) == typeid(*arg))
+      if (Types::ValueType::FLOAT == arg->getType())
        {
          return std::make_shared<Types::StringValue>(SlowFloat::toString(static_cast<const Types::FloatValue&>(*arg).value));
        }
@@ -236,12 +302,15 @@ namespace Engine
 
    STDLIB_BINARY_DECL(PushFront)
     {
-      if (typeid(Types::ArrayValue) == typeid(*first))
+      return PushFrontInPlace(std::shared_ptr<Types::ValueType>(first), second);
+    }
+
+   STDLIB_BINARY_INPLACE_DECL(PushFront)
+    {
+      if (Types::ValueType::ARRAY == first->getType())
        {
-         std::shared_ptr<Types::ArrayValue> result = std::make_shared<Types::ArrayValue>();
-         result->value.push_back(second);
-         const std::vector<std::shared_ptr<Types::ValueType> >& source = static_cast<const Types::ArrayValue&>(*first).value;
-         result->value.insert(result->value.end(), source.begin(), source.end());
+         std::shared_ptr<Types::ArrayValue> result = editArray(std::move(first));
+         result->value.push_front(second);
          return result;
        }
       else
@@ -252,12 +321,16 @@ namespace Engine
 
    STDLIB_UNARY_DECL(PopBack)
     {
-      if (typeid(Types::ArrayValue) == typeid(*arg))
+      return PopBackInPlace(std::shared_ptr<Types::ValueType>(arg));
+    }
+
+   STDLIB_UNARY_INPLACE_DECL(PopBack)
+    {
+      if (Types::ValueType::ARRAY == arg->getType())
        {
          if (false == static_cast<const Types::ArrayValue&>(*arg).value.empty())
           {
-            std::shared_ptr<Types::ArrayValue> result = std::make_shared<Types::ArrayValue>();
-            result->value = static_cast<const Types::ArrayValue&>(*arg).value;
+            std::shared_ptr<Types::ArrayValue> result = editArray(std::move(arg));
             result->value.pop_back();
             return result;
           }
@@ -274,13 +347,17 @@ namespace Engine
 
    STDLIB_UNARY_DECL(PopFront)
     {
-      if (typeid(Types::ArrayValue) == typeid(*arg))
+      return PopFrontInPlace(std::shared_ptr<Types::ValueType>(arg));
+    }
+
+   STDLIB_UNARY_INPLACE_DECL(PopFront)
+    {
+      if (Types::ValueType::ARRAY == arg->getType())
        {
          if (false == static_cast<const Types::ArrayValue&>(*arg).value.empty())
           {
-            std::shared_ptr<Types::ArrayValue> result = std::make_shared<Types::ArrayValue>();
-            const std::vector<std::shared_ptr<Types::ValueType> >& source = static_cast<const Types::ArrayValue&>(*arg).value;
-            result->value.assign(source.begin() + 1, source.end());
+            std::shared_ptr<Types::ArrayValue> result = editArray(std::move(arg));
+            result->value.pop_front();
             return result;
           }
          else
@@ -297,7 +374,7 @@ namespace Engine
 #define RTTIFUNCTIONDEFN(x,y) \
    STDLIB_UNARY_DECL(x) \
     { \
-      if (typeid(y) == typeid(*arg)) \
+      if (Types::ValueType::y == arg->getType()) \
        { \
          return ConstantsSingleton::getInstance().FLOAT_ONE; \
        } \
@@ -307,17 +384,17 @@ namespace Engine
        } \
     }
 
-   RTTIFUNCTIONDEFN(IsFloat, Types::FloatValue)
-   RTTIFUNCTIONDEFN(IsString, Types::StringValue)
-   RTTIFUNCTIONDEFN(IsArray, Types::ArrayValue)
-   RTTIFUNCTIONDEFN(IsDictionary, Types::DictionaryValue)
-   RTTIFUNCTIONDEFN(IsFunction, Types::FunctionValue)
+   RTTIFUNCTIONDEFN(IsFloat, FLOAT)
+   RTTIFUNCTIONDEFN(IsString, STRING)
+   RTTIFUNCTIONDEFN(IsArray, ARRAY)
+   RTTIFUNCTIONDEFN(IsDictionary, DICTIONARY)
+   RTTIFUNCTIONDEFN(IsFunction, FUNCTION)
 
    STDLIB_UNARY_DECL(Length)
     {
-      if (typeid(Types::StringValue) == typeid(*arg))
+      if (Types::ValueType::STRING == arg->getType())
        {
-         return std::make_shared<Types::FloatValue>(SlowFloat::SlowFloat(static_cast<double>(static_cast<const Types::StringValue&>(*arg).value.size())));
+         return std::make_shared<Types::FloatValue>(SlowFloat::fromInt64(static_cast<int64_t>(static_cast<const Types::StringValue&>(*arg).value.size())));
        }
       else
        {
@@ -327,13 +404,13 @@ namespace Engine
 
    STDLIB_UNARY_DECL(Size)
     {
-      if (typeid(Types::ArrayValue) == typeid(*arg))
+      if (Types::ValueType::ARRAY == arg->getType())
        {
-         return std::make_shared<Types::FloatValue>(SlowFloat::SlowFloat(static_cast<double>(static_cast<const Types::ArrayValue&>(*arg).value.size())));
+         return std::make_shared<Types::FloatValue>(SlowFloat::fromInt64(static_cast<int64_t>(static_cast<const Types::ArrayValue&>(*arg).value.size())));
        }
-      else if (typeid(Types::DictionaryValue) == typeid(*arg))
+      else if (Types::ValueType::DICTIONARY == arg->getType())
        {
-         return std::make_shared<Types::FloatValue>(SlowFloat::SlowFloat(static_cast<double>(static_cast<const Types::DictionaryValue&>(*arg).value.size())));
+         return std::make_shared<Types::FloatValue>(SlowFloat::fromInt64(static_cast<int64_t>(static_cast<const Types::DictionaryValue&>(*arg).value.size())));
        }
       else
        {
@@ -343,13 +420,17 @@ namespace Engine
 
    STDLIB_BINARY_DECL(NewArrayDefault)
     {
-      if (typeid(Types::FloatValue) == typeid(*first))
+      if (Types::ValueType::FLOAT == first->getType())
        {
-         double size = static_cast<double>(static_cast<const Types::FloatValue&>(*first).value);
-         if ((size >= 0.0) && (size < static_cast<double>(std::numeric_limits<size_t>::max())))
+         size_t size;
+         if (true == toIndex(static_cast<const Types::FloatValue&>(*first).value, std::numeric_limits<size_t>::max(), size))
           {
             std::shared_ptr<Types::ArrayValue> result = std::make_shared<Types::ArrayValue>();
-            result->value.resize(static_cast<size_t>(size), second);
+            Types::Value element (second);
+            for (size_t i = 0U; i < size; ++i)
+             {
+               result->value.push_back(element);
+             }
             return result;
           }
          else
@@ -365,13 +446,24 @@ namespace Engine
 
    STDLIB_TERNARY_DECL(SubString)
     {
-      if (typeid(Types::StringValue) == typeid(*first))
+      if (Types::ValueType::STRING == first->getType())
        {
-         if (typeid(Types::FloatValue) == typeid(*second))
+         if (Types::ValueType::FLOAT == second->getType())
           {
-            if (typeid(Types::FloatValue) == typeid(*third))
+            if (Types::ValueType::FLOAT == third->getType())
              {
-               double stringLength = static_cast<double>(static_cast<const Types::StringValue&>(*first).value.length());
+               const Types::StringContents& source = static_cast<const Types::StringValue&>(*first).value;
+               int64_t start, end;
+               if ((true == SlowFloat::toInt64(static_cast<const Types::FloatValue&>(*second).value, start)) &&
+                  (true == SlowFloat::toInt64(static_cast<const Types::FloatValue&>(*third).value, end)) &&
+                  (start >= 0) && (end >= start) && (static_cast<uint64_t>(end) <= source.length()))
+                {
+                  std::shared_ptr<Types::StringValue> result = std::make_shared<Types::StringValue>();
+                  result->value = source.substr(static_cast<size_t>(start), static_cast<size_t>(end - start));
+                  return result;
+                }
+                // Fractional positions go through double, and are truncated.
+               double stringLength = static_cast<double>(source.length());
                double startIndex = static_cast<double>(static_cast<const Types::FloatValue&>(*second).value);
                double endIndex = static_cast<double>(static_cast<const Types::FloatValue&>(*third).value);
                if ((startIndex >= 0.0) && (startIndex <= stringLength) &&
@@ -379,7 +471,7 @@ namespace Engine
                   (endIndex >= startIndex))
                 {
                   std::shared_ptr<Types::StringValue> result = std::make_shared<Types::StringValue>();
-                  result->value = static_cast<const Types::StringValue&>(*first).value.substr(static_cast<size_t>(startIndex), static_cast<size_t>(endIndex - startIndex));
+                  result->value = source.substr(static_cast<size_t>(startIndex), static_cast<size_t>(endIndex - startIndex));
                   return result;
                 }
                else
@@ -405,11 +497,9 @@ namespace Engine
 
    STDLIB_BINARY_DECL(ContainsKey)
     {
-      if (typeid(Types::DictionaryValue) == typeid(*first))
+      if (Types::ValueType::DICTIONARY == first->getType())
        {
-         std::map<std::shared_ptr<Types::ValueType>, std::shared_ptr<Types::ValueType>, Types::ChristHowHorrifying>::const_iterator iter =
-            static_cast<const Types::DictionaryValue&>(*first).value.find(second);
-         if (static_cast<const Types::DictionaryValue&>(*first).value.end() != iter)
+         if (true == static_cast<const Types::DictionaryValue&>(*first).value.contains(second))
           {
             return ConstantsSingleton::getInstance().FLOAT_ONE;
           }
@@ -426,14 +516,16 @@ namespace Engine
 
    STDLIB_BINARY_DECL(RemoveKey)
     {
-      if (typeid(Types::DictionaryValue) == typeid(*first))
+      return RemoveKeyInPlace(std::shared_ptr<Types::ValueType>(first), second);
+    }
+
+   STDLIB_BINARY_INPLACE_DECL(RemoveKey)
+    {
+      if (Types::ValueType::DICTIONARY == first->getType())
        {
-         std::map<std::shared_ptr<Types::ValueType>, std::shared_ptr<Types::ValueType>, Types::ChristHowHorrifying>::const_iterator iter =
-            static_cast<const Types::DictionaryValue&>(*first).value.find(second);
-         if (static_cast<const Types::DictionaryValue&>(*first).value.end() != iter)
+         if (true == static_cast<const Types::DictionaryValue&>(*first).value.contains(second))
           {
-            std::shared_ptr<Types::DictionaryValue> result = std::make_shared<Types::DictionaryValue>();
-            result->value = static_cast<const Types::DictionaryValue&>(*first).value;
+            std::shared_ptr<Types::DictionaryValue> result = editDictionary(std::move(first));
             result->value.erase(second);
             return result;
           }
@@ -450,10 +542,10 @@ namespace Engine
 
    STDLIB_UNARY_DECL(GetKeys)
     {
-      if (typeid(Types::DictionaryValue) == typeid(*arg))
+      if (Types::ValueType::DICTIONARY == arg->getType())
        {
          std::shared_ptr<Types::ArrayValue> result = std::make_shared<Types::ArrayValue>();
-         for (std::map<std::shared_ptr<Types::ValueType>, std::shared_ptr<Types::ValueType>, Types::ChristHowHorrifying>::const_iterator iter =
+         for (Types::DictionaryMap::const_iterator iter =
             static_cast<const Types::DictionaryValue&>(*arg).value.begin();
             static_cast<const Types::DictionaryValue&>(*arg).value.end() != iter; ++iter)
           {
@@ -498,17 +590,14 @@ namespace Engine
       return std::make_shared<Types::StringValue>(str.str());
     }
 
-   static const double RTD = 180.0 / M_PI;
-   static const double DTR = M_PI / 180.0;
-
    STDLIB_BINARY_DECL(Atan2)
     {
-      if (typeid(Types::FloatValue) == typeid(*first))
+      if (Types::ValueType::FLOAT == first->getType())
        {
-         if (typeid(Types::FloatValue) == typeid(*second))
+         if (Types::ValueType::FLOAT == second->getType())
           {
-            return std::make_shared<Types::FloatValue>(SlowFloat::SlowFloat(std::atan2(
-               static_cast<double>(static_cast<const Types::FloatValue&>(*first).value), static_cast<double>(static_cast<const Types::FloatValue&>(*second).value)) * RTD));
+            return std::make_shared<Types::FloatValue>(SlowFloat::atan2d(
+               static_cast<const Types::FloatValue&>(*first).value, static_cast<const Types::FloatValue&>(*second).value));
           }
          else
           {
@@ -523,12 +612,12 @@ namespace Engine
 
    STDLIB_BINARY_DECL(Hypot)
     {
-      if (typeid(Types::FloatValue) == typeid(*first))
+      if (Types::ValueType::FLOAT == first->getType())
        {
-         if (typeid(Types::FloatValue) == typeid(*second))
+         if (Types::ValueType::FLOAT == second->getType())
           {
-            return std::make_shared<Types::FloatValue>(SlowFloat::SlowFloat(std::hypot(
-               static_cast<double>(static_cast<const Types::FloatValue&>(*first).value), static_cast<double>(static_cast<const Types::FloatValue&>(*second).value))));
+            return std::make_shared<Types::FloatValue>(SlowFloat::hypot(
+               static_cast<const Types::FloatValue&>(*first).value, static_cast<const Types::FloatValue&>(*second).value));
           }
          else
           {
@@ -543,12 +632,12 @@ namespace Engine
 
    STDLIB_BINARY_DECL(Log)
     {
-      if (typeid(Types::FloatValue) == typeid(*first))
+      if (Types::ValueType::FLOAT == first->getType())
        {
-         if (typeid(Types::FloatValue) == typeid(*second))
+         if (Types::ValueType::FLOAT == second->getType())
           {
-            return std::make_shared<Types::FloatValue>(SlowFloat::SlowFloat(std::log(static_cast<double>(static_cast<const Types::FloatValue&>(*second).value)) /
-               std::log(static_cast<double>(static_cast<const Types::FloatValue&>(*first).value))));
+            return std::make_shared<Types::FloatValue>(SlowFloat::log(
+               static_cast<const Types::FloatValue&>(*first).value, static_cast<const Types::FloatValue&>(*second).value));
           }
          else
           {
@@ -564,9 +653,9 @@ namespace Engine
 #define MINMAXDEFN(x,y,z) \
    STDLIB_BINARY_DECL(x) \
     { \
-      if (typeid(Types::FloatValue) == typeid(*first)) \
+      if (Types::ValueType::FLOAT == first->getType()) \
        { \
-         if (typeid(Types::FloatValue) == typeid(*second)) \
+         if (Types::ValueType::FLOAT == second->getType()) \
           { \
             double fVal = static_cast<double>(static_cast<const Types::FloatValue&>(*first).value); \
             double sVal = static_cast<double>(static_cast<const Types::FloatValue&>(*second).value); \
@@ -594,12 +683,12 @@ namespace Engine
    MINMAXDEFN(Max, >=, "max")
    MINMAXDEFN(Min, <=, "min")
 
-#define TRIGFUNCTIONDEFN(x,y,z) \
+#define NATIVEONEARGMATHDEFN(x,y,z) \
    STDLIB_UNARY_DECL(x) \
     { \
-      if (typeid(Types::FloatValue) == typeid(*arg)) \
+      if (Types::ValueType::FLOAT == arg->getType()) \
        { \
-         return std::make_shared<Types::FloatValue>(SlowFloat::SlowFloat(std::y(static_cast<double>(static_cast<const Types::FloatValue&>(*arg).value) * DTR))); \
+         return std::make_shared<Types::FloatValue>(SlowFloat::y(static_cast<const Types::FloatValue&>(*arg).value)); \
        } \
       else \
        { \
@@ -607,31 +696,23 @@ namespace Engine
        } \
     }
 
-   TRIGFUNCTIONDEFN(Sin, sin, "sine")
-   TRIGFUNCTIONDEFN(Cos, cos, "cosine")
-   TRIGFUNCTIONDEFN(Tan, tan, "tangent")
-
-#define INVTRIGFUNCTIONDEFN(x,y,z) \
-   STDLIB_UNARY_DECL(x) \
-    { \
-      if (typeid(Types::FloatValue) == typeid(*arg)) \
-       { \
-         return std::make_shared<Types::FloatValue>(SlowFloat::SlowFloat(std::y(static_cast<double>(static_cast<const Types::FloatValue&>(*arg).value)) * RTD)); \
-       } \
-      else \
-       { \
-         throw Types::TypedOperationException("Error trying to compute " z " of non-Float."); \
-       } \
-    }
-
-   INVTRIGFUNCTIONDEFN(Asin, asin, "arcsine")
-   INVTRIGFUNCTIONDEFN(Acos, acos, "arccosine")
-   INVTRIGFUNCTIONDEFN(Atan, atan, "arctangent")
+   NATIVEONEARGMATHDEFN(Sin, sind, "sine")
+   NATIVEONEARGMATHDEFN(Cos, cosd, "cosine")
+   NATIVEONEARGMATHDEFN(Tan, tand, "tangent")
+   NATIVEONEARGMATHDEFN(Exp, exp, "exponential")
+   NATIVEONEARGMATHDEFN(Ln, log, "natural logarithm")
+   NATIVEONEARGMATHDEFN(Asin, asind, "arcsine")
+   NATIVEONEARGMATHDEFN(Acos, acosd, "arccosine")
+   NATIVEONEARGMATHDEFN(Atan, atand, "arctangent")
+   NATIVEONEARGMATHDEFN(Cbrt, cbrt, "cube root")
+   NATIVEONEARGMATHDEFN(Sinh, sinh, "hyperbolic sine")
+   NATIVEONEARGMATHDEFN(Cosh, cosh, "hyperbolic cosine")
+   NATIVEONEARGMATHDEFN(Tanh, tanh, "hyperbolic tangent")
 
 #define BASICONEARGMATHDEFN(x,y,z) \
    STDLIB_UNARY_DECL(x) \
     { \
-      if (typeid(Types::FloatValue) == typeid(*arg)) \
+      if (Types::ValueType::FLOAT == arg->getType()) \
        { \
          return std::make_shared<Types::FloatValue>(SlowFloat::SlowFloat(std::y(static_cast<double>(static_cast<const Types::FloatValue&>(*arg).value)))); \
        } \
@@ -641,10 +722,6 @@ namespace Engine
        } \
     }
 
-   BASICONEARGMATHDEFN(Exp, exp, "exponential")
-   BASICONEARGMATHDEFN(Ln, log, "natural logarithm")
-   BASICONEARGMATHDEFN(Sqrt, sqrt, "square root")
-   BASICONEARGMATHDEFN(Cbrt, cbrt, "cube root")
    BASICONEARGMATHDEFN(Abs, fabs, "absolute value")
    BASICONEARGMATHDEFN(Round, round, "rounded value")
    BASICONEARGMATHDEFN(Floor, floor, "rounded to negative infinity")
@@ -652,13 +729,22 @@ namespace Engine
    BASICONEARGMATHDEFN(IsInfinity, isinf, "is infinity")
     // Well, technically, I guess it SHOULD return true if the argument is not a Float....
    BASICONEARGMATHDEFN(IsNaN, isnan, "is special not-a-number value")
-   BASICONEARGMATHDEFN(Sinh, sinh, "hyperbolic sine")
-   BASICONEARGMATHDEFN(Cosh, cosh, "hyperbolic cosine")
-   BASICONEARGMATHDEFN(Tanh, tanh, "hyperbolic tangent")
+
+   STDLIB_UNARY_DECL(Sqrt)
+    {
+      if (Types::ValueType::FLOAT == arg->getType())
+       {
+         return std::make_shared<Types::FloatValue>(SlowFloat::sqrt(static_cast<const Types::FloatValue&>(*arg).value));
+       }
+      else
+       {
+         throw Types::TypedOperationException("Error trying to compute square root of non-Float.");
+       }
+    }
 
    STDLIB_UNARY_DECL(Sqr)
     {
-      if (typeid(Types::FloatValue) == typeid(*arg))
+      if (Types::ValueType::FLOAT == arg->getType())
        {
          SlowFloat::SlowFloat x = static_cast<const Types::FloatValue&>(*arg).value;
          return std::make_shared<Types::FloatValue>(x * x);
@@ -672,9 +758,9 @@ namespace Engine
 #define DTRRTDDEFN(x,y) \
    STDLIB_UNARY_DECL(x) \
     { \
-      if (typeid(Types::FloatValue) == typeid(*arg)) \
+      if (Types::ValueType::FLOAT == arg->getType()) \
        { \
-         return std::make_shared<Types::FloatValue>(SlowFloat::SlowFloat(static_cast<double>(static_cast<const Types::FloatValue&>(*arg).value) * y)); \
+         return std::make_shared<Types::FloatValue>(SlowFloat::y(static_cast<const Types::FloatValue&>(*arg).value)); \
        } \
       else \
        { \
@@ -682,12 +768,12 @@ namespace Engine
        } \
     }
 
-   DTRRTDDEFN(DegToRad, DTR)
-   DTRRTDDEFN(RadToDeg, RTD)
+   DTRRTDDEFN(DegToRad, degToRad)
+   DTRRTDDEFN(RadToDeg, radToDeg)
 
    STDLIB_UNARY_DECL(ValueOf)
     {
-      if (typeid(Types::StringValue) == typeid(*arg))
+      if (Types::ValueType::STRING == arg->getType())
        {
          std::stringstream str (static_cast<const Types::StringValue&>(*arg).value);
          double val;
@@ -709,7 +795,7 @@ namespace Engine
 
    STDLIB_UNARY_DECL(FromCharacter)
     {
-      if (typeid(Types::StringValue) == typeid(*arg))
+      if (Types::ValueType::STRING == arg->getType())
        {
          const std::string& str (static_cast<const Types::StringValue&>(*arg).value);
          if (1U == str.size())
@@ -729,7 +815,7 @@ namespace Engine
 
    STDLIB_UNARY_DECL(ToCharacter)
     {
-      if (typeid(Types::FloatValue) == typeid(*arg))
+      if (Types::ValueType::FLOAT == arg->getType())
        {
          double val = static_cast<double>(static_cast<const Types::FloatValue&>(*arg).value);
          if ((val > static_cast<double>(std::numeric_limits<char>::min())) &&
@@ -752,7 +838,7 @@ namespace Engine
 
    STDLIB_UNARY_DECL_WITH_CONTEXT(DebugPrint)
     {
-      if (typeid(Types::StringValue) == typeid(*arg))
+      if (Types::ValueType::STRING == arg->getType())
        {
          context.logger->log(static_cast<const Types::StringValue&>(*arg).value);
          return arg;
@@ -779,7 +865,7 @@ namespace Engine
 
    STDLIB_UNARY_DECL(SetRoundMode)
     {
-      if (typeid(Types::FloatValue) == typeid(*arg))
+      if (Types::ValueType::FLOAT == arg->getType())
        {
          double val = static_cast<double>(static_cast<const Types::FloatValue&>(*arg).value);
          if ((val >= static_cast<double>(SlowFloat::ROUND_TIES_EVEN)) &&
@@ -0,0 +1,111 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Backwards/Engine/ValueStack.h"
+
+namespace Backwards
+ {
+
+namespace Engine
+ {
+
+   ValueStack::ValueStack() : blocks(), sizes(), tops(), current(0U)
+    {
+    }
+
+   Types::Value* ValueStack::carve (size_t count)
+    {
+      if (0U == count)
+       {
+         return nullptr;
+       }
+      const size_t size = (count > BLOCK_SIZE) ? count : BLOCK_SIZE;
+      if (true == blocks.empty())
+       {
+         blocks.emplace_back(new Types::Value[size]);
+         sizes.push_back(size);
+         tops.push_back(0U);
+       }
+      if (tops[current] + count > sizes[current])
+       {
+          // Only move on from a block that is in use: an empty one that is too small is simply replaced.
+         if (0U != tops[current])
+          {
+            ++current;
+          }
+         if (blocks.size() == current)
+          {
+            blocks.emplace_back();
+            sizes.push_back(0U);
+            tops.push_back(0U);
+          }
+         if (sizes[current] < count)
+          {
+            blocks[current].reset(new Types::Value[size]);
+            sizes[current] = size;
+          }
+       }
+      Types::Value* result = blocks[current].get() + tops[current];
+      tops[current] += count;
+      return result;
+    }
+
+   void ValueStack::release (Types::Value* base, size_t count)
+    {
+      if (0U == count)
+       {
+         return;
+       }
+       // Drop the references now, so that nothing is kept alive by a dead frame.
+      for (size_t i = 0U; i < count; ++i)
+       {
+         base[i] = Types::Value();
+       }
+      tops[current] -= count;
+      if ((0U == tops[current]) && (0U != current))
+       {
+         --current;
+       }
+    }
+
+   size_t ValueStack::inUse() const
+    {
+      size_t result = 0U;
+      for (size_t i = 0U; i < tops.size(); ++i)
+       {
+         result += tops[i];
+       }
+      return result;
+    }
+
+ } // namespace Engine
+
+ } // namespace Backwards
@@ -0,0 +1,507 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Backwards/Engine/VirtualMachine.h"
+#include "Backwards/Engine/Bytecode.h"
+#include "Backwards/Engine/Statement.h"
+#include "Backwards/Engine/Expression.h"
+#include "Backwards/Engine/StdLib.h"
+#include "Backwards/Engine/StackFrame.h"
+#include "Backwards/Engine/FunctionContext.h"
+#include "Backwards/Engine/FatalException.h"
+#include "Backwards/Engine/ConstantsSingleton.h"
+#include "Backwards/Engine/DebuggerHook.h"
+#include "Backwards/Engine/Profiler.h"
+
+#include "Backwards/Types/ArrayValue.h"
+#include "Backwards/Types/DictionaryValue.h"
+#include "Backwards/Types/FunctionValue.h"
+
+#include <atomic>
+#include <sstream>
+
+namespace Backwards
+ {
+
+namespace Engine
+ {
+
+    // The state of a for-in loop over a collection.
+   class CollectionCursor final
+    {
+   public:
+      std::shared_ptr<Types::ValueType> collection;
+      const Types::ArrayValue* array;
+      const Types::DictionaryValue* dictionary;
+      size_t index;
+      Types::DictionaryMap::const_iterator iter;
+
+      CollectionCursor() : array(nullptr), dictionary(nullptr), index(0U) { }
+    };
+
+    // The integer shadow of a numeric for loop's counter, as in ForStatement::numericIter.
+   class LoopCounter final
+    {
+   public:
+      int64_t count;
+      int64_t stride;
+      bool integral;
+
+      LoopCounter() : count(0), stride(0), integral(false) { }
+    };
+
+   static std::shared_ptr<FunctionContext> resolveFunction(const Types::FunctionValue& value)
+    {
+       // Every FunctionValue the engine makes holds a FunctionContext. Only recursive references are weak.
+      if (nullptr != value.value.get())
+       {
+         return std::static_pointer_cast<FunctionContext>(value.value);
+       }
+      return std::static_pointer_cast<FunctionContext>(value.valueToo.lock());
+    }
+
+   static Types::Value callFunction (const Types::FunctionValue& value, const Types::Value* args, size_t nargs, const Input::Token& token, CallingContext& context)
+    {
+      std::shared_ptr<FunctionContext> function = resolveFunction(value);
+      StackFrame frame (context, function, token, value.captures);
+      for (size_t i = 0U; i < nargs; ++i)
+       {
+         frame.args[i] = args[i];
+       }
+      context.pushContext(&frame);
+      try
+       {
+         FlowControl result = VirtualMachine::Invoke(*function, context);
+         Types::Value callee; // The function of the last tail call, whose captures the frame uses.
+         while (FlowControl::TAIL_CALL == result.type)
+          {
+            callee = result.value;
+            frame.retarget(context, static_cast<const Types::FunctionValue&>(*callee));
+            result = VirtualMachine::Invoke(*frame.function, context);
+          }
+         if (FlowControl::NONE == result.type)
+          {
+            std::stringstream str;
+            str << "Function failed to return a value at " << token.lineLocation << " on line " << token.lineNumber << " in file " << token.sourceFile;
+            throw FatalException(str.str());
+          }
+         if (FlowControl::RETURN != result.type)
+          {
+            std::stringstream str;
+            str << "Function had a 'break' or 'continue' outside of a loop at " << token.lineLocation << " on line " << token.lineNumber << " in file " << token.sourceFile;
+            if (nullptr != context.debugger)
+             {
+               context.debugger->EnterDebugger(str.str(), context);
+             }
+            throw FatalException(str.str());
+          }
+         context.popContext();
+         return result.value;
+       }
+      catch (...)
+       {
+         context.popContext();
+         throw;
+       }
+    }
+
+   FlowControl VirtualMachine::Execute (const Statement& source, CallingContext& context)
+    {
+      std::shared_ptr<Chunk> chunk = Compiler::Compile(source);
+      if (nullptr != chunk->native)
+       {
+         return chunk->native->execute(context);
+       }
+      return Run(*chunk, context);
+    }
+
+   FlowControl VirtualMachine::Invoke (FunctionContext& function, CallingContext& context)
+    {
+       // Functions may be shared by interpreters on other threads: two may race to compile, but either result is good.
+      std::shared_ptr<Chunk> chunk = std::atomic_load(&function.compiled);
+      if (nullptr == chunk.get())
+       {
+         chunk = Compiler::Compile(*function.function);
+         std::atomic_store(&function.compiled, chunk);
+       }
+      if (nullptr != chunk->native)
+       {
+         return chunk->native->execute(context);
+       }
+      return Run(*chunk, context);
+    }
+
+#define ARITHMETIC(x,y) \
+         case Instruction::x: \
+            registers[instruction.a] = registers[instruction.b]->y(*registers[instruction.c]); \
+            break;
+
+#define RELATIONAL(x,y) \
+         case Instruction::x: \
+            registers[instruction.a] = (true == registers[instruction.b]->y(*registers[instruction.c])) ? constants.FLOAT_ONE : constants.FLOAT_ZERO; \
+            break;
+
+   FlowControl VirtualMachine::Run (const Chunk& chunk, CallingContext& context)
+    {
+      const ConstantsSingleton& constants = ConstantsSingleton::getInstance();
+      FrameValues registers (context.values, chunk.registers);
+      std::vector<CollectionCursor> cursors (chunk.iterators);
+      std::vector<LoopCounter> counters (chunk.counters);
+      Profiler* const profiler = context.profiler;
+      const size_t end = chunk.code.size();
+      size_t pc = 0U;
+      size_t current = 0U;
+      try
+       {
+         while (pc < end)
+          {
+            current = pc;
+            ++pc;
+            const Instruction& instruction = chunk.code[current];
+            if ((nullptr != profiler) && (Chunk::NO_LINE != chunk.lines[current]))
+             {
+               profiler->line(*chunk.tokens[chunk.lines[current]]);
+             }
+            switch (instruction.op)
+             {
+            case Instruction::LOADK:
+               registers[instruction.a] = chunk.constants[instruction.b];
+               break;
+
+            case Instruction::GET:
+               registers[instruction.a] = chunk.getters[instruction.b]->get(context);
+               break;
+
+            case Instruction::VAR:
+               registers[instruction.a] = static_cast<const Variable&>(*chunk.expressions[instruction.b]).evaluate(context);
+               break;
+
+            case Instruction::SET:
+               chunk.setters[instruction.a]->set(context, registers[instruction.b]);
+               break;
+
+            ARITHMETIC(ADD, add)
+            ARITHMETIC(SUB, sub)
+            ARITHMETIC(MUL, mul)
+            ARITHMETIC(DIV, div)
+            ARITHMETIC(POW, power)
+
+            RELATIONAL(EQ, equal)
+            RELATIONAL(NE, notEqual)
+            RELATIONAL(GT, greater)
+            RELATIONAL(LT, less)
+            RELATIONAL(GE, geq)
+            RELATIONAL(LE, leq)
+
+            case Instruction::NOT:
+               registers[instruction.a] = (true == registers[instruction.b]->logical()) ? constants.FLOAT_ZERO : constants.FLOAT_ONE;
+               break;
+
+            case Instruction::NEG:
+               registers[instruction.a] = registers[instruction.b]->neg();
+               break;
+
+            case Instruction::INDEX:
+             {
+               const Types::Value& container = registers[instruction.b];
+               if (Types::ValueType::ARRAY == container->getType())
+                {
+                  registers[instruction.a] = GetElement(container, registers[instruction.c]);
+                }
+               else if (Types::ValueType::DICTIONARY == container->getType())
+                {
+                  registers[instruction.a] = GetValue(container, registers[instruction.c]);
+                }
+               else
+                {
+                  throw Types::TypedOperationException("Error indexing non-Collection.");
+                }
+             }
+               break;
+
+            case Instruction::STORE:
+               Assignment::store(context, *chunk.setters[instruction.a], &registers[instruction.b], &registers[instruction.b + instruction.c],
+                  instruction.c, registers[instruction.b + 2U * instruction.c]);
+               break;
+
+            case Instruction::JMP:
+               pc = instruction.a;
+               break;
+
+            case Instruction::JMPF:
+               if (false == registers[instruction.a]->logical())
+                {
+                  pc = instruction.b;
+                }
+               break;
+
+            case Instruction::JMPT:
+               if (true == registers[instruction.a]->logical())
+                {
+                  pc = instruction.b;
+                }
+               break;
+
+            case Instruction::CHECK:
+             {
+               const Input::Token& token = *chunk.tokens[instruction.token];
+               if (Types::ValueType::FUNCTION != registers[instruction.a]->getType())
+                {
+                  std::stringstream str;
+                  str << "Call to not a Function at " << token.lineLocation << " on line " << token.lineNumber << " in file " << token.sourceFile;
+                  if (nullptr != context.debugger)
+                   {
+                     context.debugger->EnterDebugger(str.str(), context);
+                   }
+                  throw FatalException(str.str());
+                }
+               std::shared_ptr<FunctionContext> function = resolveFunction(static_cast<const Types::FunctionValue&>(*registers[instruction.a]));
+               if (instruction.b != function->nargs)
+                {
+                  std::stringstream str;
+                  str << "Call to function with " << instruction.b << " arguments, but function takes " << function->nargs <<
+                     " arguments at " << token.lineLocation << " on line " << token.lineNumber << " in file " << token.sourceFile;
+                  if (nullptr != context.debugger)
+                   {
+                     context.debugger->EnterDebugger(str.str(), context);
+                   }
+                  throw FatalException(str.str());
+                }
+             }
+               break;
+
+            case Instruction::CALL:
+               registers[instruction.a] = callFunction(static_cast<const Types::FunctionValue&>(*registers[instruction.b]),
+                  registers.begin() + instruction.b + 1U, instruction.c, *chunk.tokens[instruction.token], context);
+               break;
+
+            case Instruction::NATIVE:
+             {
+               const NativeCall& node = static_cast<const NativeCall&>(*chunk.expressions[instruction.c]);
+               if (registers[instruction.b].get() != node.expected.get())
+                {
+                  registers[instruction.a] = callFunction(static_cast<const Types::FunctionValue&>(*registers[instruction.b]),
+                     registers.begin() + instruction.b + 1U, node.call->args.size(), *chunk.tokens[instruction.token], context);
+                }
+               else
+                {
+                  try
+                   {
+                     registers[instruction.a] = node.apply(registers.begin() + instruction.b + 1U);
+                   }
+                  catch (const Types::TypedOperationException& e)
+                   {
+                      // The Region appends the location, as it does for a CALL.
+                     if (nullptr != context.debugger)
+                      {
+                        context.debugger->EnterDebugger(e.what(), context);
+                      }
+                     throw;
+                   }
+                }
+             }
+               break;
+
+            case Instruction::BUILD:
+             {
+               const BuildFunction& node = static_cast<const BuildFunction&>(*chunk.expressions[instruction.b]);
+               std::vector<std::shared_ptr<Types::ValueType> > captured (registers.begin() + instruction.c, registers.begin() + instruction.c + node.captures.size());
+               if (true == node.prototypeToo.expired())
+                {
+                  registers[instruction.a] = std::make_shared<Types::FunctionValue>(node.prototype, captured);
+                }
+               else
+                {
+                  registers[instruction.a] = std::make_shared<Types::FunctionValue>(captured, node.prototypeToo);
+                }
+             }
+               break;
+
+            case Instruction::EVAL:
+               registers[instruction.a] = chunk.expressions[instruction.b]->evaluate(context);
+               break;
+
+            case Instruction::EXEC:
+             {
+               FlowControl result = chunk.statements[instruction.a]->execute(context);
+               if (FlowControl::NONE != result.type)
+                {
+                  if ((FlowControl::RETURN == result.type) || (FlowControl::TAIL_CALL == result.type))
+                   {
+                     return result;
+                   }
+                  bool found = false;
+                  for (const Loop& loop : chunk.loops)
+                   {
+                     if (result.target == loop.id)
+                      {
+                        pc = (FlowControl::BREAK == result.type) ? loop.breakTarget : loop.continueTarget;
+                        found = true;
+                        break;
+                      }
+                   }
+                  if (false == found)
+                   {
+                     return result; // Not for me, pass it up.
+                   }
+                }
+             }
+               break;
+
+            case Instruction::ITERPREP:
+             {
+               CollectionCursor& cursor = cursors[instruction.a];
+               cursor.collection = registers[instruction.b];
+               cursor.array = nullptr;
+               cursor.dictionary = nullptr;
+               cursor.index = 0U;
+               if (Types::ValueType::ARRAY == cursor.collection->getType())
+                {
+                  cursor.array = static_cast<const Types::ArrayValue*>(cursor.collection.get());
+                }
+               else if (Types::ValueType::DICTIONARY == cursor.collection->getType())
+                {
+                  cursor.dictionary = static_cast<const Types::DictionaryValue*>(cursor.collection.get());
+                  cursor.iter = cursor.dictionary->value.begin();
+                }
+               else
+                {
+                  throw Types::TypedOperationException("Error iterating over non-Collection.");
+                }
+             }
+               break;
+
+            case Instruction::ITERNEXT:
+             {
+               CollectionCursor& cursor = cursors[instruction.b];
+               if (nullptr != cursor.array)
+                {
+                  if (cursor.index < cursor.array->value.size())
+                   {
+                     registers[instruction.a] = cursor.array->value.element(cursor.index);
+                     ++cursor.index;
+                   }
+                  else
+                   {
+                     cursor.collection.reset();
+                     pc = instruction.c;
+                   }
+                }
+               else
+                {
+                  if (cursor.dictionary->value.end() != cursor.iter)
+                   {
+                     std::shared_ptr<Types::ArrayValue> pair = std::make_shared<Types::ArrayValue>();
+                     pair->value.push_back(cursor.iter->first);
+                     pair->value.push_back(cursor.iter->second);
+                     registers[instruction.a] = pair;
+                     ++cursor.iter;
+                   }
+                  else
+                   {
+                     cursor.collection.reset();
+                     pc = instruction.c;
+                   }
+                }
+             }
+               break;
+
+            case Instruction::FORPREP:
+             {
+               LoopCounter& counter = counters[instruction.a];
+               const Types::Value& current = registers[instruction.b];
+               const Types::Value& step = registers[instruction.c];
+               counter.integral = (Types::ValueType::FLOAT == current->getType()) && (Types::ValueType::FLOAT == step->getType()) &&
+                  (true == SlowFloat::toInt64(static_cast<const Types::FloatValue&>(*current).value, counter.count)) &&
+                  (true == SlowFloat::toInt64(static_cast<const Types::FloatValue&>(*step).value, counter.stride)) &&
+                  (0 != counter.stride) && (counter.count >= -ForStatement::MAX_COUNTER) && (counter.count <= ForStatement::MAX_COUNTER) &&
+                  (counter.stride >= -ForStatement::MAX_COUNTER) && (counter.stride <= ForStatement::MAX_COUNTER);
+             }
+               break;
+
+            case Instruction::FORSTEP:
+             {
+               LoopCounter& counter = counters[instruction.a];
+               int64_t next = counter.count + counter.stride;
+               if ((true == counter.integral) && (next >= -ForStatement::MAX_COUNTER) && (next <= ForStatement::MAX_COUNTER) && (0 != next))
+                {
+                  counter.count = next;
+                  registers[instruction.b] = Types::Value(SlowFloat::fromInt64(next));
+                }
+               else
+                {
+                   // Zero takes its sign from the rounding mode, so let the Float arithmetic make it.
+                  registers[instruction.b] = registers[instruction.b]->add(*registers[instruction.c]);
+                  counter.count = next;
+                  counter.integral = (true == counter.integral) && (next >= -ForStatement::MAX_COUNTER) && (next <= ForStatement::MAX_COUNTER);
+                }
+             }
+               break;
+
+            case Instruction::RET:
+               return FlowControl(*chunk.tokens[instruction.token], FlowControl::RETURN, FlowControl::NO_TARGET,
+                  (Instruction::NO_REGISTER == instruction.a) ? Types::Value() : registers[instruction.a]);
+
+            case Instruction::TAILCALL:
+               context.tailArgs.assign(registers.begin() + instruction.a + 1U, registers.begin() + instruction.a + 1U + instruction.b);
+               return FlowControl(*chunk.tokens[instruction.token], FlowControl::TAIL_CALL, FlowControl::NO_TARGET, registers[instruction.a]);
+
+            case Instruction::FLOW:
+               return FlowControl(*chunk.tokens[instruction.token], static_cast<FlowControl::Type>(instruction.b), instruction.a, Types::Value());
+             }
+          }
+       }
+      catch (const Types::TypedOperationException& e)
+       {
+          // Replay the try/catch blocks that the tree would have passed through.
+         uint32_t region = chunk.code[current].region;
+         if (Instruction::NO_REGION == region)
+          {
+            throw;
+          }
+         std::string msg = e.what();
+         while (Instruction::NO_REGION != region)
+          {
+            msg = Expression::constructMessage(Types::TypedOperationException(msg), *chunk.tokens[chunk.regions[region].token]);
+            if ((true == chunk.regions[region].debugger) && (nullptr != context.debugger))
+             {
+               context.debugger->EnterDebugger(msg, context);
+             }
+            region = chunk.regions[region].parent;
+          }
+         throw Types::TypedOperationException(msg);
+       }
+      return FlowControl();
+    }
+
+ } // namespace Engine
+
+ } // namespace Backwards
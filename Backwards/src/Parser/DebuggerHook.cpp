@@ -62,19 +62,19 @@ namespace Engine
     {
       if (nullptr != val.get())
        {
-         if (typeid(Types::FloatValue) == typeid(*val))
+         switch (val->getType())
           {
-            stream << SlowFloat::toString(std::dynamic_pointer_cast<const Types::FloatValue>(val)->value);
-          }
-         else if (typeid(Types::StringValue) == typeid(*val))
-          {
-            stream << "\"" << std::dynamic_pointer_cast<const Types::StringValue>(val)->value << "\"";
-          }
-         else if (typeid(Types::ArrayValue) == typeid(*val))
+         case Types::ValueType::FLOAT:
+            stream << SlowFloat::toString(static_cast<const Types::FloatValue&>(*val).value);
+            break;
+         case Types::ValueType::STRING:
+            stream << "\"" << static_cast<const Types::StringValue&>(*val).value << "\"";
+            break;
+         case Types::ValueType::ARRAY:
           {
-            const std::vector<std::shared_ptr<Types::ValueType> >& array = std::dynamic_pointer_cast<const Types::ArrayValue>(val)->value;
+            const Types::ArrayElements& array = static_cast<const Types::ArrayValue&>(*val).value;
             stream << "{ ";
-            for (std::vector<std::shared_ptr<Types::ValueType> >::const_iterator iter = array.begin();
+            for (Types::ArrayElements::const_iterator iter = array.begin();
                array.end() != iter; ++iter)
              {
                if (array.begin() != iter)
@@ -85,13 +85,12 @@ namespace Engine
              }
             stream << " }";
           }
-         else if (typeid(Types::DictionaryValue) == typeid(*val))
+            break;
+         case Types::ValueType::DICTIONARY:
           {
-            const std::map<std::shared_ptr<Types::ValueType>, std::shared_ptr<Types::ValueType>, Types::ChristHowHorrifying>& dict =
-               std::dynamic_pointer_cast<const Types::DictionaryValue>(val)->value;
+            const Types::DictionaryMap& dict = static_cast<const Types::DictionaryValue&>(*val).value;
             stream << "{ ";
-            for (std::map<std::shared_ptr<Types::ValueType>, std::shared_ptr<Types::ValueType>, Types::ChristHowHorrifying>::const_iterator
-               iter = dict.begin(); dict.end() != iter; ++iter)
+            for (Types::DictionaryMap::const_iterator iter = dict.begin(); dict.end() != iter; ++iter)
              {
                if (dict.begin() != iter)
                 {
@@ -103,10 +102,12 @@ namespace Engine
              }
             stream << " }";
           }
-         else if (typeid(Types::FunctionValue) == typeid(*val))
+            break;
+         case Types::ValueType::FUNCTION:
           {
-            stream << "Function : " << std::dynamic_pointer_cast<const FunctionContext>(std::dynamic_pointer_cast<const Types::FunctionValue>(val)->value)->name;
-            const std::vector<std::shared_ptr<Types::ValueType> >& array = std::dynamic_pointer_cast<const Types::FunctionValue>(val)->captures;
+            const Types::FunctionValue& function = static_cast<const Types::FunctionValue&>(*val);
+            stream << "Function : " << static_cast<const FunctionContext&>(*function.value).name;
+            const std::vector<std::shared_ptr<Types::ValueType> >& array = function.captures;
             if (false == array.empty())
              {
                stream << " [ ";
@@ -122,9 +123,10 @@ namespace Engine
                stream << " ]";
              }
           }
-         else
-          {
+            break;
+         default:
             stream << "Type not understood.";
+            break;
           }
        }
       else
@@ -137,6 +139,10 @@ namespace Engine
    {
       out << "#" << frame->depth << ": >" << frame->function->name <<
          "< from line " << frame->callingToken.lineNumber << " in " << frame->callingToken.sourceFile;
+      if (0U != frame->tailCalls)
+       {
+         out << " (after " << frame->tailCalls << " tail calls)";
+       }
    }
 
    void DefaultDebugger::EnterDebugger(const std::string& exceptionMessage, CallingContext& context)
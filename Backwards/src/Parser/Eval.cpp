@@ -54,7 +54,7 @@ namespace Engine
 
    STDLIB_UNARY_DECL_WITH_CONTEXT(Eval)
     {
-      if (typeid(Types::StringValue) == typeid(*arg))
+      if (Types::ValueType::STRING == arg->getType())
        {
          Input::StringInput string (static_cast<const Types::StringValue&>(*arg).value);
          Input::Lexer lexer (string, "Eval Argument");
@@ -0,0 +1,382 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Backwards/Parser/Optimizer.h"
+
+#include "Backwards/Engine/Expression.h"
+#include "Backwards/Engine/Statement.h"
+#include "Backwards/Engine/FunctionContext.h"
+#include "Backwards/Engine/ConstantsSingleton.h"
+
+#include "Backwards/Types/FloatValue.h"
+#include "Backwards/Types/FunctionValue.h"
+
+namespace Backwards
+ {
+
+namespace Parser
+ {
+
+   static const SlowFloat::SlowFloat_Round_Mode ALL_MODES [] =
+    {
+      SlowFloat::ROUND_TIES_EVEN,
+      SlowFloat::ROUND_TIES_AWAY,
+      SlowFloat::ROUND_POSITIVE_INFINITY,
+      SlowFloat::ROUND_NEGATIVE_INFINITY,
+      SlowFloat::ROUND_ZERO,
+      SlowFloat::ROUND_TIES_ODD,
+      SlowFloat::ROUND_TIES_ZERO,
+      SlowFloat::ROUND_AWAY
+    };
+
+   static bool isConstant (const std::shared_ptr<Engine::Expression>& expr)
+    {
+      return (nullptr != expr.get()) && (typeid(Engine::Constant) == typeid(*expr));
+    }
+
+   static std::shared_ptr<Engine::FunctionContext> getFunction (const std::shared_ptr<Types::ValueType>& value)
+    {
+      if ((nullptr == value.get()) || (Types::ValueType::FUNCTION != value->getType()))
+       {
+         return std::shared_ptr<Engine::FunctionContext>();
+       }
+       // Only follow the strong reference: the weak one is a function referring to itself.
+      return std::static_pointer_cast<Engine::FunctionContext>(static_cast<const Types::FunctionValue&>(*value).value);
+    }
+
+    // Floats are compared by representation: a fold that gives 0 in one mode and -0 in another isn't safe.
+   static bool sameResult (const Types::Value& lhs, const Types::Value& rhs)
+    {
+      if ((Types::ValueType::FLOAT == lhs->getType()) && (Types::ValueType::FLOAT == rhs->getType()))
+       {
+         const SlowFloat::SlowFloat& left = static_cast<const Types::FloatValue&>(*lhs).value;
+         const SlowFloat::SlowFloat& right = static_cast<const Types::FloatValue&>(*rhs).value;
+         return (left.significand == right.significand) && (left.exponent == right.exponent);
+       }
+      return lhs->compare(*rhs);
+    }
+
+   Optimizer::Optimizer() : visited()
+    {
+    }
+
+   std::shared_ptr<Engine::Statement> Optimizer::Optimize (const std::shared_ptr<Engine::Statement>& tree)
+    {
+      if (nullptr == tree.get())
+       {
+         return tree;
+       }
+      Optimizer optimizer;
+      return optimizer.statement(tree);
+    }
+
+   std::shared_ptr<Engine::Expression> Optimizer::Optimize (const std::shared_ptr<Engine::Expression>& tree)
+    {
+      if (nullptr == tree.get())
+       {
+         return tree;
+       }
+      Optimizer optimizer;
+      return optimizer.expression(tree);
+    }
+
+   std::shared_ptr<Engine::Expression> Optimizer::fold (const std::shared_ptr<Engine::Expression>& expr) const
+    {
+      Engine::CallingContext context;
+      Types::Value result;
+      try
+       {
+         SlowFloat::SlowFloat_Round_Mode saved = SlowFloat::mode;
+         try
+          {
+            for (SlowFloat::SlowFloat_Round_Mode current : ALL_MODES)
+             {
+               SlowFloat::mode = current;
+               Types::Value temp = expr->evaluate(context);
+               if (nullptr == result.get())
+                {
+                  result = temp;
+                }
+               else if (false == sameResult(result, temp))
+                {
+                  result = Types::Value();
+                  break;
+                }
+             }
+          }
+         catch (...)
+          {
+            SlowFloat::mode = saved;
+            throw;
+          }
+         SlowFloat::mode = saved;
+       }
+      catch (const Types::TypedOperationException&)
+       {
+          // Leave it be, so that it fails at runtime with a debugger.
+         return expr;
+       }
+
+      if (nullptr == result.get())
+       {
+         return expr;
+       }
+      return std::make_shared<Engine::Constant>(expr->token, result.box());
+    }
+
+#define OPTIMIZE_BINARY(x) \
+      else if (typeid(Engine::x) == typeid(*expr)) \
+       { \
+         Engine::x& node = static_cast<Engine::x&>(*expr); \
+         node.lhs = expression(node.lhs); \
+         node.rhs = expression(node.rhs); \
+         if (isConstant(node.lhs) && isConstant(node.rhs)) \
+          { \
+            return fold(expr); \
+          } \
+       }
+
+#define OPTIMIZE_SHORT(x, y) \
+      else if (typeid(Engine::x) == typeid(*expr)) \
+       { \
+         Engine::x& node = static_cast<Engine::x&>(*expr); \
+         node.lhs = expression(node.lhs); \
+         node.rhs = expression(node.rhs); \
+         if (isConstant(node.rhs) && isConstant(node.lhs)) \
+          { \
+            return fold(expr); \
+          } \
+         if (isConstant(node.lhs)) \
+          { \
+            const std::shared_ptr<Types::ValueType>& value = static_cast<const Engine::Constant&>(*node.lhs).value; \
+            try \
+             { \
+               if (y == value->logical()) \
+                { \
+                  return std::make_shared<Engine::Constant>(expr->token, (true == y) ? \
+                     Engine::ConstantsSingleton::getInstance().FLOAT_ONE : \
+                     Engine::ConstantsSingleton::getInstance().FLOAT_ZERO); \
+                } \
+             } \
+            catch (const Types::TypedOperationException&) \
+             { \
+             } \
+          } \
+       }
+
+#define OPTIMIZE_UNARY(x) \
+      else if (typeid(Engine::x) == typeid(*expr)) \
+       { \
+         Engine::x& node = static_cast<Engine::x&>(*expr); \
+         node.arg = expression(node.arg); \
+         if (isConstant(node.arg)) \
+          { \
+            return fold(expr); \
+          } \
+       }
+
+   std::shared_ptr<Engine::Expression> Optimizer::expression (const std::shared_ptr<Engine::Expression>& expr)
+    {
+      if (nullptr == expr.get())
+       {
+         return expr;
+       }
+
+      if (typeid(Engine::Constant) == typeid(*expr))
+       {
+         function(getFunction(static_cast<const Engine::Constant&>(*expr).value).get());
+       }
+      OPTIMIZE_BINARY(Plus)
+      OPTIMIZE_BINARY(Minus)
+      OPTIMIZE_BINARY(Multiply)
+      OPTIMIZE_BINARY(Divide)
+      OPTIMIZE_BINARY(Power)
+      OPTIMIZE_SHORT(ShortAnd, false)
+      OPTIMIZE_SHORT(ShortOr, true)
+      OPTIMIZE_BINARY(Equals)
+      OPTIMIZE_BINARY(NotEqual)
+      OPTIMIZE_BINARY(Greater)
+      OPTIMIZE_BINARY(Less)
+      OPTIMIZE_BINARY(GEQ)
+      OPTIMIZE_BINARY(LEQ)
+      OPTIMIZE_BINARY(DerefVar)
+      OPTIMIZE_UNARY(Not)
+      OPTIMIZE_UNARY(Negate)
+      else if (typeid(Engine::FunctionCall) == typeid(*expr))
+       {
+         Engine::FunctionCall& node = static_cast<Engine::FunctionCall&>(*expr);
+         node.location = expression(node.location);
+         for (auto& arg : node.args)
+          {
+            arg = expression(arg);
+          }
+       }
+      else if (typeid(Engine::NativeCall) == typeid(*expr))
+       {
+          // The call is optimized in place.
+         (void) expression(static_cast<Engine::NativeCall&>(*expr).call);
+       }
+      else if (typeid(Engine::BuildFunction) == typeid(*expr))
+       {
+         Engine::BuildFunction& node = static_cast<Engine::BuildFunction&>(*expr);
+         function(node.prototype.get());
+         for (auto& capture : node.captures)
+          {
+            capture = expression(capture);
+          }
+       }
+      else if (typeid(Engine::TernaryOperation) == typeid(*expr))
+       {
+         Engine::TernaryOperation& node = static_cast<Engine::TernaryOperation&>(*expr);
+         node.condition = expression(node.condition);
+         node.thenCase = expression(node.thenCase);
+         node.elseCase = expression(node.elseCase);
+         if (isConstant(node.condition))
+          {
+            try
+             {
+               return (true == static_cast<const Engine::Constant&>(*node.condition).value->logical()) ? node.thenCase : node.elseCase;
+             }
+            catch (const Types::TypedOperationException&)
+             {
+             }
+          }
+       }
+      return expr;
+    }
+
+#undef OPTIMIZE_UNARY
+#undef OPTIMIZE_SHORT
+#undef OPTIMIZE_BINARY
+
+   void Optimizer::function (Engine::FunctionContext* context)
+    {
+      if ((nullptr != context) && (true == visited.insert(context).second))
+       {
+         context->function = statement(context->function);
+       }
+    }
+
+   std::shared_ptr<Engine::Statement> Optimizer::statement (const std::shared_ptr<Engine::Statement>& stmt)
+    {
+      if (nullptr == stmt.get())
+       {
+         return stmt;
+       }
+
+      if (typeid(Engine::Expr) == typeid(*stmt))
+       {
+         Engine::Expr& node = static_cast<Engine::Expr&>(*stmt);
+         node.expr = expression(node.expr);
+       }
+      else if (typeid(Engine::StatementSeq) == typeid(*stmt))
+       {
+         Engine::StatementSeq& node = static_cast<Engine::StatementSeq&>(*stmt);
+         std::vector<std::shared_ptr<Engine::Statement> > statements;
+         for (const auto& iter : node.statements)
+          {
+            std::shared_ptr<Engine::Statement> next = statement(iter);
+            if (typeid(Engine::StatementSeq) == typeid(*next))
+             {
+               const std::vector<std::shared_ptr<Engine::Statement> >& inner = static_cast<const Engine::StatementSeq&>(*next).statements;
+               statements.insert(statements.end(), inner.begin(), inner.end());
+             }
+            else if (typeid(Engine::NOP) != typeid(*next))
+             {
+               statements.emplace_back(next);
+             }
+          }
+         node.statements.swap(statements);
+       }
+      else if (typeid(Engine::Assignment) == typeid(*stmt))
+       {
+         Engine::Assignment& node = static_cast<Engine::Assignment&>(*stmt);
+         for (Engine::RecAssignState* iter = node.index.get(); nullptr != iter; iter = iter->next.get())
+          {
+            iter->index = expression(iter->index);
+          }
+         node.rhs = expression(node.rhs);
+       }
+      else if (typeid(Engine::IfStatement) == typeid(*stmt))
+       {
+         Engine::IfStatement& node = static_cast<Engine::IfStatement&>(*stmt);
+         node.condition = expression(node.condition);
+         node.thenSeq = statement(node.thenSeq);
+         node.elseSeq = statement(node.elseSeq);
+         if (isConstant(node.condition))
+          {
+            try
+             {
+               std::shared_ptr<Engine::Statement> taken =
+                  (true == static_cast<const Engine::Constant&>(*node.condition).value->logical()) ? node.thenSeq : node.elseSeq;
+               return (nullptr != taken.get()) ? taken : Engine::ConstantsSingleton::getInstance().ONE_TRUE_NOP;
+             }
+            catch (const Types::TypedOperationException&)
+             {
+             }
+          }
+       }
+      else if (typeid(Engine::WhileStatement) == typeid(*stmt))
+       {
+         Engine::WhileStatement& node = static_cast<Engine::WhileStatement&>(*stmt);
+         node.condition = expression(node.condition);
+         node.seq = statement(node.seq);
+       }
+      else if (typeid(Engine::SelectStatement) == typeid(*stmt))
+       {
+         Engine::SelectStatement& node = static_cast<Engine::SelectStatement&>(*stmt);
+         node.control = expression(node.control);
+         for (auto& caseContainer : node.cases)
+          {
+            caseContainer->condition = expression(caseContainer->condition);
+            caseContainer->lower = expression(caseContainer->lower);
+            caseContainer->seq = statement(caseContainer->seq);
+          }
+       }
+      else if (typeid(Engine::ForStatement) == typeid(*stmt))
+       {
+         Engine::ForStatement& node = static_cast<Engine::ForStatement&>(*stmt);
+         node.lower = expression(node.lower);
+         node.upper = expression(node.upper);
+         node.step = expression(node.step);
+         node.seq = statement(node.seq);
+       }
+      else if (typeid(Engine::FlowControlStatement) == typeid(*stmt))
+       {
+         Engine::FlowControlStatement& node = static_cast<Engine::FlowControlStatement&>(*stmt);
+         node.value = expression(node.value);
+       }
+      return stmt;
+    }
+
+ } // namespace Parser
+
+ } // namespace Backwards
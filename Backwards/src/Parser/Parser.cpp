@@ -30,6 +30,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Backwards/Parser/Parser.h"
+#include "Backwards/Parser/Optimizer.h"
 
 #include "Backwards/Engine/Expression.h"
 #include "Backwards/Engine/FunctionContext.h"
@@ -44,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Engine/ConstantsSingleton.h"
 
 #include <sstream>
+#include <typeinfo>
 
 namespace Backwards
  {
@@ -304,7 +306,7 @@ namespace Parser
           {
             Input::Token memberToken = src.peekNextToken();
             expect(src, Input::IDENTIFIER, "Identifier");
-            rhs = std::make_shared<Engine::Constant>(memberToken, std::make_shared<Types::StringValue>(memberToken.text));
+            rhs = std::make_shared<Engine::Constant>(memberToken, Types::StringValue::intern(memberToken.text));
           }
          else
           {
@@ -397,7 +399,7 @@ namespace Parser
 
          expect(src, Input::CLOSE_PARENS, ")");
 
-         ret = std::make_shared<Engine::FunctionCall>(buildToken, ret, args);
+         ret = table.buildFunctionCall(buildToken, ret, args);
       }
 
       return ret;
@@ -418,7 +420,7 @@ namespace Parser
           {
             Input::Token buildToken = src.getNextToken();
 
-            ret = std::make_shared<Engine::Variable>(buildToken, table.getVariableGetter(buildToken.text));
+            ret = table.buildVariable(buildToken);
           }
             break;
          case SymbolTable::FUNCTION:
@@ -604,7 +606,7 @@ namespace Parser
        {
          Input::Token buildToken = src.getNextToken();
 
-         ret = std::make_shared<Engine::Constant>(buildToken, std::make_shared<Types::StringValue>(buildToken.text));
+         ret = std::make_shared<Engine::Constant>(buildToken, Types::StringValue::intern(buildToken.text));
        }
          break;
       case Input::OPEN_PARENS:
@@ -753,14 +755,14 @@ namespace Parser
        }
       if (false == badWrong)
        {
-         return std::make_shared<Engine::StatementSeq>(token, statements);
+         return Optimizer::Optimize(std::make_shared<Engine::StatementSeq>(token, statements));
        }
       return std::shared_ptr<Engine::Statement>();
     }
 
    std::shared_ptr<Engine::Statement> Parser::Parse (Input::Lexer& src, SymbolTable& table, Engine::Logger& logger)
     {
-      return outerStatementSeq(src, table, logger); // Currently, outerStatementSeq will never throw an exception.
+      return Optimizer::Optimize(outerStatementSeq(src, table, logger)); // Currently, outerStatementSeq will never throw an exception.
     }
 
    std::shared_ptr<Engine::Statement> Parser::ParseStatement (Input::Lexer& src, SymbolTable& table, Engine::Logger& logger)
@@ -839,7 +841,7 @@ namespace Parser
                 {
                   Input::Token memberToken = src.peekNextToken();
                   expect(src, Input::IDENTIFIER, "Identifier");
-                  index = std::make_shared<Engine::Constant>(memberToken, std::make_shared<Types::StringValue>(memberToken.text));
+                  index = std::make_shared<Engine::Constant>(memberToken, Types::StringValue::intern(memberToken.text));
                 }
                else
                 {
@@ -1077,7 +1079,10 @@ namespace Parser
 
          std::shared_ptr<Engine::Expression> expry = expression(src, table, logger);
 
-         ret = std::make_shared<Engine::FlowControlStatement>(buildToken, Engine::FlowControl::RETURN, Engine::FlowControl::NO_TARGET, expry);
+         std::shared_ptr<Engine::FlowControlStatement> flow = std::make_shared<Engine::FlowControlStatement>(buildToken, Engine::FlowControl::RETURN, Engine::FlowControl::NO_TARGET, expry);
+          // Only a function's caller knows what to do with a tail call.
+         flow->tailCall = (true == table.inFunction()) && (nullptr != expry.get()) && (typeid(Engine::FunctionCall) == typeid(*expry));
+         ret = flow;
        }
          break;
 
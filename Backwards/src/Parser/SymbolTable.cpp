@@ -35,6 +35,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Engine/FunctionContext.h"
 #include "Backwards/Engine/StackFrame.h" // For Getters/Setters
 
+#include <typeinfo>
+
 namespace Backwards
  {
 
@@ -109,6 +111,11 @@ namespace Parser
       frames.pop_back();
     }
 
+   bool SymbolTable::inFunction() const
+    {
+      return false == frames.empty();
+    }
+
 
    void SymbolTable::addVariable(const std::string& name)
     {
@@ -284,6 +291,17 @@ namespace Parser
       return UNDEFINED;
     }
 
+   std::shared_ptr<Engine::Expression> SymbolTable::buildVariable(const Input::Token& buildToken) const
+    {
+      std::shared_ptr<Engine::Variable> result = std::make_shared<Engine::Variable>(buildToken, getVariableGetter(buildToken.text));
+       // Nothing unsets a global, so one that is already set needn't be checked when it is read.
+      if ((Engine::Variable::GLOBAL == result->access) && (nullptr != globalScope->vars[result->location].get()))
+       {
+         result->access = Engine::Variable::SET_GLOBAL;
+       }
+      return result;
+    }
+
    std::shared_ptr<Engine::Expression> SymbolTable::buildPushBack(const Input::Token& buildToken,
       const std::shared_ptr<Engine::Expression>& lhs, const std::shared_ptr<Engine::Expression>& rhs) const
     {
@@ -295,7 +313,7 @@ namespace Parser
        {
          throw Engine::ProgrammingException("Cannot resolve request for PushBack.");
        }
-      return std::make_shared<Engine::FunctionCall>(buildToken, pushBackFun, args);
+      return buildFunctionCall(buildToken, pushBackFun, args);
     }
 
    std::shared_ptr<Engine::Expression> SymbolTable::buildInsert(const Input::Token& buildToken,
@@ -311,7 +329,27 @@ namespace Parser
        {
          throw Engine::ProgrammingException("Cannot resolve request for Insert.");
        }
-      return std::make_shared<Engine::FunctionCall>(buildToken, insertFun, args);
+      return buildFunctionCall(buildToken, insertFun, args);
+    }
+
+   std::shared_ptr<Engine::Expression> SymbolTable::buildFunctionCall(const Input::Token& buildToken,
+      const std::shared_ptr<Engine::Expression>& location, const std::vector<std::shared_ptr<Engine::Expression> >& args) const
+    {
+      std::shared_ptr<Engine::FunctionCall> call = std::make_shared<Engine::FunctionCall>(buildToken, location, args);
+      if (typeid(Engine::Constant) == typeid(*location))
+       {
+         return Engine::NativeCall::bind(call, static_cast<const Engine::Constant&>(*location).value);
+       }
+       // Only a global can hold a standard library function now. What it holds when the call is made is checked then.
+      if ((typeid(Engine::Variable) == typeid(*location)) && (GLOBAL_VARIABLE == lookup(location->token.text)))
+       {
+         size_t index = globalScope->var.find(location->token.text)->second;
+         if (static_cast<const Engine::Variable&>(*location).getter == gs.globalGetters[index])
+          {
+            return Engine::NativeCall::bind(call, globalScope->vars[index]);
+          }
+       }
+      return call;
     }
 
    size_t SymbolTable::newLoop()
@@ -30,6 +30,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Backwards/Types/ValueType.h"
+#include "Backwards/Types/Value.h"
 
 #include "Backwards/Types/FloatValue.h"
 #include "Backwards/Types/StringValue.h"
@@ -37,23 +38,69 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Types/DictionaryValue.h"
 #include "Backwards/Types/FunctionValue.h"
 
+#include <vector>
+
 namespace Backwards
  {
 
 namespace Types
  {
 
+    // Arithmetic between a Float and an Array of nothing but Floats is done as one batch:
+    // the Floats are gathered, computed without any dispatch, and the results are packed.
+   static bool gather (const ArrayElements& source, std::vector<SlowFloat::SlowFloat>& dest)
+    {
+      dest.reserve(source.size());
+      if (true == source.isPacked())
+       {
+         dest.assign(source.getFloats().begin(), source.getFloats().end());
+         return true;
+       }
+      for (ArrayElements::const_iterator iter = source.begin(); source.end() != iter; ++iter)
+       {
+         Value element = *iter;
+         if (ValueType::FLOAT != element->getType())
+          {
+            return false;
+          }
+         dest.push_back(static_cast<const FloatValue&>(*element).value);
+       }
+      return true;
+    }
+
+   static Value scatter (const std::vector<SlowFloat::SlowFloat>& source)
+    {
+      std::shared_ptr<ArrayValue> result = std::make_shared<ArrayValue>();
+      for (const SlowFloat::SlowFloat& element : source)
+       {
+         result->value.push_back(element);
+       }
+      return result;
+    }
+
+   ArrayValue::ArrayValue() : ValueType(ARRAY), value()
+    {
+    }
+
    const std::string& ArrayValue::getTypeName() const
     {
       static const std::string name ("Array");
       return name;
     }
 
-   std::shared_ptr<ValueType> ArrayValue::neg() const
+   Value ArrayValue::neg() const
     {
       std::shared_ptr<ArrayValue> result = std::make_shared<ArrayValue>();
-      result->value.reserve(value.size());
-      for (std::vector<std::shared_ptr<ValueType> >::const_iterator iter = value.begin();
+      if (true == value.isPacked())
+       {
+         for (PersistentVector<SlowFloat::SlowFloat>::const_iterator iter = value.getFloats().begin();
+            value.getFloats().end() != iter; ++iter)
+          {
+            result->value.push_back(-*iter);
+          }
+         return result;
+       }
+      for (ArrayElements::const_iterator iter = value.begin();
          value.end() != iter; ++iter)
        {
          result->value.emplace_back((*iter)->neg());
@@ -62,11 +109,10 @@ namespace Types
     }
 
 #define COMMUTEARRAY(x,y) \
-   std::shared_ptr<ValueType> ArrayValue::x (const y& lhs) const \
+   Value ArrayValue::x (const y& lhs) const \
     { \
       std::shared_ptr<ArrayValue> result = std::make_shared<ArrayValue>(); \
-      result->value.reserve(value.size()); \
-      for (std::vector<std::shared_ptr<ValueType> >::const_iterator iter = value.begin(); \
+      for (ArrayElements::const_iterator iter = value.begin(); \
          value.end() != iter; ++iter) \
        { \
          result->value.emplace_back(lhs.x(**iter)); \
@@ -74,17 +120,35 @@ namespace Types
       return result; \
     }
 
-   COMMUTEARRAY(add, FloatValue)
+#define BATCHARRAY(x) \
+   Value ArrayValue::x (const FloatValue& lhs) const \
+    { \
+      std::vector<SlowFloat::SlowFloat> batch; \
+      if (true == gather(value, batch)) \
+       { \
+         SlowFloat::x(lhs.value, batch.data(), batch.data(), batch.size()); \
+         return scatter(batch); \
+       } \
+      std::shared_ptr<ArrayValue> result = std::make_shared<ArrayValue>(); \
+      for (ArrayElements::const_iterator iter = value.begin(); \
+         value.end() != iter; ++iter) \
+       { \
+         result->value.emplace_back(lhs.x(**iter)); \
+       } \
+      return result; \
+    }
+
+   BATCHARRAY(add)
    COMMUTEARRAY(add, StringValue)
    COMMUTEARRAY(add, ArrayValue)
    COMMUTEARRAY(add, DictionaryValue)
-   COMMUTEARRAY(sub, FloatValue)
+   BATCHARRAY(sub)
    COMMUTEARRAY(sub, ArrayValue)
    COMMUTEARRAY(sub, DictionaryValue)
-   COMMUTEARRAY(mul, FloatValue)
+   BATCHARRAY(mul)
    COMMUTEARRAY(mul, ArrayValue)
    COMMUTEARRAY(mul, DictionaryValue)
-   COMMUTEARRAY(div, FloatValue)
+   BATCHARRAY(div)
    COMMUTEARRAY(div, ArrayValue)
    COMMUTEARRAY(div, DictionaryValue)
 
@@ -95,7 +159,16 @@ namespace Types
       if (lhs.value.size() == value.size())
        {
          are_equal = true;
-         for (std::vector<std::shared_ptr<ValueType> >::const_iterator iter1 = lhs.value.begin(),
+         if ((true == lhs.value.isPacked()) && (true == value.isPacked()))
+          {
+            for (PersistentVector<SlowFloat::SlowFloat>::const_iterator iter1 = lhs.value.getFloats().begin(),
+               iter2 = value.getFloats().begin(); (lhs.value.getFloats().end() != iter1) && (true == are_equal); ++iter1, ++iter2)
+             {
+               are_equal = (*iter1 == *iter2);
+             }
+            return are_equal;
+          }
+         for (ArrayElements::const_iterator iter1 = lhs.value.begin(),
             iter2 = value.begin(); (lhs.value.end() != iter1) && (true == are_equal); ++iter1, ++iter2)
           {
             are_equal &= ((*iter1)->compare(**iter2));
@@ -111,11 +184,16 @@ namespace Types
 
 
 #define ARRAYCOMMUTE(x) \
-   std::shared_ptr<ValueType> ArrayValue::x (const ValueType& rhs) const \
+   Value ArrayValue::x (const ValueType& rhs) const \
     { \
+      std::vector<SlowFloat::SlowFloat> batch; \
+      if ((ValueType::FLOAT == rhs.getType()) && (true == gather(value, batch))) \
+       { \
+         SlowFloat::x(batch.data(), static_cast<const FloatValue&>(rhs).value, batch.data(), batch.size()); \
+         return scatter(batch); \
+       } \
       std::shared_ptr<ArrayValue> result = std::make_shared<ArrayValue>(); \
-      result->value.reserve(value.size()); \
-      for (std::vector<std::shared_ptr<ValueType> >::const_iterator iter = value.begin(); \
+      for (ArrayElements::const_iterator iter = value.begin(); \
          value.end() != iter; ++iter) \
        { \
          result->value.emplace_back((*iter)->x(rhs)); \
@@ -151,7 +229,7 @@ namespace Types
       bool is_less = false;
       if (lhs.value.size() == value.size())
        {
-         for (std::vector<std::shared_ptr<ValueType> >::const_iterator iter1 = lhs.value.begin(),
+         for (ArrayElements::const_iterator iter1 = lhs.value.begin(),
             iter2 = value.begin(); lhs.value.end() != iter1; ++iter1, ++iter2)
           {
             if (false == (*iter1)->compare(**iter2))
@@ -182,7 +260,7 @@ namespace Types
     {
                       // S H I A L A B E O U F
       size_t result = 0x534849414C414245;
-      for (std::vector<std::shared_ptr<ValueType> >::const_iterator iter = value.begin();
+      for (ArrayElements::const_iterator iter = value.begin();
          value.end() != iter; ++iter)
        {
          boost_hash_combine(result, (*iter)->hash());
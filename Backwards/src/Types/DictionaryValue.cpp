@@ -30,6 +30,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Backwards/Types/ValueType.h"
+#include "Backwards/Types/Value.h"
 
 #include "Backwards/Types/FloatValue.h"
 #include "Backwards/Types/StringValue.h"
@@ -48,32 +49,44 @@ namespace Types
       return lhs->sort(*rhs);
     }
 
+   size_t ValueTypeHash::operator() (const std::shared_ptr<ValueType>& key) const
+    {
+      return key->hash();
+    }
+
+   bool ValueTypeEqual::operator() (const std::shared_ptr<ValueType>& lhs, const std::shared_ptr<ValueType>& rhs) const
+    {
+      return lhs->compare(*rhs);
+    }
+
+   DictionaryValue::DictionaryValue() : ValueType(DICTIONARY), value()
+    {
+    }
+
    const std::string& DictionaryValue::getTypeName() const
     {
       static const std::string name ("Dictionary");
       return name;
     }
 
-   std::shared_ptr<ValueType> DictionaryValue::neg() const
+   Value DictionaryValue::neg() const
     {
       std::shared_ptr<DictionaryValue> result = std::make_shared<DictionaryValue>();
-      for (std::map<std::shared_ptr<ValueType>, std::shared_ptr<ValueType>, ChristHowHorrifying>::const_iterator iter = value.begin();
-         value.end() != iter; ++iter)
+      value.forEach([&result](const DictionaryMap::value_type& item)
        {
-         result->value.emplace(std::make_pair(iter->first, iter->second->neg()));
-       }
+         result->value.set(item.first, item.second->neg());
+       });
       return result;
     }
 
 #define COMMUTEDICTIONARY(x,y) \
-   std::shared_ptr<ValueType> DictionaryValue::x (const y& lhs) const \
+   Value DictionaryValue::x (const y& lhs) const \
     { \
       std::shared_ptr<DictionaryValue> result = std::make_shared<DictionaryValue>(); \
-      for (std::map<std::shared_ptr<ValueType>, std::shared_ptr<ValueType>, ChristHowHorrifying>::const_iterator iter = value.begin(); \
-         value.end() != iter; ++iter) \
+      value.forEach([&result, &lhs](const DictionaryMap::value_type& item) \
        { \
-         result->value.emplace(std::make_pair(iter->first, lhs.x(*(iter->second)))); \
-       } \
+         result->value.set(item.first, lhs.x(*(item.second))); \
+       }); \
       return result; \
     }
 
@@ -98,15 +111,14 @@ namespace Types
       if (lhs.value.size() == value.size())
        {
          are_equal = true;
-         for (std::map<std::shared_ptr<ValueType>, std::shared_ptr<ValueType>, ChristHowHorrifying>::const_iterator iter1 = lhs.value.begin(),
-            iter2 = value.begin(); (lhs.value.end() != iter1) && (true == are_equal); ++iter1, ++iter2)
+         lhs.value.forEach([this, &are_equal](const DictionaryMap::value_type& item)
           {
-            are_equal &= (iter1->first->compare(*(iter2->first)));
             if (true == are_equal)
              {
-               are_equal &= (iter1->second->compare(*(iter2->second)));
+               const std::shared_ptr<ValueType>* other = value.find(item.first);
+               are_equal = (nullptr != other) && (true == item.second->compare(**other));
              }
-          }
+          });
        }
       return are_equal;
     }
@@ -118,14 +130,13 @@ namespace Types
 
 
 #define DICTIONARYCOMMUTE(x) \
-   std::shared_ptr<ValueType> DictionaryValue::x (const ValueType& rhs) const \
+   Value DictionaryValue::x (const ValueType& rhs) const \
     { \
       std::shared_ptr<DictionaryValue> result = std::make_shared<DictionaryValue>(); \
-      for (std::map<std::shared_ptr<ValueType>, std::shared_ptr<ValueType>, ChristHowHorrifying>::const_iterator iter = value.begin(); \
-         value.end() != iter; ++iter) \
+      value.forEach([&result, &rhs](const DictionaryMap::value_type& item) \
        { \
-         result->value.emplace(std::make_pair(iter->first, iter->second->x(rhs))); \
-       } \
+         result->value.set(item.first, item.second->x(rhs)); \
+       }); \
       return result; \
     }
 
@@ -162,8 +173,7 @@ namespace Types
       bool is_less = false;
       if (lhs.value.size() == value.size())
        {
-         for (std::map<std::shared_ptr<ValueType>, std::shared_ptr<ValueType>, ChristHowHorrifying>::const_iterator iter1 = lhs.value.begin(),
-            iter2 = value.begin(); lhs.value.end() != iter1; ++iter1, ++iter2)
+         for (DictionaryMap::const_iterator iter1 = lhs.value.begin(), iter2 = value.begin(); lhs.value.end() != iter1; ++iter1, ++iter2)
           {
             if (false == (iter1->first->compare(*(iter2->first))))
              {
@@ -193,15 +203,14 @@ namespace Types
     {
                       // B E E F C A K E
       size_t result = 0x4245454643414B45;
-      for (std::map<std::shared_ptr<ValueType>, std::shared_ptr<ValueType>, ChristHowHorrifying>::const_iterator iter = value.begin();
-         value.end() != iter; ++iter)
+      value.forEach([&result](const DictionaryMap::value_type& item)
        {
-         size_t temp = iter->first->hash();
-         boost_hash_combine(temp, iter->second->hash());
+         size_t temp = item.first->hash();
+         boost_hash_combine(temp, item.second->hash());
 
          // We can't do anything special here because the final hash needs to be independent of iteration order.
          result ^= temp;
-       }
+       });
       return result;
     }
 
@@ -30,6 +30,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Backwards/Types/ValueType.h"
+#include "Backwards/Types/Value.h"
 
 #include "Backwards/Types/FloatValue.h"
 #include "Backwards/Types/StringValue.h"
@@ -37,7 +38,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Types/DictionaryValue.h"
 #include "Backwards/Types/FunctionValue.h"
 
-#include <cmath>
 #include <functional>
 
 namespace Backwards
@@ -46,11 +46,11 @@ namespace Backwards
 namespace Types
  {
 
-   FloatValue::FloatValue() : value(SlowFloat::SlowFloat())
+   FloatValue::FloatValue() : ValueType(FLOAT), value(SlowFloat::SlowFloat())
     {
     }
 
-   FloatValue::FloatValue(const SlowFloat::SlowFloat& value) : value(value)
+   FloatValue::FloatValue(const SlowFloat::SlowFloat& value) : ValueType(FLOAT), value(value)
     {
     }
 
@@ -60,9 +60,9 @@ namespace Types
       return name;
     }
 
-   std::shared_ptr<ValueType> FloatValue::neg () const
+   Value FloatValue::neg () const
     {
-      return std::make_shared<FloatValue>(-value);
+      return Value(-value);
     }
 
    bool FloatValue::logical () const
@@ -70,29 +70,29 @@ namespace Types
       return (SlowFloat::SlowFloat() == value) ? false : true;
     }
 
-   std::shared_ptr<ValueType> FloatValue::add (const FloatValue& lhs) const
+   Value FloatValue::add (const FloatValue& lhs) const
     {
-      return std::make_shared<FloatValue>(lhs.value + value);
+      return Value(lhs.value + value);
     }
 
-   std::shared_ptr<ValueType> FloatValue::sub (const FloatValue& lhs) const
+   Value FloatValue::sub (const FloatValue& lhs) const
     {
-      return std::make_shared<FloatValue>(lhs.value - value);
+      return Value(lhs.value - value);
     }
 
-   std::shared_ptr<ValueType> FloatValue::mul (const FloatValue& lhs) const
+   Value FloatValue::mul (const FloatValue& lhs) const
     {
-      return std::make_shared<FloatValue>(lhs.value * value);
+      return Value(lhs.value * value);
     }
 
-   std::shared_ptr<ValueType> FloatValue::div (const FloatValue& lhs) const
+   Value FloatValue::div (const FloatValue& lhs) const
     {
-      return std::make_shared<FloatValue>(lhs.value / value);
+      return Value(lhs.value / value);
     }
 
-   std::shared_ptr<ValueType> FloatValue::power (const FloatValue& lhs) const
+   Value FloatValue::power (const FloatValue& lhs) const
     {
-      return std::make_shared<FloatValue>(SlowFloat::SlowFloat(std::pow(static_cast<double>(lhs.value), static_cast<double>(value))));
+      return Value(SlowFloat::pow(lhs.value, value));
     }
 
    bool FloatValue::greater (const FloatValue& lhs) const
@@ -30,6 +30,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Backwards/Types/ValueType.h"
+#include "Backwards/Types/Value.h"
 
 #include "Backwards/Types/FloatValue.h"
 #include "Backwards/Types/StringValue.h"
@@ -45,15 +46,15 @@ namespace Backwards
 namespace Types
  {
 
-   FunctionValue::FunctionValue() : value(nullptr), captures()
+   FunctionValue::FunctionValue() : ValueType(FUNCTION), value(nullptr), captures()
     {
     }
 
-   FunctionValue::FunctionValue(const std::shared_ptr<FunctionObjectHolder>& value, const std::vector<std::shared_ptr<ValueType> >& captures) : value(value), captures(captures)
+   FunctionValue::FunctionValue(const std::shared_ptr<FunctionObjectHolder>& value, const std::vector<std::shared_ptr<ValueType> >& captures) : ValueType(FUNCTION), value(value), captures(captures)
     {
     }
 
-   FunctionValue::FunctionValue(const std::vector<std::shared_ptr<ValueType> >& captures, const std::weak_ptr<FunctionObjectHolder>& value) : valueToo(value), captures(captures)
+   FunctionValue::FunctionValue(const std::vector<std::shared_ptr<ValueType> >& captures, const std::weak_ptr<FunctionObjectHolder>& value) : ValueType(FUNCTION), valueToo(value), captures(captures)
     {
     }
 
@@ -0,0 +1,271 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Backwards/Types/StringContents.h"
+
+#include <algorithm>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace Backwards
+ {
+
+namespace Types
+ {
+
+   StringContents::Piece::Piece(const std::string& text) : length(text.size()), offset(0U), left(), right(), text(text), flat(&this->text)
+    {
+    }
+
+   StringContents::Piece::Piece(const std::shared_ptr<const Piece>& left, const std::shared_ptr<const Piece>& right) :
+      length(left->length + right->length), offset(0U), left(left), right(right), text(), flat(nullptr)
+    {
+    }
+
+   StringContents::Piece::Piece(const std::shared_ptr<const Piece>& base, size_t offset, size_t length) :
+      length(length), offset(offset), left(base), right(), text(), flat(nullptr)
+    {
+    }
+
+   StringContents::Piece::~Piece()
+    {
+      const std::string* built = flat.load(std::memory_order_acquire);
+      if (&text != built)
+       {
+         delete built;
+       }
+
+       // A String built a character at a time is a very long chain of Pieces: tear it down without recursing.
+      std::vector<std::shared_ptr<const Piece> > doomed;
+      doomed.emplace_back(std::move(left));
+      doomed.emplace_back(std::move(right));
+      while (false == doomed.empty())
+       {
+         std::shared_ptr<const Piece> next = std::move(doomed.back());
+         doomed.pop_back();
+         if ((nullptr != next.get()) && (1 == next.use_count()))
+          {
+            doomed.emplace_back(std::move(next->left));
+            doomed.emplace_back(std::move(next->right));
+          }
+       }
+    }
+
+   const std::string& StringContents::Piece::getFlat() const
+    {
+      const std::string* result = flat.load(std::memory_order_acquire);
+      if (nullptr != result)
+       {
+         return *result;
+       }
+
+      std::string* built = new std::string();
+      built->reserve(length);
+      std::vector<std::tuple<const Piece*, size_t, size_t> > work;
+      work.emplace_back(this, 0U, length);
+      while (false == work.empty())
+       {
+         const Piece* next;
+         size_t from, count;
+         std::tie(next, from, count) = work.back();
+         work.pop_back();
+         if (0U == count)
+          {
+            continue;
+          }
+         const std::string* text = next->flat.load(std::memory_order_acquire);
+         if (nullptr != text)
+          {
+            built->append(*text, from, count);
+          }
+         else if (nullptr == next->right.get())
+          {
+            work.emplace_back(next->left.get(), next->offset + from, count);
+          }
+         else if (from >= next->left->length)
+          {
+            work.emplace_back(next->right.get(), from - next->left->length, count);
+          }
+         else
+          {
+            size_t leftCount = std::min(count, next->left->length - from);
+            work.emplace_back(next->right.get(), 0U, count - leftCount);
+            work.emplace_back(next->left.get(), from, leftCount);
+          }
+       }
+
+       // Someone else may have beaten us to it.
+      const std::string* expected = nullptr;
+      if (false == flat.compare_exchange_strong(expected, built, std::memory_order_acq_rel, std::memory_order_acquire))
+       {
+         delete built;
+         return *expected;
+       }
+      return *built;
+    }
+
+   const std::shared_ptr<const StringContents::Piece>& StringContents::getEmpty()
+    {
+      static const std::shared_ptr<const Piece> empty = std::make_shared<Piece>(std::string());
+      return empty;
+    }
+
+   StringContents::StringContents() : piece(getEmpty())
+    {
+    }
+
+   StringContents::StringContents(const std::string& text) : piece((true == text.empty()) ? getEmpty() : std::make_shared<Piece>(text))
+    {
+    }
+
+   StringContents::StringContents(const char* text) : StringContents(std::string(text))
+    {
+    }
+
+   StringContents StringContents::substr(size_t pos, size_t count) const
+    {
+      if (pos > piece->length)
+       {
+         pos = piece->length;
+       }
+      count = std::min(count, piece->length - pos);
+      if (count == piece->length)
+       {
+         return *this;
+       }
+
+      const std::string* text = piece->flat.load(std::memory_order_acquire);
+      if (count < EAGER_LIMIT)
+       {
+         if (nullptr != text)
+          {
+            return StringContents(text->substr(pos, count));
+          }
+         Piece slice (piece, pos, count);
+         return StringContents(slice.getFlat());
+       }
+
+       // Slice the original rather than a slice of it.
+      if ((nullptr == text) && (nullptr == piece->right.get()))
+       {
+         return StringContents(std::make_shared<Piece>(piece->left, piece->offset + pos, count));
+       }
+      return StringContents(std::make_shared<Piece>(piece, pos, count));
+    }
+
+    // A flattened Piece keeps both its Pieces and its flat copy. Building on it would keep every copy
+    // made of a String that is appended to and read in a loop, so build on a leaf of the copy instead.
+   std::shared_ptr<const StringContents::Piece> StringContents::settle(const std::shared_ptr<const Piece>& piece)
+    {
+      const std::string* text = piece->flat.load(std::memory_order_acquire);
+      if ((nullptr != text) && (&piece->text != text))
+       {
+         return std::make_shared<Piece>(*text);
+       }
+      return piece;
+    }
+
+   StringContents StringContents::concat(const StringContents& lhs, const StringContents& rhs)
+    {
+      if (true == lhs.empty())
+       {
+         return rhs;
+       }
+      if (true == rhs.empty())
+       {
+         return lhs;
+       }
+      if (lhs.size() + rhs.size() < EAGER_LIMIT)
+       {
+         return StringContents(lhs.str() + rhs.str());
+       }
+
+       // Appending a little at a time: grow the last little Piece, rather than making a Piece per append.
+      const std::shared_ptr<const Piece>& last = lhs.piece->right;
+      if ((nullptr != last.get()) && (nullptr == lhs.piece->flat.load(std::memory_order_acquire)) && (last->length + rhs.size() < EAGER_LIMIT))
+       {
+         return StringContents(std::make_shared<Piece>(lhs.piece->left, std::make_shared<Piece>(last->getFlat() + rhs.str())));
+       }
+      return StringContents(std::make_shared<Piece>(settle(lhs.piece), settle(rhs.piece)));
+    }
+
+   size_t StringContents::footprint() const
+    {
+      size_t result = 0U;
+      std::set<const Piece*> seen;
+      std::vector<const Piece*> work;
+      work.emplace_back(piece.get());
+      while (false == work.empty())
+       {
+         const Piece* next = work.back();
+         work.pop_back();
+         if ((nullptr == next) || (false == seen.insert(next).second))
+          {
+            continue;
+          }
+         const std::string* text = next->flat.load(std::memory_order_acquire);
+         if (nullptr != text)
+          {
+            result += text->size();
+          }
+         work.emplace_back(next->left.get());
+         work.emplace_back(next->right.get());
+       }
+      return result;
+    }
+
+   int StringContents::compare(const StringContents& rhs) const
+    {
+      if (piece == rhs.piece)
+       {
+         return 0;
+       }
+      return str().compare(rhs.str());
+    }
+
+   bool StringContents::operator== (const StringContents& rhs) const
+    {
+      if (piece == rhs.piece)
+       {
+         return true;
+       }
+      if (piece->length != rhs.piece->length)
+       {
+         return false;
+       }
+      return str() == rhs.str();
+    }
+
+ } // namespace Types
+
+ } // namespace Backwards
@@ -30,6 +30,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Backwards/Types/ValueType.h"
+#include "Backwards/Types/Value.h"
 
 #include "Backwards/Types/FloatValue.h"
 #include "Backwards/Types/StringValue.h"
@@ -38,6 +39,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Types/FunctionValue.h"
 
 #include <functional>
+#include <mutex>
+#include <unordered_map>
 
 namespace Backwards
  {
@@ -45,23 +48,72 @@ namespace Backwards
 namespace Types
  {
 
-   StringValue::StringValue() : value()
+    // The raw pointer says which String an entry is for, as the weak one can't once it has expired.
+   class InternTable final
+    {
+   public:
+      std::mutex lock;
+      std::unordered_map<std::string, std::pair<const StringValue*, std::weak_ptr<StringValue> > > strings;
+
+      static InternTable& getInstance()
+       {
+         static InternTable instance;
+         return instance;
+       }
+    };
+
+   StringValue::StringValue() : ValueType(STRING), hashCode(0U), interned(false), value()
     {
     }
 
-   StringValue::StringValue(const std::string& value) : value(value)
+   StringValue::StringValue(const StringContents& value) : ValueType(STRING), hashCode(0U), interned(false), value(value)
     {
     }
 
+   StringValue::StringValue(const StringValue& src) : ValueType(src), hashCode(src.hashCode.load(std::memory_order_relaxed)), interned(false), value(src.value)
+    {
+    }
+
+   StringValue::~StringValue()
+    {
+      if (true == interned)
+       {
+         InternTable& table = InternTable::getInstance();
+         std::lock_guard<std::mutex> guard (table.lock);
+         auto found = table.strings.find(value.str());
+         if ((table.strings.end() != found) && (this == found->second.first))
+          {
+            table.strings.erase(found);
+          }
+       }
+    }
+
+   std::shared_ptr<StringValue> StringValue::intern(const std::string& value)
+    {
+      InternTable& table = InternTable::getInstance();
+      std::lock_guard<std::mutex> guard (table.lock);
+      std::pair<const StringValue*, std::weak_ptr<StringValue> >& entry = table.strings[value];
+      std::shared_ptr<StringValue> result = entry.second.lock();
+      if (nullptr == result.get())
+       {
+         result = std::make_shared<StringValue>(value);
+         result->interned = true;
+         result->hash();
+         entry.first = result.get();
+         entry.second = result;
+       }
+      return result;
+    }
+
    const std::string& StringValue::getTypeName() const
     {
       static const std::string name ("String");
       return name;
     }
 
-   std::shared_ptr<ValueType> StringValue::add (const StringValue& lhs) const
+   Value StringValue::add (const StringValue& lhs) const
     {
-      return std::make_shared<StringValue>(lhs.value + value);
+      return std::make_shared<StringValue>(StringContents::concat(lhs.value, value));
     }
 
    bool StringValue::greater (const StringValue& lhs) const
@@ -86,12 +138,26 @@ namespace Types
 
    bool StringValue::equal (const StringValue& lhs) const
     {
+      if (this == &lhs)
+       {
+         return true;
+       }
+      if ((true == interned) && (true == lhs.interned))
+       {
+         return false;
+       }
+      size_t lhsHash = lhs.hashCode.load(std::memory_order_relaxed);
+      size_t rhsHash = hashCode.load(std::memory_order_relaxed);
+      if ((0U != lhsHash) && (0U != rhsHash) && (lhsHash != rhsHash))
+       {
+         return false;
+       }
       return lhs.value == value;
     }
 
    bool StringValue::notEqual (const StringValue& lhs) const
     {
-      return lhs.value != value;
+      return false == equal(lhs);
     }
 
    IMPLEMENTVISITOR(StringValue)
@@ -103,7 +169,7 @@ namespace Types
 
    bool StringValue::sort (const StringValue& lhs) const
     {
-      return lhs.value < value;
+      return (this != &lhs) && (lhs.value < value);
     }
 
    bool StringValue::sort (const ArrayValue&) const
@@ -123,7 +189,13 @@ namespace Types
 
    size_t StringValue::hash() const
     {
-      return std::hash<std::string>()(value);
+      size_t result = hashCode.load(std::memory_order_relaxed);
+      if (0U == result)
+       {
+         result = std::hash<std::string>()(value.str());
+         hashCode.store(result, std::memory_order_relaxed);
+       }
+      return result;
     }
 
  } // namespace Types
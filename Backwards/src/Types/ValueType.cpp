@@ -30,6 +30,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Backwards/Types/ValueType.h"
+#include "Backwards/Types/Value.h"
 
 #include "Backwards/Types/FloatValue.h"
 #include "Backwards/Types/StringValue.h"
@@ -43,7 +44,7 @@ namespace Backwards
 namespace Types
  {
 
-   std::shared_ptr<ValueType> ValueType::neg() const
+   Value ValueType::neg() const
     {
       throw TypedOperationException("Error negating " + getTypeName());
     }
@@ -54,27 +55,27 @@ namespace Types
     }
 
 #define DEFINE1(x,y,z) \
-   std::shared_ptr<ValueType> ValueType::x (const FloatValue& lhs) const \
+   Value ValueType::x (const FloatValue& lhs) const \
       { throw TypedOperationException("Error " y " " + lhs.getTypeName() + " " z " " + getTypeName()); } \
-   std::shared_ptr<ValueType> ValueType::x (const StringValue& lhs) const \
+   Value ValueType::x (const StringValue& lhs) const \
       { throw TypedOperationException("Error " y " " + lhs.getTypeName() + " " z " " + getTypeName()); } \
-   std::shared_ptr<ValueType> ValueType::x (const ArrayValue& lhs) const \
+   Value ValueType::x (const ArrayValue& lhs) const \
       { throw TypedOperationException("Error " y " " + lhs.getTypeName() + " " z " " + getTypeName()); } \
-   std::shared_ptr<ValueType> ValueType::x (const DictionaryValue& lhs) const \
+   Value ValueType::x (const DictionaryValue& lhs) const \
       { throw TypedOperationException("Error " y " " + lhs.getTypeName() + " " z " " + getTypeName()); } \
-   std::shared_ptr<ValueType> ValueType::x (const FunctionValue& lhs) const \
+   Value ValueType::x (const FunctionValue& lhs) const \
       { throw TypedOperationException("Error " y " " + lhs.getTypeName() + " " z " " + getTypeName()); }
 
 #define DEFINE2(x,y,z,w) \
-   std::shared_ptr<ValueType> ValueType::x (const FloatValue& lhs) const \
+   Value ValueType::x (const FloatValue& lhs) const \
       { throw TypedOperationException("Error " y " " + lhs.getTypeName() + " " z " " + getTypeName() + " " w); } \
-   std::shared_ptr<ValueType> ValueType::x (const StringValue& lhs) const \
+   Value ValueType::x (const StringValue& lhs) const \
       { throw TypedOperationException("Error " y " " + lhs.getTypeName() + " " z " " + getTypeName() + " " w); } \
-   std::shared_ptr<ValueType> ValueType::x (const ArrayValue& lhs) const \
+   Value ValueType::x (const ArrayValue& lhs) const \
       { throw TypedOperationException("Error " y " " + lhs.getTypeName() + " " z " " + getTypeName() + " " w); } \
-   std::shared_ptr<ValueType> ValueType::x (const DictionaryValue& lhs) const \
+   Value ValueType::x (const DictionaryValue& lhs) const \
       { throw TypedOperationException("Error " y " " + lhs.getTypeName() + " " z " " + getTypeName() + " " w); } \
-   std::shared_ptr<ValueType> ValueType::x (const FunctionValue& lhs) const \
+   Value ValueType::x (const FunctionValue& lhs) const \
       { throw TypedOperationException("Error " y " " + lhs.getTypeName() + " " z " " + getTypeName() + " " w); }
 
 #define DEFINEBOOL(x,y) \
@@ -104,7 +105,7 @@ namespace Types
 
    bool ValueType::compare (const ValueType& rhs) const
     {
-      if (typeid(*this) != typeid(rhs))
+      if (type != rhs.type)
        {
          return false;
        }
@@ -37,6 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backway/State.h"
 #include "Backway/Environment.h"
 #include "Backway/ContextBuilder.h"
+#include "Backway/Scheduler.h"
 
 #include "Backwards/Types/FloatValue.h"
 #include "Backwards/Types/StringValue.h"
@@ -48,6 +49,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Engine/FatalException.h"
 #include "Backwards/Engine/DebuggerHook.h"
 
+#include "Backwards/Parser/ContextBuilder.h"
+
 class ConsoleLogger final : public Backwards::Engine::Logger
  {
 public:
@@ -477,3 +480,99 @@ TEST(BackwayTests, testDuplicate)
    EXPECT_EQ(&machine, res->machine);
    EXPECT_EQ(&environment, res->environment);
  }
+
+class SilentLogger final : public Backwards::Engine::Logger
+ {
+public:
+   void log (const std::string&) { }
+   std::string get () { return ""; }
+ };
+
+class TestCommand final : public Backway::Command
+ {
+public:
+   SlowFloat::SlowFloat value;
+   TestCommand(const SlowFloat::SlowFloat& value) : value(value) { }
+ };
+
+std::shared_ptr<Backwards::Types::ValueType> Emit (Backwards::Engine::CallingContext& context, const std::shared_ptr<Backwards::Types::ValueType>& arg)
+ {
+   Backway::CallingContext& text = dynamic_cast<Backway::CallingContext&>(context);
+   text.machine->output = std::make_shared<TestCommand>(dynamic_cast<const Backwards::Types::FloatValue&>(*arg).value);
+   return arg;
+ }
+
+TEST(BackwayTests, testScheduler)
+ {
+   Backway::CallingContext context;
+   Backway::Environment environment;
+   context.environment = &environment;
+   Backwards::Engine::Scope global;
+   context.globalScope = &global;
+   SilentLogger logger;
+   context.logger = &logger;
+   context.debugger = nullptr;
+
+   Backway::ContextBuilder::createGlobalScope(global);
+   Backwards::Parser::ContextBuilder::addFunction("Emit", std::make_shared<Backwards::Engine::StandardUnaryFunctionWithContext>(Emit), 1U, global);
+
+   Backway::StateMachine setup;
+   context.machine = &setup;
+    // Every Agent redefines a state on its first update, while the others are reading states.
+   Backway::CreateState(context, std::make_shared<Backwards::Types::StringValue>("Agent"), std::make_shared<Backwards::Types::StringValue>(
+      "set N to 0 set Update to function update (arg) is set N to N + 1 "
+      "if N = 1 & GetInput() < 10 then call SetRoundMode(2) end "
+      "if N = 1 then call CreateState('Again'; 'set Update to function update (arg) is return arg end') end "
+      "if N = 2 then call Emit(1 / 3) else call Emit(GetInput()) end "
+      "if N = 3 then call Leave() end return arg end"));
+   Backway::CreateState(context, std::make_shared<Backwards::Types::StringValue>("Bad"), std::make_shared<Backwards::Types::StringValue>(
+      "set Update to function update (arg) is return -'hello' end"));
+
+   const size_t COUNT = 100U;
+   const size_t BAD = 42U;
+   Backway::Scheduler scheduler (4U);
+   for (size_t i = 0U; i < COUNT; ++i)
+    {
+      std::shared_ptr<Backway::StateMachine> machine = std::make_shared<Backway::StateMachine>();
+      machine->input = std::make_shared<Backwards::Types::FloatValue>(SlowFloat::SlowFloat(static_cast<double>(i)));
+      context.machine = machine.get();
+      Backway::Push(context, std::make_shared<Backwards::Types::StringValue>((BAD == i) ? "Bad" : "Agent"));
+      EXPECT_EQ(i, scheduler.add(machine, context));
+    }
+   EXPECT_EQ(COUNT, scheduler.size());
+
+   EXPECT_ANY_THROW(scheduler.tick());
+   std::vector<std::shared_ptr<Backway::Command> > outputs = scheduler.getOutputs();
+   ASSERT_EQ(COUNT - 1U, outputs.size());
+   for (size_t i = 0U; i < COUNT; ++i)
+    {
+      if (BAD == i)
+       {
+         EXPECT_NE(nullptr, scheduler.get(i).error);
+         EXPECT_EQ(nullptr, scheduler.get(i).output.get());
+         continue;
+       }
+      EXPECT_EQ(nullptr, scheduler.get(i).error);
+      EXPECT_TRUE(scheduler.get(i).running);
+      EXPECT_EQ(static_cast<double>(i), static_cast<double>(std::dynamic_pointer_cast<TestCommand>(outputs[(i < BAD) ? i : i - 1U])->value));
+    }
+   scheduler.get(BAD).machine->states.clear();
+
+    // Each machine keeps its own rounding mode, whichever thread runs it.
+   scheduler.tick();
+   EXPECT_EQ(SlowFloat::ROUND_TIES_EVEN, SlowFloat::mode);
+   for (size_t i = 0U; i < COUNT; ++i)
+    {
+      if (BAD != i)
+       {
+         EXPECT_EQ((i < 10U) ? 333333334U : 333333333U, std::dynamic_pointer_cast<TestCommand>(scheduler.get(i).output)->value.significand);
+       }
+    }
+
+   scheduler.tick();
+   EXPECT_EQ(COUNT - 1U, scheduler.getOutputs().size());
+   for (size_t i = 0U; i < COUNT; ++i)
+    {
+      EXPECT_FALSE(scheduler.get(i).running);
+    }
+ }
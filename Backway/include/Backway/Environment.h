@@ -37,6 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <string>
 #include <map>
+#include <shared_mutex>
 
 namespace Backway
  {
@@ -44,8 +45,15 @@ namespace Backway
    class Environment
    {
    public:
+       // Fill states directly while setting up. Once machines are running (maybe on several threads), go through getState and setState.
       std::map<std::string, std::shared_ptr<State> > states;
       Backwards::Engine::Scope global;
+
+      std::shared_ptr<State> getState (const std::string& name) const; // Returns NULL if there is no such state.
+      bool setState (const std::string& name, const std::shared_ptr<State>& state); // Returns whether an existing state was replaced.
+
+   private:
+      mutable std::shared_mutex statesLock;
    };
 
  } // namespace Backway
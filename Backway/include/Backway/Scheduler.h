@@ -0,0 +1,121 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BACKWAY_SCHEDULER_H
+#define BACKWAY_SCHEDULER_H
+
+#include "Backway/CallingContext.h"
+#include "Backway/StateMachine.h"
+
+#include "SlowFloat.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Backway
+ {
+
+    /*
+      Updates many StateMachines in parallel, once per tick.
+
+      Each machine runs with its own copy of the CallingContext it was added with, and its own rounding mode.
+      The machines are split evenly between the threads; a thread that runs out of machines takes the next
+      machine from another thread's share. Every tick finishes before tick() returns, and the results are
+      reported in the order that the machines were added, no matter which thread ran them.
+
+      Machines on different threads share the Environment and the global scope. Environment states are
+      safe to read and create concurrently. Globals are not: scripts run by a Scheduler should only read them.
+      The Logger and DebuggerHook in a context are also called from worker threads.
+    */
+   class Scheduler final
+    {
+   public:
+      class Agent final
+       {
+      public:
+         std::shared_ptr<StateMachine> machine;
+         CallingContext context;
+         SlowFloat::SlowFloat_Round_Mode mode;
+
+         bool running; // Results of the last tick.
+         std::shared_ptr<Command> output;
+         std::exception_ptr error;
+
+         Agent(const std::shared_ptr<StateMachine>&, const CallingContext&);
+       };
+
+      explicit Scheduler(size_t threads = 0U); // The number of threads, including the one calling tick. Zero means one per core.
+      ~Scheduler();
+
+      Scheduler(const Scheduler&) = delete;
+      Scheduler& operator=(const Scheduler&) = delete;
+
+      size_t add (const std::shared_ptr<StateMachine>& machine, const CallingContext& context); // Returns the machine's index.
+      const Agent& get (size_t index) const;
+      size_t size () const;
+
+       // Update every machine once. If any machine threw, the exception from the first one is rethrown
+       // after all of the machines have finished. The other machines' results are still valid.
+      void tick ();
+
+      std::vector<std::shared_ptr<Command> > getOutputs () const; // The output of every machine that had one, in order.
+
+   private:
+      class Share final
+       {
+      public:
+         std::atomic<size_t> next;
+         size_t end;
+       };
+
+      std::vector<Agent> agents;
+      std::vector<Share> shares;
+      std::vector<std::thread> workers;
+
+      std::mutex lock;
+      std::condition_variable wake;
+      std::condition_variable done;
+      size_t generation;
+      size_t working;
+      bool stopping;
+
+      void work (size_t first);
+      void workerLoop (size_t first);
+      static void run (Agent&);
+    };
+
+ } // namespace Backway
+
+#endif /* BACKWAY_SCHEDULER_H */
@@ -68,7 +68,7 @@ namespace Backway
    public:
       BinaryFunctionPointerWithContext function;
       StandardBinaryFunctionWithContext(BinaryFunctionPointerWithContext);
-      std::shared_ptr<Backwards::Engine::FlowControl> execute (Backwards::Engine::CallingContext&) const;
+      Backwards::Engine::FlowControl execute (Backwards::Engine::CallingContext&) const;
     };
 
 #define STDLIB_BINARY_DECL_WITH_CONTEXT(x) \
@@ -0,0 +1,63 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Backway/Environment.h"
+
+#include <mutex>
+
+namespace Backway
+ {
+
+   std::shared_ptr<State> Environment::getState (const std::string& name) const
+    {
+      std::shared_lock<std::shared_mutex> guard (statesLock);
+      std::map<std::string, std::shared_ptr<State> >::const_iterator iter = states.find(name);
+      if (states.end() == iter)
+       {
+         return std::shared_ptr<State>();
+       }
+      return iter->second;
+    }
+
+   bool Environment::setState (const std::string& name, const std::shared_ptr<State>& state)
+    {
+      std::unique_lock<std::shared_mutex> guard (statesLock);
+      std::map<std::string, std::shared_ptr<State> >::iterator iter = states.find(name);
+      if (states.end() != iter)
+       {
+         iter->second = state;
+         return true;
+       }
+      states.emplace(name, state);
+      return false;
+    }
+
+ } // namespace Backway
@@ -0,0 +1,201 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Backway/Scheduler.h"
+
+namespace Backway
+ {
+
+   Scheduler::Agent::Agent(const std::shared_ptr<StateMachine>& machine, const CallingContext& context) :
+      machine(machine), context(context), mode(SlowFloat::ROUND_TIES_EVEN), running(false), output(), error()
+    {
+      this->context.machine = machine.get();
+    }
+
+   Scheduler::Scheduler(size_t threads) : shares(), generation(0U), working(0U), stopping(false)
+    {
+      if (0U == threads)
+       {
+         threads = std::thread::hardware_concurrency();
+       }
+      if (0U == threads)
+       {
+         threads = 1U;
+       }
+
+       // Share 0 belongs to the thread calling tick.
+      std::vector<Share> temp (threads);
+      shares.swap(temp);
+      for (size_t i = 1U; i < threads; ++i)
+       {
+         workers.emplace_back(&Scheduler::workerLoop, this, i);
+       }
+    }
+
+   Scheduler::~Scheduler()
+    {
+       {
+         std::lock_guard<std::mutex> guard (lock);
+         stopping = true;
+       }
+      wake.notify_all();
+      for (auto& worker : workers)
+       {
+         worker.join();
+       }
+    }
+
+   size_t Scheduler::add (const std::shared_ptr<StateMachine>& machine, const CallingContext& context)
+    {
+      agents.emplace_back(machine, context);
+      return agents.size() - 1U;
+    }
+
+   const Scheduler::Agent& Scheduler::get (size_t index) const
+    {
+      return agents[index];
+    }
+
+   size_t Scheduler::size () const
+    {
+      return agents.size();
+    }
+
+   void Scheduler::tick ()
+    {
+      const size_t count = agents.size();
+      const size_t threads = shares.size();
+      for (size_t i = 0U; i < threads; ++i)
+       {
+         shares[i].next.store(count * i / threads, std::memory_order_relaxed);
+         shares[i].end = count * (i + 1U) / threads;
+       }
+
+       {
+         std::lock_guard<std::mutex> guard (lock);
+         ++generation;
+         working = workers.size();
+       }
+      wake.notify_all();
+
+      work(0U);
+
+       {
+         std::unique_lock<std::mutex> guard (lock);
+         done.wait(guard, [this] () { return 0U == working; });
+       }
+
+      for (const auto& agent : agents)
+       {
+         if (nullptr != agent.error)
+          {
+            std::rethrow_exception(agent.error);
+          }
+       }
+    }
+
+   std::vector<std::shared_ptr<Command> > Scheduler::getOutputs () const
+    {
+      std::vector<std::shared_ptr<Command> > result;
+      for (const auto& agent : agents)
+       {
+         if (nullptr != agent.output.get())
+          {
+            result.emplace_back(agent.output);
+          }
+       }
+      return result;
+    }
+
+   void Scheduler::work (size_t first)
+    {
+       // Finish our own share, then help with everyone else's.
+      const size_t threads = shares.size();
+      for (size_t i = 0U; i < threads; ++i)
+       {
+         Share& share = shares[(first + i) % threads];
+         for (size_t index = share.next.fetch_add(1U); index < share.end; index = share.next.fetch_add(1U))
+          {
+            run(agents[index]);
+          }
+       }
+    }
+
+   void Scheduler::workerLoop (size_t first)
+    {
+      size_t seen = 0U;
+      for (;;)
+       {
+          {
+            std::unique_lock<std::mutex> guard (lock);
+            wake.wait(guard, [this, seen] () { return (true == stopping) || (seen != generation); });
+            if (true == stopping)
+             {
+               return;
+             }
+            seen = generation;
+          }
+
+         work(first);
+
+          {
+            std::lock_guard<std::mutex> guard (lock);
+            --working;
+            if (0U == working)
+             {
+               done.notify_one();
+             }
+          }
+       }
+    }
+
+   void Scheduler::run (Agent& agent)
+    {
+       // The rounding mode belongs to the machine, not whichever thread happens to run it.
+      SlowFloat::SlowFloat_Round_Mode saved = SlowFloat::mode;
+      SlowFloat::mode = agent.mode;
+      try
+       {
+         agent.running = agent.machine->update(agent.context);
+         agent.output = agent.machine->output;
+         agent.error = nullptr;
+       }
+      catch (...)
+       {
+         agent.running = false == agent.machine->states.empty();
+         agent.output = std::shared_ptr<Command>();
+         agent.error = std::current_exception();
+       }
+      agent.mode = SlowFloat::mode;
+      SlowFloat::mode = saved;
+    }
+
+ } // namespace Backway
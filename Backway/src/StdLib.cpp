@@ -184,10 +184,10 @@ namespace Backway
       try
        {
          CallingContext& text = dynamic_cast<CallingContext&>(context);
-         if (typeid(Backwards::Types::StringValue) == typeid(*arg))
+         if (Backwards::Types::ValueType::STRING == arg->getType())
           {
             const std::string& name = static_cast<const Backwards::Types::StringValue&>(*arg).value;
-            if (text.environment->states.end() == text.environment->states.find(name))
+            if (nullptr == text.environment->getState(name).get())
              {
                throw Backwards::Types::TypedOperationException("Error enqueueing state: no such state.");
              }
@@ -195,19 +195,19 @@ namespace Backway
              {
                text.machine->states.emplace_back(std::list<std::shared_ptr<State> >());
              }
-            std::shared_ptr<State> added = std::make_shared<State>(*(text.environment->states.find(name)->second));
+            std::shared_ptr<State> added = std::make_shared<State>(*text.environment->getState(name));
             text.machine->states.back().emplace_back(added);
           }
-         else if (typeid(Backwards::Types::ArrayValue) == typeid(*arg))
+         else if (Backwards::Types::ValueType::ARRAY == arg->getType())
           {
-            const std::vector<std::shared_ptr<Backwards::Types::ValueType> >& array = static_cast<const Backwards::Types::ArrayValue&>(*arg).value;
+            const Backwards::Types::ArrayElements& array = static_cast<const Backwards::Types::ArrayValue&>(*arg).value;
             // Double loop : machine state is not modified if an exception is thrown.
             for (const auto& item : array)
              {
-               if (typeid(Backwards::Types::StringValue) == typeid(*item))
+               if (Backwards::Types::ValueType::STRING == item->getType())
                 {
                   const std::string& name = static_cast<const Backwards::Types::StringValue&>(*item).value;
-                  if (text.environment->states.end() == text.environment->states.find(name))
+                  if (nullptr == text.environment->getState(name).get())
                    {
                      throw Backwards::Types::TypedOperationException("Error enqueueing state: no such state.");
                    }
@@ -224,7 +224,7 @@ namespace Backway
             for (const auto& item : array)
              {
                const std::string& name = static_cast<const Backwards::Types::StringValue&>(*item).value;
-               std::shared_ptr<State> added = std::make_shared<State>(*(text.environment->states.find(name)->second));
+               std::shared_ptr<State> added = std::make_shared<State>(*text.environment->getState(name));
                text.machine->states.back().emplace_back(added);
              }
           }
@@ -245,27 +245,27 @@ namespace Backway
       try
        {
          CallingContext& text = dynamic_cast<CallingContext&>(context);
-         if (typeid(Backwards::Types::StringValue) == typeid(*arg))
+         if (Backwards::Types::ValueType::STRING == arg->getType())
           {
             const std::string& name = static_cast<const Backwards::Types::StringValue&>(*arg).value;
-            if (text.environment->states.end() == text.environment->states.find(name))
+            if (nullptr == text.environment->getState(name).get())
              {
                throw Backwards::Types::TypedOperationException("Error making final state: no such state.");
              }
             text.machine->states.emplace_front(std::list<std::shared_ptr<State> >());
-            std::shared_ptr<State> added = std::make_shared<State>(*(text.environment->states.find(name)->second));
+            std::shared_ptr<State> added = std::make_shared<State>(*text.environment->getState(name));
             text.machine->states.front().emplace_back(added);
           }
-         else if (typeid(Backwards::Types::ArrayValue) == typeid(*arg))
+         else if (Backwards::Types::ValueType::ARRAY == arg->getType())
           {
-            const std::vector<std::shared_ptr<Backwards::Types::ValueType> >& array = static_cast<const Backwards::Types::ArrayValue&>(*arg).value;
+            const Backwards::Types::ArrayElements& array = static_cast<const Backwards::Types::ArrayValue&>(*arg).value;
             // Double loop : machine state is not modified if an exception is thrown.
             for (const auto& item : array)
              {
-               if (typeid(Backwards::Types::StringValue) == typeid(*item))
+               if (Backwards::Types::ValueType::STRING == item->getType())
                 {
                   const std::string& name = static_cast<const Backwards::Types::StringValue&>(*item).value;
-                  if (text.environment->states.end() == text.environment->states.find(name))
+                  if (nullptr == text.environment->getState(name).get())
                    {
                      throw Backwards::Types::TypedOperationException("Error making final state: no such state.");
                    }
@@ -279,7 +279,7 @@ namespace Backway
             for (const auto& item : array)
              {
                const std::string& name = static_cast<const Backwards::Types::StringValue&>(*item).value;
-               std::shared_ptr<State> added = std::make_shared<State>(*(text.environment->states.find(name)->second));
+               std::shared_ptr<State> added = std::make_shared<State>(*text.environment->getState(name));
                text.machine->states.front().emplace_back(added);
              }
           }
@@ -300,10 +300,10 @@ namespace Backway
       try
        {
          CallingContext& text = dynamic_cast<CallingContext&>(context);
-         if (typeid(Backwards::Types::StringValue) == typeid(*arg))
+         if (Backwards::Types::ValueType::STRING == arg->getType())
           {
             const std::string& name = static_cast<const Backwards::Types::StringValue&>(*arg).value;
-            if (text.environment->states.end() == text.environment->states.find(name))
+            if (nullptr == text.environment->getState(name).get())
              {
                throw Backwards::Types::TypedOperationException("Error following state: no such state.");
              }
@@ -311,7 +311,7 @@ namespace Backway
              {
                text.machine->states.emplace_back(std::list<std::shared_ptr<State> >());
              }
-            std::shared_ptr<State> added = std::make_shared<State>(*(text.environment->states.find(name)->second));
+            std::shared_ptr<State> added = std::make_shared<State>(*text.environment->getState(name));
             if (false == text.machine->states.back().empty())
              {
                text.machine->states.back().emplace(++text.machine->states.back().begin(), added);
@@ -321,16 +321,16 @@ namespace Backway
                text.machine->states.back().emplace_back(added);
              }
           }
-         else if (typeid(Backwards::Types::ArrayValue) == typeid(*arg))
+         else if (Backwards::Types::ValueType::ARRAY == arg->getType())
           {
-            const std::vector<std::shared_ptr<Backwards::Types::ValueType> >& array = static_cast<const Backwards::Types::ArrayValue&>(*arg).value;
+            const Backwards::Types::ArrayElements& array = static_cast<const Backwards::Types::ArrayValue&>(*arg).value;
             // Double loop : machine state is not modified if an exception is thrown.
             for (const auto& item : array)
              {
-               if (typeid(Backwards::Types::StringValue) == typeid(*item))
+               if (Backwards::Types::ValueType::STRING == item->getType())
                 {
                   const std::string& name = static_cast<const Backwards::Types::StringValue&>(*item).value;
-                  if (text.environment->states.end() == text.environment->states.find(name))
+                  if (nullptr == text.environment->getState(name).get())
                    {
                      throw Backwards::Types::TypedOperationException("Error following state: no such state.");
                    }
@@ -346,7 +346,7 @@ namespace Backway
                for (const auto& item : array)
                 {
                   const std::string& name = static_cast<const Backwards::Types::StringValue&>(*item).value;
-                  std::shared_ptr<State> added = std::make_shared<State>(*(text.environment->states.find(name)->second));
+                  std::shared_ptr<State> added = std::make_shared<State>(*text.environment->getState(name));
                   text.machine->states.back().emplace_back(added);
                 }
              }
@@ -355,7 +355,7 @@ namespace Backway
                for (size_t iter = array.size(); iter > 0; --iter) // Looks a little strange, but iterate from size to one so we don't go negative.
                 { // And go backwards so that the array is forwards in the queue.
                   const std::string& name = static_cast<const Backwards::Types::StringValue&>(*array[iter - 1]).value;
-                  std::shared_ptr<State> added = std::make_shared<State>(*(text.environment->states.find(name)->second));
+                  std::shared_ptr<State> added = std::make_shared<State>(*text.environment->getState(name));
                   text.machine->states.back().emplace(++text.machine->states.back().begin(), added);
                 }
              }
@@ -377,10 +377,10 @@ namespace Backway
       try
        {
          CallingContext& text = dynamic_cast<CallingContext&>(context);
-         if (typeid(Backwards::Types::StringValue) == typeid(*arg))
+         if (Backwards::Types::ValueType::STRING == arg->getType())
           {
             const std::string& name = static_cast<const Backwards::Types::StringValue&>(*arg).value;
-            if (text.environment->states.end() == text.environment->states.find(name))
+            if (nullptr == text.environment->getState(name).get())
              {
                throw Backwards::Types::TypedOperationException("Error injecting state: no such state.");
              }
@@ -395,18 +395,18 @@ namespace Backway
                text.machine->states.emplace_back(std::list<std::shared_ptr<State> >());
                spot = &(text.machine->states.back());
              }
-            std::shared_ptr<State> added = std::make_shared<State>(*(text.environment->states.find(name)->second));
+            std::shared_ptr<State> added = std::make_shared<State>(*text.environment->getState(name));
             spot->emplace_back(added);
           }
-         else if (typeid(Backwards::Types::ArrayValue) == typeid(*arg))
+         else if (Backwards::Types::ValueType::ARRAY == arg->getType())
           {
-            const std::vector<std::shared_ptr<Backwards::Types::ValueType> >& array = static_cast<const Backwards::Types::ArrayValue&>(*arg).value;
+            const Backwards::Types::ArrayElements& array = static_cast<const Backwards::Types::ArrayValue&>(*arg).value;
             for (const auto& item : array)
              {
-               if (typeid(Backwards::Types::StringValue) == typeid(*item))
+               if (Backwards::Types::ValueType::STRING == item->getType())
                 {
                   const std::string& name = static_cast<const Backwards::Types::StringValue&>(*item).value;
-                  if (text.environment->states.end() == text.environment->states.find(name))
+                  if (nullptr == text.environment->getState(name).get())
                    {
                      throw Backwards::Types::TypedOperationException("Error injecting state: no such state.");
                    }
@@ -430,7 +430,7 @@ namespace Backway
             for (const auto& item : array)
              {
                const std::string& name = static_cast<const Backwards::Types::StringValue&>(*item).value;
-               std::shared_ptr<State> added = std::make_shared<State>(*(text.environment->states.find(name)->second));
+               std::shared_ptr<State> added = std::make_shared<State>(*text.environment->getState(name));
                spot->emplace_back(added);
              }
           }
@@ -451,10 +451,10 @@ namespace Backway
       try
        {
          CallingContext& text = dynamic_cast<CallingContext&>(context);
-         if (typeid(Backwards::Types::StringValue) == typeid(*arg))
+         if (Backwards::Types::ValueType::STRING == arg->getType())
           {
             const std::string& name = static_cast<const Backwards::Types::StringValue&>(*arg).value;
-            if (text.environment->states.end() == text.environment->states.find(name))
+            if (nullptr == text.environment->getState(name).get())
              {
                throw Backwards::Types::TypedOperationException("Error preceding state: no such state.");
              }
@@ -462,19 +462,19 @@ namespace Backway
              {
                text.machine->states.emplace_back(std::list<std::shared_ptr<State> >());
              }
-            std::shared_ptr<State> added = std::make_shared<State>(*(text.environment->states.find(name)->second));
+            std::shared_ptr<State> added = std::make_shared<State>(*text.environment->getState(name));
             text.machine->states.back().emplace_front(added);
           }
-         else if (typeid(Backwards::Types::ArrayValue) == typeid(*arg))
+         else if (Backwards::Types::ValueType::ARRAY == arg->getType())
           {
-            const std::vector<std::shared_ptr<Backwards::Types::ValueType> >& array = static_cast<const Backwards::Types::ArrayValue&>(*arg).value;
+            const Backwards::Types::ArrayElements& array = static_cast<const Backwards::Types::ArrayValue&>(*arg).value;
             // Double loop : machine state is not modified if an exception is thrown.
             for (const auto& item : array)
              {
-               if (typeid(Backwards::Types::StringValue) == typeid(*item))
+               if (Backwards::Types::ValueType::STRING == item->getType())
                 {
                   const std::string& name = static_cast<const Backwards::Types::StringValue&>(*item).value;
-                  if (text.environment->states.end() == text.environment->states.find(name))
+                  if (nullptr == text.environment->getState(name).get())
                    {
                      throw Backwards::Types::TypedOperationException("Error preceding state: no such state.");
                    }
@@ -491,7 +491,7 @@ namespace Backway
             for (size_t iter = array.size(); iter > 0; --iter) // Looks a little strange, but iterate from size to one so we don't go negative.
              {
                const std::string& name = static_cast<const Backwards::Types::StringValue&>(*array[iter - 1]).value;
-               std::shared_ptr<State> added = std::make_shared<State>(*(text.environment->states.find(name)->second));
+               std::shared_ptr<State> added = std::make_shared<State>(*text.environment->getState(name));
                text.machine->states.back().emplace_front(added);
              }
           }
@@ -512,27 +512,27 @@ namespace Backway
       try
        {
          CallingContext& text = dynamic_cast<CallingContext&>(context);
-         if (typeid(Backwards::Types::StringValue) == typeid(*arg))
+         if (Backwards::Types::ValueType::STRING == arg->getType())
           {
             const std::string& name = static_cast<const Backwards::Types::StringValue&>(*arg).value;
-            if (text.environment->states.end() == text.environment->states.find(name))
+            if (nullptr == text.environment->getState(name).get())
              {
                throw Backwards::Types::TypedOperationException("Error pushing state: no such state.");
              }
-            std::shared_ptr<State> added = std::make_shared<State>(*(text.environment->states.find(name)->second));
+            std::shared_ptr<State> added = std::make_shared<State>(*text.environment->getState(name));
             text.machine->states.emplace_back(std::list<std::shared_ptr<State> >());
             text.machine->states.back().emplace_back(added);
           }
-         else if (typeid(Backwards::Types::ArrayValue) == typeid(*arg))
+         else if (Backwards::Types::ValueType::ARRAY == arg->getType())
           {
-            const std::vector<std::shared_ptr<Backwards::Types::ValueType> >& array = static_cast<const Backwards::Types::ArrayValue&>(*arg).value;
+            const Backwards::Types::ArrayElements& array = static_cast<const Backwards::Types::ArrayValue&>(*arg).value;
             // Double loop : machine state is not modified if an exception is thrown.
             for (const auto& item : array)
              {
-               if (typeid(Backwards::Types::StringValue) == typeid(*item))
+               if (Backwards::Types::ValueType::STRING == item->getType())
                 {
                   const std::string& name = static_cast<const Backwards::Types::StringValue&>(*item).value;
-                  if (text.environment->states.end() == text.environment->states.find(name))
+                  if (nullptr == text.environment->getState(name).get())
                    {
                      throw Backwards::Types::TypedOperationException("Error pushing state: no such state.");
                    }
@@ -546,7 +546,7 @@ namespace Backway
             for (const auto& item : array)
              {
                const std::string& name = static_cast<const Backwards::Types::StringValue&>(*item).value;
-               std::shared_ptr<State> added = std::make_shared<State>(*(text.environment->states.find(name)->second));
+               std::shared_ptr<State> added = std::make_shared<State>(*text.environment->getState(name));
                text.machine->states.back().emplace_back(added);
              }
           }
@@ -567,7 +567,7 @@ namespace Backway
       try
        {
          CallingContext& text = dynamic_cast<CallingContext&>(context);
-         if (typeid(Backwards::Types::StringValue) == typeid(*arg))
+         if (Backwards::Types::ValueType::STRING == arg->getType())
           {
             const std::string& name = static_cast<const Backwards::Types::StringValue&>(*arg).value;
             bool found = false;
@@ -605,7 +605,7 @@ namespace Backway
       try
        {
          CallingContext& text = dynamic_cast<CallingContext&>(context);
-         if (typeid(Backwards::Types::StringValue) == typeid(*arg))
+         if (Backwards::Types::ValueType::STRING == arg->getType())
           {
             const std::string& name = static_cast<const Backwards::Types::StringValue&>(*arg).value;
             bool found = false;
@@ -643,17 +643,13 @@ namespace Backway
       try
        {
          CallingContext& text = dynamic_cast<CallingContext&>(context);
-         if (typeid(Backwards::Types::StringValue) == typeid(*first))
+         if (Backwards::Types::ValueType::STRING == first->getType())
           {
-            if (typeid(Backwards::Types::StringValue) == typeid(*second))
+            if (Backwards::Types::ValueType::STRING == second->getType())
              {
                const std::string& name = static_cast<const Backwards::Types::StringValue&>(*first).value;
                const std::string& functions = static_cast<const Backwards::Types::StringValue&>(*second).value;
                bool overwritten = false;
-               if (text.environment->states.end() != text.environment->states.find(name))
-                {
-                  overwritten = true;
-                }
 
                std::shared_ptr<State> newState = std::make_shared<State>();
                newState->scope.name = name;
@@ -672,8 +668,8 @@ namespace Backway
                   context.pushScope(&newState->scope);
                   try
                    {
-                     std::shared_ptr<Backwards::Engine::FlowControl> result = res->execute(context);
-                     if (nullptr != result)
+                     Backwards::Engine::FlowControl result = res->execute(context);
+                     if (Backwards::Engine::FlowControl::NONE != result.type)
                       {
                         throw Backwards::Engine::ProgrammingException("Result was not null in CreateState.");
                       }
@@ -684,11 +680,7 @@ namespace Backway
                       }
                      newState->updateFun = std::make_shared<Backwards::Engine::Variable>(Backwards::Input::Token(), table.getVariableGetter("Update"));
 
-                     std::map<std::string, std::shared_ptr<State> >::iterator iter = text.environment->states.find(name);
-                     if (text.environment->states.end() != iter)
-                        iter->second = newState;
-                     else
-                        text.environment->states.emplace(name, newState);
+                     overwritten = text.environment->setState(name, newState);
                    }
                   catch (...)
                    {
@@ -726,13 +718,13 @@ namespace Backway
     {
     }
 
-   std::shared_ptr<Backwards::Engine::FlowControl> StandardBinaryFunctionWithContext::execute (Backwards::Engine::CallingContext& context) const
+   Backwards::Engine::FlowControl StandardBinaryFunctionWithContext::execute (Backwards::Engine::CallingContext& context) const
     {
       std::shared_ptr<Backwards::Types::ValueType> lhs = context.currentFrame->args[0U];
       std::shared_ptr<Backwards::Types::ValueType> rhs = context.currentFrame->args[1U];
       try
        {
-         return std::make_shared<Backwards::Engine::FlowControl>(token, Backwards::Engine::FlowControl::RETURN, Backwards::Engine::FlowControl::NO_TARGET, function(context, lhs, rhs));
+         return Backwards::Engine::FlowControl(token, Backwards::Engine::FlowControl::RETURN, Backwards::Engine::FlowControl::NO_TARGET, function(context, lhs, rhs));
        }
       catch (const Backwards::Types::TypedOperationException& e)
        {
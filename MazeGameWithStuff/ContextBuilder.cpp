@@ -167,7 +167,7 @@ STDLIB_UNARY_DECL_WITH_CONTEXT(Load)
              {
                if (typeid(Backwards::Types::DictionaryValue) == typeid(*val))
                 {
-                  for (std::map<std::shared_ptr<Backwards::Types::ValueType>, std::shared_ptr<Backwards::Types::ValueType>, Backwards::Types::ChristHowHorrifying>::const_iterator iter =
+                  for (Backwards::Types::DictionaryMap::const_iterator iter =
                      static_cast<const Backwards::Types::DictionaryValue&>(*val).value.begin();
                      static_cast<const Backwards::Types::DictionaryValue&>(*val).value.end() != iter; ++iter)
                    {
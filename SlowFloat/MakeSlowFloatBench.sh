@@ -0,0 +1,13 @@
+#!/bin/sh -x
+
+rm -f SlowFloat.o
+rm -f SlowFloatBench.exe
+
+if [ "$1" == "clean" ]; then
+   exit
+fi
+
+g++ -Wall -Wextra -Wpedantic -s -O3 -c SlowFloat.cpp
+
+g++ -o SlowFloatBench -Wall -Wextra -Wpedantic -s -O3 SlowFloatBench.cpp SlowFloat.o
+./SlowFloatBench.exe > SlowFloatBench.csv
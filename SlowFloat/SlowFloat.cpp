@@ -32,6 +32,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SlowFloat.h"
 
 #include <cmath>
+#include <cstring>
+#include <limits>
 
 #include <sstream>
 #include <iomanip>
@@ -95,7 +97,7 @@ bool getSign (const SlowFloat& arg)
    // Table of powers of ten up to CUTOFF. (Yes, there is an extra entry, for the -1 case that needs to return 1.)
 const uint64_t makeShift [] = { 1U, 1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U, 100000000U, 1000000000U };
 
-SlowFloat_Round_Mode mode = ROUND_TIES_EVEN;
+thread_local SlowFloat_Round_Mode mode = ROUND_TIES_EVEN;
 
    // This code is suspiciously familiar....
 // sign - sign of result (true is negative)
@@ -134,45 +136,380 @@ bool decideRound (bool sign, bool even, int64_t comp, bool zero)
    return false;
  }
 
-SlowFloat::SlowFloat(uint32_t significand, int16_t exponent) : significand(significand), exponent(exponent)
+   // Powers of ten that fit in a uint64_t.
+static const uint64_t POWERS_OF_TEN [] =
+ {
+   1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U, 100000000U, 1000000000U,
+   10000000000U, 100000000000U, 1000000000000U, 10000000000000U, 100000000000000U,
+   1000000000000000U, 10000000000000000U, 100000000000000000U, 1000000000000000000U,
+   10000000000000000000U
+ };
+
+   // Powers of ten that are exact doubles.
+static const double DOUBLE_POWERS_OF_TEN [] =
+ {
+   1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+   1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+ };
+
+static int bitLength (uint64_t arg)
+ {
+   int result = 0;
+   for (int bits = 32; bits > 0; bits /= 2)
+    {
+      if (0 != (arg >> bits))
+       {
+         result += bits;
+         arg >>= bits;
+       }
+    }
+   return result + static_cast<int>(arg);
+ }
+
+   // Bits needed to hold 10^n, rounded up.
+static int bitsOfPowerOfTen (int n)
  {
+   return (n * 1701 + 511) / 512 + 1;
  }
 
-SlowFloat::SlowFloat (double arg)
+   // Just enough of an unsigned big integer to convert to and from double exactly.
+   // The largest number needed is a 53-bit significand times 10^334, which is about 1170 bits.
+class BigNum final
  {
-   if (0.0 == arg)
+public:
+   static const int LIMBS = 40;
+
+   uint32_t limbs [LIMBS]; // Least significant first.
+   int size; // Limbs in use: limbs[size - 1] is nonzero, unless size is 0.
+
+   explicit BigNum (uint64_t arg) : size(0)
     {
-      significand = 0;
-      exponent = 0;
+      while (0 != arg)
+       {
+         limbs[size++] = static_cast<uint32_t>(arg);
+         arg >>= 32;
+       }
     }
-   else if (std::isinf(arg))
+
+   void mulSmall (uint32_t arg)
     {
-      significand = POSITIVE_INFINITY;
-      exponent = SPECIAL_EXPONENT;
+      uint64_t carry = 0;
+      for (int i = 0; i < size; ++i)
+       {
+         carry += static_cast<uint64_t>(limbs[i]) * arg;
+         limbs[i] = static_cast<uint32_t>(carry);
+         carry >>= 32;
+       }
+      if (0 != carry)
+         limbs[size++] = static_cast<uint32_t>(carry);
+    }
+
+   void mulPowerOfTen (int n)
+    {
+      for (; n >= 9; n -= 9)
+         mulSmall(BIAS);
+      if (0 != n)
+         mulSmall(static_cast<uint32_t>(POWERS_OF_TEN[n]));
+    }
+
+      // Returns the remainder.
+   uint32_t divSmall (uint32_t arg)
+    {
+      uint64_t rem = 0;
+      for (int i = size - 1; i >= 0; --i)
+       {
+         rem = (rem << 32) | limbs[i];
+         limbs[i] = static_cast<uint32_t>(rem / arg);
+         rem %= arg;
+       }
+      while ((size > 0) && (0 == limbs[size - 1])) --size;
+      return static_cast<uint32_t>(rem);
+    }
+
+      // Returns whether the division was inexact.
+   bool divPowerOfTen (int n)
+    {
+      bool sticky = false;
+      for (; n >= 9; n -= 9)
+         sticky = (0 != divSmall(BIAS)) || sticky;
+      if (0 != n)
+         sticky = (0 != divSmall(static_cast<uint32_t>(POWERS_OF_TEN[n]))) || sticky;
+      return sticky;
+    }
+
+   void shiftLeft (int bits)
+    {
+      if (0 == size) return;
+      int whole = bits / 32;
+      int part = bits % 32;
+      limbs[size] = 0;
+      for (int i = size; i >= 0; --i)
+       {
+         uint32_t next = (0 == part) ? 0U : ((i > 0) ? (limbs[i - 1] >> (32 - part)) : 0U);
+         limbs[i + whole] = (limbs[i] << part) | next;
+       }
+      for (int i = 0; i < whole; ++i) limbs[i] = 0;
+      size += whole + 1;
+      while ((size > 0) && (0 == limbs[size - 1])) --size;
+    }
+
+      // Returns whether any set bits were shifted out.
+   bool shiftRight (int bits)
+    {
+      int whole = bits / 32;
+      int part = bits % 32;
+      bool sticky = false;
+      for (int i = 0; (i < whole) && (i < size); ++i)
+         sticky = sticky || (0 != limbs[i]);
+      if (whole >= size)
+       {
+         size = 0;
+         return sticky;
+       }
+      sticky = sticky || (0 != (limbs[whole] & ((1U << part) - 1U)));
+      for (int i = whole; i < size; ++i)
+       {
+         uint32_t next = (0 == part) ? 0U : ((i + 1 < size) ? (limbs[i + 1] << (32 - part)) : 0U);
+         limbs[i - whole] = (limbs[i] >> part) | next;
+       }
+      size -= whole;
+      while ((size > 0) && (0 == limbs[size - 1])) --size;
+      return sticky;
+    }
+
+   int bitLength () const
+    {
+      if (0 == size) return 0;
+      return (size - 1) * 32 + ::SlowFloat::bitLength(limbs[size - 1]);
     }
-   else if (std::isnan(arg))
+
+   int compare (const BigNum& rhs) const
+    {
+      if (size != rhs.size) return (size < rhs.size) ? -1 : 1;
+      for (int i = size - 1; i >= 0; --i)
+         if (limbs[i] != rhs.limbs[i]) return (limbs[i] < rhs.limbs[i]) ? -1 : 1;
+      return 0;
+    }
+
+      // Requires that rhs is not greater than this.
+   void subtract (const BigNum& rhs)
+    {
+      int64_t borrow = 0;
+      for (int i = 0; i < size; ++i)
+       {
+         borrow += static_cast<int64_t>(limbs[i]) - ((i < rhs.size) ? rhs.limbs[i] : 0U);
+         limbs[i] = static_cast<uint32_t>(borrow);
+         borrow = (borrow < 0) ? -1 : 0;
+       }
+      while ((size > 0) && (0 == limbs[size - 1])) --size;
+    }
+
+      // Only meaningful if the number fits.
+   uint64_t toUint64 () const
+    {
+      uint64_t result = 0;
+      for (int i = size - 1; i >= 0; --i)
+         result = (result << 32) | limbs[i];
+      return result;
+    }
+ };
+
+   // floor(log10(2^arg)), or one less. Good for the exponents of doubles.
+static int floorLog10Pow2 (int arg)
+ {
+   int num = arg * 78913 - 263;
+   if (num >= 0) return num / 262144;
+   return -((-num + 262143) / 262144);
+ }
+
+   // The full 128-bit product of two uint64_t.
+static void multiply64 (uint64_t lhs, uint64_t rhs, uint64_t& high, uint64_t& low)
+ {
+   uint64_t ll = (lhs & 0xFFFFFFFFU) * (rhs & 0xFFFFFFFFU);
+   uint64_t lh = (lhs & 0xFFFFFFFFU) * (rhs >> 32);
+   uint64_t hl = (lhs >> 32) * (rhs & 0xFFFFFFFFU);
+   uint64_t hh = (lhs >> 32) * (rhs >> 32);
+   uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFU) + (hl & 0xFFFFFFFFU);
+   low = (mid << 32) | (ll & 0xFFFFFFFFU);
+   high = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+ }
+
+   // 10^power is at least significand * 2^shift, and less than (significand + 1) * 2^shift.
+   // The significand is normalized to have its top bit set.
+class PowerOfTen final
+ {
+public:
+   uint64_t significand;
+   int shift;
+   bool exact;
+ };
+
+static const int MIN_POWER_OF_TEN = -340;
+static const int MAX_POWER_OF_TEN = 340;
+
+static const PowerOfTen& powerOfTen (int power)
+ {
+   class Table final
+    {
+   public:
+      PowerOfTen entries [MAX_POWER_OF_TEN - MIN_POWER_OF_TEN + 1];
+
+      Table()
+       {
+         for (int i = MIN_POWER_OF_TEN; i <= MAX_POWER_OF_TEN; ++i)
+          {
+            PowerOfTen& entry = entries[i - MIN_POWER_OF_TEN];
+            BigNum value (1U);
+            if (i >= 0)
+             {
+               value.mulPowerOfTen(i);
+               entry.shift = value.bitLength() - 64;
+               if (entry.shift < 0)
+                {
+                  value.shiftLeft(-entry.shift);
+                  entry.exact = true;
+                }
+               else
+                {
+                  entry.exact = !value.shiftRight(entry.shift);
+                }
+               entry.significand = value.toUint64();
+             }
+            else
+             {
+                  // Long division of 2^(length + 63) by 10^-i.
+               value.mulPowerOfTen(-i);
+               int length = value.bitLength();
+               BigNum rem (1U);
+               rem.shiftLeft(length + 63);
+               value.shiftLeft(63);
+               uint64_t quot = 0;
+               for (int bit = 63; bit >= 0; --bit)
+                {
+                  if (rem.compare(value) >= 0)
+                   {
+                     rem.subtract(value);
+                     quot |= static_cast<uint64_t>(1) << bit;
+                   }
+                  value.shiftRight(1);
+                }
+               entry.significand = quot;
+               entry.shift = -(length + 63);
+               entry.exact = false;
+             }
+          }
+       }
+    };
+   static const Table table;
+   return table.entries[power - MIN_POWER_OF_TEN];
+ }
+
+SlowFloat::SlowFloat(uint32_t significand, int16_t exponent) : significand(significand), exponent(exponent)
+ {
+ }
+
+SlowFloat::SlowFloat (double arg)
+ {
+   uint64_t bits;
+   std::memcpy(&bits, &arg, sizeof(bits));
+   bool sign = 0 != (bits >> 63);
+   int biased = static_cast<int>((bits >> 52) & 0x7FF);
+   uint64_t m = bits & 0xFFFFFFFFFFFFFU;
+
+   if (0x7FF == biased)
     {
-      significand = NOT_A_NUMBER;
+      significand = (0 == m) ? POSITIVE_INFINITY : NOT_A_NUMBER;
       exponent = SPECIAL_EXPONENT;
     }
+   else if ((0 == biased) && (0 == m))
+    {
+      significand = 0;
+      exponent = 0;
+    }
    else
     {
-      exponent = static_cast<int16_t>(std::floor(std::log10(std::fabs(arg)))); // Should never overflow
-         // I haven't run into a case where Windows' bad pow bites me ... yet. But preempt.
-      if (exponent >= 0)
-         significand = static_cast<uint32_t>(std::fabs(arg) / std::pow(10.0, exponent) * MIN_SIGNIFICAND);
+         // The value is exactly m * 2^be. Strip trailing zero bits so that integers are small.
+      int be = (0 == biased) ? -1074 : (biased - 1075);
+      if (0 != biased) m |= 0x10000000000000U;
+      int zeros = bitLength(m & (~m + 1)) - 1;
+      m >>= zeros;
+      be += zeros;
+
+         // Compute q = floor(m * 2^be * 10^p) with at least ten digits, and whether it was exact.
+      int e = floorLog10Pow2(be + bitLength(m) - 1);
+      int p = 9 - e;
+      uint64_t q;
+      bool sticky = false;
+      int mbits = bitLength(m);
+      if ((p >= 0) && (p < 20) && (be >= 0) && (mbits + bitsOfPowerOfTen(p) + be <= 64))
+       {
+         q = (m * POWERS_OF_TEN[p]) << be;
+       }
+      else if ((p >= 0) && (p < 20) && (be < 0) && (-be < 64) && (mbits + bitsOfPowerOfTen(p) <= 64))
+       {
+         uint64_t n = m * POWERS_OF_TEN[p];
+         q = n >> -be;
+         sticky = 0 != (n & ((static_cast<uint64_t>(1) << -be) - 1));
+       }
+      else if ((p < 0) && (-p < 20) && (be < 0))
+       {
+            // m is at least 10^(10 - p) / 2^be, so the divisor fits.
+         uint64_t d = POWERS_OF_TEN[-p] << -be;
+         q = m / d;
+         sticky = 0 != (m % d);
+       }
+      else if ((p < 0) && (-p < 20) && (be >= 0) && (mbits + be <= 64))
+       {
+         uint64_t n = m << be;
+         q = n / POWERS_OF_TEN[-p];
+         sticky = 0 != (n % POWERS_OF_TEN[-p]);
+       }
       else
-         significand = static_cast<uint32_t>(std::fabs(arg) * std::pow(10.0, -exponent) * MIN_SIGNIFICAND);
-      double temp = 5.0;
-         // One Windows, 10^-8 is poorly enough calculated that converting 2.0 results in 2.00000001
-         //    when rounding to positive infinity or away from zero.
-      int bias = exponent - (CUTOFF - 1);
-      if (bias >= 0) temp = temp - (std::fabs(arg) / std::pow(10.0, bias) - significand) * 10;
-      else temp = temp - (std::fabs(arg) * std::pow(10.0, -bias) - significand) * 10;
-      int comp = 0;
-      if (temp > 0.0) comp = 1;
-      else if (temp < 0.0) comp = -1;
-      if (decideRound(arg < 0.0, 0 == (significand & 1), comp, 5.0 == temp))
+       {
+            // Multiply by a 64-bit approximation of 10^p. This is nearly always enough to
+            // know the integer part, and that there is a fractional part.
+         int shift = 53 - mbits;
+         const PowerOfTen& scale = powerOfTen(p);
+         uint64_t high, low;
+         multiply64(m << shift, scale.significand, high, low);
+         int fraction = -(be - shift + scale.shift) - 64; // The bits of high below the binary point.
+         bool nearInteger = true;
+         uint64_t mask = 0;
+         if ((fraction > 0) && (fraction < 64))
+          {
+            mask = (static_cast<uint64_t>(1) << fraction) - 1;
+            nearInteger = !scale.exact && (((0 == (high & mask)) && (0 == low)) ||
+               (((high & mask) == mask) && (low > ~(m << shift))));
+          }
+         if (!nearInteger)
+          {
+            q = high >> fraction;
+            sticky = (0 != (high & mask)) || (0 != low);
+          }
+         else
+          {
+            BigNum n (m);
+            if (p > 0) n.mulPowerOfTen(p);
+            if (be > 0) n.shiftLeft(be);
+            if (be < 0) sticky = n.shiftRight(-be);
+            if (p < 0) sticky = n.divPowerOfTen(-p) || sticky;
+            q = n.toUint64();
+          }
+       }
+
+         // The estimate may be low, so q may have too many digits.
+      while (q >= 10 * static_cast<uint64_t>(BIAS))
+       {
+         sticky = sticky || (0 != (q % 10));
+         q /= 10;
+         ++e;
+       }
+
+      significand = static_cast<uint32_t>(q / 10);
+      exponent = static_cast<int16_t>(e);
+      uint32_t digit = static_cast<uint32_t>(q % 10);
+      int comp = (digit < 5) ? 1 : ((digit > 5) ? -1 : (sticky ? -1 : 0));
+      if (decideRound(sign, 0 == (significand & 1), comp, (0 == digit) && !sticky))
        {
          ++significand;
          if (significand == BIAS)
@@ -182,33 +519,218 @@ SlowFloat::SlowFloat (double arg)
           }
        }
     }
-   if (std::signbit(arg))
+   if (sign)
     {
       significand = ~significand;
     }
  }
 
+   // Round a binary value of q * 2^shift, with sticky set if q was truncated, to the nearest double.
+static double roundToDouble (uint64_t q, int shift, bool sticky)
+ {
+      // Keep 53 bits, or fewer if the result is subnormal.
+   int drop = bitLength(q) - 53;
+   if (shift + drop < -1074)
+      drop = -1074 - shift;
+   if (drop > 64)
+      return 0.0;
+   if (drop < 0)
+    {
+      q <<= -drop;
+    }
+   else if (drop > 0)
+    {
+      uint64_t kept = (drop == 64) ? 0U : (q >> drop);
+      uint64_t half = static_cast<uint64_t>(1) << (drop - 1);
+      uint64_t rest = q & ((half << 1) - 1);
+      if ((rest > half) || ((rest == half) && (sticky || (0 != (kept & 1)))))
+         ++kept;
+      q = kept;
+    }
+   shift += drop;
+   if (q == (static_cast<uint64_t>(1) << 53))
+    {
+      q >>= 1;
+      ++shift;
+    }
+
+   uint64_t bits = q; // Subnormals, and zero, are just the significand.
+   if (q >= (static_cast<uint64_t>(1) << 52))
+    {
+      if (shift + 1075 >= 0x7FF)
+         return std::numeric_limits<double>::infinity();
+      bits = (static_cast<uint64_t>(shift + 1075) << 52) | (q & 0xFFFFFFFFFFFFFU);
+    }
+   double result;
+   std::memcpy(&result, &bits, sizeof(result));
+   return result;
+ }
+
+   // Round sig * 10^bias using a 64-bit approximation of 10^bias. The exact product lies strictly
+   // between sig * significand and sig * (significand + 1), so if that whole range is on the same
+   // side of the rounding point, then we know how the exact product rounds.
+static bool fastToDouble (uint32_t sig, int bias, double& result)
+ {
+   const PowerOfTen& scale = powerOfTen(bias);
+   if (scale.exact)
+      return false;
+
+   uint64_t high, low;
+   multiply64(sig, scale.significand, high, low);
+   int drop = bitLength(high);
+   int shift = scale.shift + drop;
+   if (shift + 63 < -1022) // Subnormal, so more bits would be dropped.
+      return false;
+
+      // The bits that rounding to 53 bits will drop from the product.
+   uint64_t below = static_cast<uint64_t>(1) << (drop + 11);
+   uint64_t half = below >> 1;
+   uint64_t rest = low & (below - 1);
+   uint64_t most = rest + sig - 1;
+   if ((most >= below) || ((rest >= half) != (most >= half)))
+      return false;
+
+   result = roundToDouble((high << (64 - drop)) | (low >> drop), shift, true);
+   return true;
+ }
+
 SlowFloat::operator double () const
  {
-   double sign = 1.0;
+   bool sign = getSign(*this);
    uint32_t sig = significand;
-   if (getSign(*this))
+   if (sign)
     {
-      sign = -1.0;
       sig = ~sig;
     }
+   double result;
    if (isNaN(*this))
-      return std::copysign(std::asin(2.0), sign);
-   if (isInf(*this))
-      return std::copysign(std::exp(1000000.0), sign);
-      // One Windows, 7.00000000 kept being ever so slightly above 7.0
-   int bias = exponent - (CUTOFF - 1);
-   if (bias >= 0)
-      return sign * static_cast<double>(sig) * std::pow(10.0, bias);
+      result = std::numeric_limits<double>::quiet_NaN();
+   else if (isInf(*this))
+      result = std::numeric_limits<double>::infinity();
+   else if (isZero(*this))
+      result = 0.0;
+   else
+    {
+      int bias = exponent - (CUTOFF - 1);
+         // A nine-digit significand and a power of ten that are both exact give a correctly-rounded result.
+      if ((bias >= 0) && (bias <= 22))
+         result = static_cast<double>(sig) * DOUBLE_POWERS_OF_TEN[bias];
+      else if ((bias < 0) && (bias >= -22))
+         result = static_cast<double>(sig) / DOUBLE_POWERS_OF_TEN[-bias];
+      else if ((bias > 22) && (bias <= 28))
+         result = static_cast<double>(sig * POWERS_OF_TEN[bias - 22]) * DOUBLE_POWERS_OF_TEN[22];
+      else if (exponent > 308)
+         result = std::numeric_limits<double>::infinity();
+      else if (exponent < -325)
+         result = 0.0;
+      else if (fastToDouble(sig, bias, result))
+       {
+       }
+      else if (bias > 0)
+       {
+            // Take the top 64 bits of sig * 10^bias.
+         BigNum n (sig);
+         n.mulPowerOfTen(bias);
+         int shift = n.bitLength() - 64;
+         bool sticky = n.shiftRight(shift);
+         result = roundToDouble(n.toUint64(), shift, sticky);
+       }
+      else
+       {
+            // Long division of sig * 2^shift by 10^-bias, for a 64-bit quotient.
+         BigNum d (1U);
+         d.mulPowerOfTen(-bias);
+         int shift = d.bitLength() - bitLength(sig) + 63;
+         BigNum n (sig);
+         n.shiftLeft(shift);
+         d.shiftLeft(63);
+         uint64_t q = 0;
+         for (int i = 63; i >= 0; --i)
+          {
+            if (n.compare(d) >= 0)
+             {
+               n.subtract(d);
+               q |= static_cast<uint64_t>(1) << i;
+             }
+            d.shiftRight(1);
+          }
+         result = roundToDouble(q, -shift, 0 != n.size);
+       }
+    }
+   return sign ? -result : result;
+ }
+
+bool toInt64 (const SlowFloat& arg, int64_t& result)
+ {
+   if (isZero(arg))
+    {
+      result = 0;
+      return true;
+    }
+   if ((arg.exponent == SPECIAL_EXPONENT) || (arg.exponent < 0) || (arg.exponent > 18))
+      return false;
+
+   uint64_t value = arg.significand ^ (getSign(arg) ? 0xFFFFFFFFU : 0U);
+   if (arg.exponent < CUTOFF - 1)
+    {
+      uint64_t divisor = POWERS_OF_TEN[CUTOFF - 1 - arg.exponent];
+      if (0 != (value % divisor))
+         return false;
+      value /= divisor;
+    }
+   else
+    {
+      value *= POWERS_OF_TEN[arg.exponent - (CUTOFF - 1)];
+    }
+
+   const uint64_t limit = static_cast<uint64_t>(1) << 63; // The magnitude of the smallest int64_t.
+   if (getSign(arg))
+    {
+      if (value > limit)
+         return false;
+      result = static_cast<int64_t>(0 - value);
+    }
    else
-      return sign * static_cast<double>(sig) / std::pow(10.0, -bias);
+    {
+      if (value >= limit)
+         return false;
+      result = static_cast<int64_t>(value);
+    }
+   return true;
  }
 
+SlowFloat fromInt64 (int64_t arg)
+ {
+   if (0 == arg)
+      return sfZero;
+
+   bool sign = arg < 0;
+   uint64_t value = sign ? (0 - static_cast<uint64_t>(arg)) : static_cast<uint64_t>(arg);
+   int digits = 1;
+   while ((digits < 20) && (value >= POWERS_OF_TEN[digits])) ++digits;
+
+   int16_t exponent = static_cast<int16_t>(digits - 1);
+   if (digits <= CUTOFF)
+    {
+      value *= POWERS_OF_TEN[CUTOFF - digits];
+    }
+   else
+    {
+      uint64_t divisor = POWERS_OF_TEN[digits - CUTOFF];
+      uint64_t rem = value % divisor;
+      value /= divisor;
+      if (decideRound(sign, 0 == (value & 1), static_cast<int64_t>(divisor) - static_cast<int64_t>(2 * rem), 0 == rem))
+       {
+         ++value;
+         if (value == BIAS)
+          {
+            value = MIN_SIGNIFICAND;
+            ++exponent;
+          }
+       }
+    }
+   return SlowFloat(static_cast<uint32_t>(value) ^ (sign ? 0xFFFFFFFFU : 0U), exponent);
+ }
 
 std::string toString (const SlowFloat& arg)
  {
@@ -888,4 +1410,1641 @@ bool operator != (const SlowFloat& lhs, const SlowFloat& rhs)
    return (lhs.significand != rhs.significand) || (lhs.exponent != rhs.exponent);
  }
 
+   // The functions below carry eighteen digits in a uint64_t and round once at the end.
+   // A Wide is m * 10^(exponent - 17), with m normalized to 100000000000000000 - 999999999999999999.
+   // If sticky is set, then m has been truncated, and the true value is a little larger.
+static const uint64_t WIDE_MIN = static_cast<uint64_t>(BIAS) * MIN_SIGNIFICAND;
+static const uint64_t WIDE_BIAS = static_cast<uint64_t>(BIAS) * BIAS;
+
+class Wide final
+ {
+public:
+   uint64_t m;
+   int64_t exponent;
+   bool sticky;
+ };
+
+static Wide toWide (const SlowFloat& arg)
+ {
+   Wide result;
+   result.m = static_cast<uint64_t>(arg.significand ^ (getSign(arg) ? 0xFFFFFFFFU : 0U)) * BIAS;
+   result.exponent = arg.exponent;
+   result.sticky = false;
+   return result;
+ }
+
+static Wide multiply (const Wide& lhs, const Wide& rhs)
+ {
+      // Schoolbook, in base one billion: the product is high * 10^18 + mid * 10^9 + low.
+   uint64_t lh = lhs.m / BIAS, ll = lhs.m % BIAS;
+   uint64_t rh = rhs.m / BIAS, rl = rhs.m % BIAS;
+
+   uint64_t low = ll * rl;
+   uint64_t mid = lh * rl + ll * rh + low / BIAS;
+   uint64_t high = lh * rh + mid / BIAS;
+   low %= BIAS;
+   mid %= BIAS;
+
+   Wide result;
+   result.exponent = lhs.exponent + rhs.exponent;
+   result.sticky = lhs.sticky || rhs.sticky;
+   if (high >= WIDE_MIN)
+    {
+      result.m = high;
+      result.sticky = result.sticky || (0 != mid) || (0 != low);
+      ++result.exponent;
+    }
+   else
+    {
+      result.m = high * 10 + mid / MIN_SIGNIFICAND;
+      result.sticky = result.sticky || (0 != (mid % MIN_SIGNIFICAND)) || (0 != low);
+    }
+   return result;
+ }
+
+static Wide add (const Wide& lhs, const Wide& rhs)
+ {
+   const Wide& big = (lhs.exponent >= rhs.exponent) ? lhs : rhs;
+   const Wide& small = (lhs.exponent >= rhs.exponent) ? rhs : lhs;
+
+   Wide result = big;
+   int64_t shift = big.exponent - small.exponent;
+   if (shift > 18)
+    {
+      result.sticky = true;
+      return result;
+    }
+
+   uint64_t divisor = 1;
+   for (int64_t i = 0; i < shift; ++i) divisor *= 10;
+   result.m += small.m / divisor;
+   result.sticky = result.sticky || small.sticky || (0 != (small.m % divisor));
+
+   if (result.m >= WIDE_BIAS)
+    {
+      result.sticky = result.sticky || (0 != (result.m % 10));
+      result.m /= 10;
+      ++result.exponent;
+    }
+   return result;
+ }
+
+   // Round to nine digits and check the range, as operator * does.
+static SlowFloat roundWide (bool sign, const Wide& arg)
+ {
+   uint64_t sig = arg.m / BIAS;
+   uint64_t rem = arg.m % BIAS;
+   int64_t exponent = arg.exponent;
+
+      // A truncated remainder of exactly one half is really a little more than one half.
+   int64_t comp = static_cast<int64_t>(BIAS) - static_cast<int64_t>(2 * rem);
+   if (arg.sticky && (0 == comp)) comp = -1;
+
+   if (decideRound(sign, 0 == (sig & 1), comp, (0 == rem) && !arg.sticky))
+    {
+      ++sig;
+      if (sig == BIAS)
+       {
+         sig = MIN_SIGNIFICAND;
+         ++exponent;
+       }
+    }
+
+   if (exponent > MAX_EXPONENT)
+    {
+      if (sign) return -sfInf;
+      return sfInf;
+    }
+   if (exponent < MIN_EXPONENT)
+    {
+      if (sign) return -sfZero;
+      return sfZero;
+    }
+
+   return SlowFloat(static_cast<uint32_t>(sig) ^ (sign ? 0xFFFFFFFFU : 0U), static_cast<int16_t>(exponent));
+ }
+
+   // Square root of a positive Wide. This is correctly rounded unless arg is sticky.
+static SlowFloat squareRoot (const Wide& arg)
+ {
+      // Choose n and an even power of ten such that arg = n * 10^power.
+   uint64_t n = arg.m;
+   bool sticky = arg.sticky;
+   int64_t power = arg.exponent - 17;
+   if (0 != (power & 1))
+    {
+      sticky = sticky || (0 != (n % 10));
+      n /= 10;
+      ++power;
+    }
+
+      // Newton's method, from above, for the nine-digit integer square root of n.
+   uint64_t root = BIAS;
+   for (;;)
+    {
+      uint64_t next = (root + n / root) / 2;
+      if (next >= root) break;
+      root = next;
+    }
+
+   int64_t exponent = power / 2 + 8; // n has seventeen or eighteen digits, so root has nine.
+
+      // (root + 1/2)^2 - n, times four, tells us which side of the halfway point the true root lies.
+   uint64_t rem = n - root * root;
+   int64_t comp = static_cast<int64_t>(4 * root + 1) - static_cast<int64_t>(4 * rem);
+   if (decideRound(false, 0 == (root & 1), comp, (0 == rem) && !sticky))
+    {
+      ++root;
+      if (root == BIAS)
+       {
+         root = MIN_SIGNIFICAND;
+         ++exponent;
+       }
+    }
+
+   return SlowFloat(static_cast<uint32_t>(root), static_cast<int16_t>(exponent));
+ }
+
+SlowFloat sqrt (const SlowFloat& arg)
+ {
+   if (isNaN(arg)) return arg;
+   if (isZero(arg)) return arg; // Preserve the sign of zero.
+   if (getSign(arg)) return sfNaN;
+   if (isInf(arg)) return arg;
+
+   return squareRoot(toWide(arg));
+ }
+
+SlowFloat hypot (const SlowFloat& lhs, const SlowFloat& rhs)
+ {
+      // Infinity wins over NaN.
+   if (isInf(lhs) || isInf(rhs)) return sfInf;
+   if (isNaN(lhs)) return lhs;
+   if (isNaN(rhs)) return rhs;
+
+   if (isZero(lhs) && isZero(rhs)) return sfZero;
+   if (isZero(lhs)) return getSign(rhs) ? -rhs : rhs;
+   if (isZero(rhs)) return getSign(lhs) ? -lhs : lhs;
+
+   Wide lw = toWide(lhs), rw = toWide(rhs);
+   return squareRoot(add(multiply(lw, lw), multiply(rw, rw)));
+ }
+
+   // The transcendental functions work in fixed point, at a precision that grows until the result can
+   // be rounded correctly. A Fixed is d[0] + d[1] * 10^-9 + ... + d[n] * 10^-9n, with every limb,
+   // the integer part included, below one billion. A Fixed only holds a magnitude: callers track signs.
+static const int MAX_LIMBS = 24;
+static const int CONSTANT_LIMBS = MAX_LIMBS + 2;
+
+class Fixed final
+ {
+public:
+   uint32_t d [CONSTANT_LIMBS + 1];
+   int n;
+ };
+
+static uint32_t magnitude (const SlowFloat& arg)
+ {
+   return arg.significand ^ (getSign(arg) ? 0xFFFFFFFFU : 0U);
+ }
+
+static Fixed fixedInt (uint64_t value, int n)
+ {
+   Fixed result;
+   result.n = n;
+   result.d[0] = static_cast<uint32_t>(value);
+   for (int i = 1; i <= n; ++i) result.d[i] = 0U;
+   return result;
+ }
+
+   // The value count * 10^-9n, which must be below 10^18 units.
+static Fixed fixedUlps (uint64_t count, int n)
+ {
+   Fixed result = fixedInt(0U, n);
+   result.d[n] = static_cast<uint32_t>(count % BIAS);
+   result.d[n - 1] = static_cast<uint32_t>(count / BIAS);
+   return result;
+ }
+
+static Fixed fixedTruncate (const Fixed& arg, int n)
+ {
+   Fixed result = arg;
+   result.n = n;
+   return result;
+ }
+
+static bool fixedIsZero (const Fixed& arg)
+ {
+   for (int i = 0; i <= arg.n; ++i)
+      if (0U != arg.d[i]) return false;
+   return true;
+ }
+
+static int fixedCompare (const Fixed& lhs, const Fixed& rhs)
+ {
+   for (int i = 0; i <= lhs.n; ++i)
+      if (lhs.d[i] != rhs.d[i]) return (lhs.d[i] < rhs.d[i]) ? -1 : 1;
+   return 0;
+ }
+
+   // The decimal exponent of the leading digit of a nonzero Fixed.
+static int64_t fixedLead (const Fixed& arg)
+ {
+   int i = 0;
+   while (0U == arg.d[i]) ++i;
+   int digits = 1;
+   while ((digits < 9) && (arg.d[i] >= POWERS_OF_TEN[digits])) ++digits;
+   return digits - 1 - 9 * i;
+ }
+
+static Fixed fixedAdd (const Fixed& lhs, const Fixed& rhs)
+ {
+   Fixed result;
+   result.n = lhs.n;
+   uint32_t carry = 0U;
+   for (int i = lhs.n; i > 0; --i)
+    {
+      uint32_t sum = lhs.d[i] + rhs.d[i] + carry;
+      carry = (sum >= BIAS) ? 1U : 0U;
+      result.d[i] = sum - carry * BIAS;
+    }
+   result.d[0] = lhs.d[0] + rhs.d[0] + carry;
+   return result;
+ }
+
+   // lhs must not be less than rhs.
+static Fixed fixedSub (const Fixed& lhs, const Fixed& rhs)
+ {
+   Fixed result;
+   result.n = lhs.n;
+   uint32_t borrow = 0U;
+   for (int i = lhs.n; i >= 0; --i)
+    {
+      uint32_t sub = rhs.d[i] + borrow;
+      borrow = (lhs.d[i] < sub) ? 1U : 0U;
+      result.d[i] = lhs.d[i] + borrow * BIAS - sub;
+    }
+   return result;
+ }
+
+   // The product is truncated, so it is low by less than one unit in the last place.
+static Fixed fixedMul (const Fixed& lhs, const Fixed& rhs)
+ {
+   const int n = lhs.n;
+   uint64_t columns [2 * CONSTANT_LIMBS + 2];
+   for (int i = 0; i <= 2 * n; ++i) columns[i] = 0U;
+
+      // Schoolbook, from the least significant row, so that each carry lands in a column a later row normalizes.
+   for (int i = n; i >= 0; --i)
+    {
+      if (0U == lhs.d[i]) continue;
+      uint64_t carry = 0U;
+      for (int j = n; j >= 0; --j)
+       {
+         uint64_t cur = columns[i + j] + static_cast<uint64_t>(lhs.d[i]) * rhs.d[j] + carry;
+         columns[i + j] = cur % BIAS;
+         carry = cur / BIAS;
+       }
+      if (i > 0) columns[i - 1] += carry;
+    }
+
+   Fixed result;
+   result.n = n;
+   for (int i = 0; i <= n; ++i) result.d[i] = static_cast<uint32_t>(columns[i]);
+   return result;
+ }
+
+   // The product must stay below one billion, and factor below 10^10.
+static Fixed fixedMulSmall (const Fixed& arg, uint64_t factor)
+ {
+   Fixed result;
+   result.n = arg.n;
+   uint64_t carry = 0U;
+   for (int i = arg.n; i > 0; --i)
+    {
+      uint64_t cur = arg.d[i] * factor + carry;
+      result.d[i] = static_cast<uint32_t>(cur % BIAS);
+      carry = cur / BIAS;
+    }
+   result.d[0] = static_cast<uint32_t>(arg.d[0] * factor + carry);
+   return result;
+ }
+
+   // The quotient is truncated. divisor must be below 1.8 * 10^10, so that the remainder can be shifted.
+static Fixed fixedDivSmall (const Fixed& arg, uint64_t divisor)
+ {
+   Fixed result;
+   result.n = arg.n;
+   uint64_t rem = 0U;
+   for (int i = 0; i <= arg.n; ++i)
+    {
+      uint64_t cur = rem * BIAS + arg.d[i];
+      result.d[i] = static_cast<uint32_t>(cur / divisor);
+      rem = cur % divisor;
+    }
+   return result;
+ }
+
+   // Divide by 10^digits, truncating.
+static Fixed fixedShiftRight (const Fixed& arg, uint64_t digits)
+ {
+   uint64_t limbs = digits / 9;
+   if (limbs > static_cast<uint64_t>(arg.n)) return fixedInt(0U, arg.n);
+   Fixed result;
+   result.n = arg.n;
+   for (int i = arg.n; i >= 0; --i)
+      result.d[i] = (static_cast<uint64_t>(i) >= limbs) ? arg.d[i - limbs] : 0U;
+   return fixedDivSmall(result, POWERS_OF_TEN[digits % 9]);
+ }
+
+   // Multiply by 10^digits. The result must stay below one billion.
+static Fixed fixedShiftLeft (const Fixed& arg, uint64_t digits)
+ {
+   uint64_t limbs = digits / 9;
+   Fixed result;
+   result.n = arg.n;
+   for (int i = 0; i <= arg.n; ++i)
+      result.d[i] = (static_cast<uint64_t>(i) + limbs <= static_cast<uint64_t>(arg.n)) ? arg.d[i + limbs] : 0U;
+   return fixedMulSmall(result, POWERS_OF_TEN[digits % 9]);
+ }
+
+   // sig * 10^power, for a power that keeps it below one billion.
+static Fixed fixedFromDecimal (uint64_t sig, int64_t power, int n)
+ {
+   if (power >= 0) return fixedShiftLeft(fixedInt(sig, n), power);
+   return fixedShiftRight(fixedInt(sig, n), -power);
+ }
+
+   // The first eighteen digits of arg * 10^shift. arg must not be zero.
+static Wide fixedToWide (const Fixed& arg, int64_t shift)
+ {
+   int i = 0;
+   while (0U == arg.d[i]) ++i;
+
+   int digits = 1;
+   while ((digits < 9) && (arg.d[i] >= POWERS_OF_TEN[digits])) ++digits;
+
+   Wide result;
+   result.m = arg.d[i];
+   result.exponent = shift + digits - 1 - 9 * i;
+   result.sticky = false;
+   int needed = 18 - digits;
+   for (int j = i + 1; j <= arg.n; ++j)
+    {
+      if (needed >= 9)
+       {
+         result.m = result.m * BIAS + arg.d[j];
+         needed -= 9;
+       }
+      else if (needed > 0)
+       {
+         result.m = result.m * POWERS_OF_TEN[needed] + arg.d[j] / POWERS_OF_TEN[9 - needed];
+         result.sticky = result.sticky || (0U != (arg.d[j] % POWERS_OF_TEN[9 - needed]));
+         needed = 0;
+       }
+      else
+       {
+         result.sticky = result.sticky || (0U != arg.d[j]);
+       }
+    }
+   result.m *= POWERS_OF_TEN[needed];
+   return result;
+ }
+
+   // Error bounds are counted in units in the last place. One that is too large to be useful is HOPELESS.
+static const uint64_t HOPELESS = WIDE_BIAS;
+
+static uint64_t errorSum (uint64_t lhs, uint64_t rhs)
+ {
+   if ((lhs >= HOPELESS) || (rhs >= HOPELESS - lhs)) return HOPELESS;
+   return lhs + rhs;
+ }
+
+static uint64_t errorProduct (uint64_t lhs, uint64_t rhs)
+ {
+   if ((0U != lhs) && (rhs >= HOPELESS / lhs)) return HOPELESS;
+   return lhs * rhs;
+ }
+
+static uint64_t errorShift (uint64_t err, int64_t digits)
+ {
+   if (digits >= 18) return (0U == err) ? 0U : HOPELESS;
+   if (digits >= 0) return errorProduct(err, POWERS_OF_TEN[digits]);
+   if (digits <= -18) return 1U;
+   return err / POWERS_OF_TEN[-digits] + 1U;
+ }
+
+   // 1 / arg, for arg in [0.1, 1), by Newton's method. The result is within forty units.
+static Fixed fixedReciprocal (const Fixed& arg)
+ {
+   uint64_t guess = WIDE_BIAS / (static_cast<uint64_t>(arg.d[1]) + 1U);
+   Fixed result = fixedInt(guess / BIAS, arg.n);
+   result.d[1] = static_cast<uint32_t>(guess % BIAS);
+
+      // The guess is good to eight digits, and each step doubles that. Truncation can leave
+      // the product a unit or so above one, once the digits run out.
+   const Fixed one = fixedInt(1U, arg.n);
+   for (int digits = 8; digits < 9 * arg.n + 16; digits *= 2)
+    {
+      Fixed product = fixedMul(arg, result);
+      if (fixedCompare(product, one) <= 0)
+         result = fixedAdd(result, fixedMul(result, fixedSub(one, product)));
+      else
+         result = fixedSub(result, fixedMul(result, fixedSub(product, one)));
+    }
+   return result;
+ }
+
+   // An approximation to a result: the true value is within err units in the last place of a * 10^shift,
+   // and has the given sign.
+class Approx final
+ {
+public:
+   Fixed a;
+   int64_t shift;
+   uint64_t err;
+   bool sign;
+ };
+
+   // num / den, given their errors. Neither may be zero.
+static void fixedDivide (const Fixed& num, uint64_t numErr, const Fixed& den, uint64_t denErr, Approx& result)
+ {
+      // Scale both to [0.1, 1).
+   int64_t numLead = fixedLead(num), denLead = fixedLead(den);
+   Fixed top = (numLead < 0) ? fixedShiftLeft(num, -1 - numLead) : fixedShiftRight(num, numLead + 1);
+   Fixed bottom = (denLead < 0) ? fixedShiftLeft(den, -1 - denLead) : fixedShiftRight(den, denLead + 1);
+   numErr = errorShift(numErr, -1 - numLead);
+   denErr = errorShift(denErr, -1 - denLead);
+
+      // The reciprocal is at most ten, so the error in the denominator is magnified by at most one hundred.
+   result.a = fixedMul(top, fixedReciprocal(bottom));
+   result.shift = numLead - denLead;
+   result.err = errorSum(errorSum(errorProduct(numErr, 10U), errorProduct(denErr, 100U)), 41U);
+ }
+
+   // The constants and tables, to two more limbs than any evaluation uses, so that truncating them costs
+   // less than a unit.
+class Constants final
+ {
+public:
+   Fixed degree; // pi / 180
+   Fixed radian; // 180 / pi
+   Fixed ln10;
+   Fixed invLn10;
+   Fixed logEighths [65]; // |ln(j / 8)|, for j from 6 to 64
+   Fixed expCoarse [148]; // exp(j / 64)
+   Fixed expFine [64];    // exp(j / 4096)
+   Fixed sinDegrees [46]; // sin and cos of whole degrees
+   Fixed cosDegrees [46];
+ };
+
+   // The sum of 1 / ((2i + 1) * k^(2i + 1)), with alternating signs if alternate. This is atan(1 / k) or atanh(1 / k).
+static Fixed inverseSeries (uint64_t k, bool alternate)
+ {
+   Fixed power = fixedDivSmall(fixedInt(1U, CONSTANT_LIMBS), k);
+   Fixed plus = power, minus = fixedInt(0U, CONSTANT_LIMBS);
+   for (uint64_t i = 1U; ; ++i)
+    {
+      power = fixedDivSmall(power, k * k);
+      Fixed term = fixedDivSmall(power, 2 * i + 1);
+      if (fixedIsZero(term)) break;
+      if (alternate && (0U != (i & 1))) minus = fixedAdd(minus, term);
+      else plus = fixedAdd(plus, term);
+    }
+   return fixedSub(plus, minus);
+ }
+
+   // exp(1 / k), by its series.
+static Fixed expInverse (uint64_t k)
+ {
+   Fixed sum = fixedInt(1U, CONSTANT_LIMBS), term = sum;
+   for (uint64_t i = 1U; ; ++i)
+    {
+      term = fixedDivSmall(term, k * i);
+      if (fixedIsZero(term)) break;
+      sum = fixedAdd(sum, term);
+    }
+   return sum;
+ }
+
+static Fixed evenSeries (const Fixed& u2, uint64_t first, bool alternate, uint64_t& terms);
+
+static Constants makeConstants ()
+ {
+   Constants result;
+
+      // Machin's formula: pi = 16 atan(1/5) - 4 atan(1/239).
+   Fixed pi = fixedSub(fixedMulSmall(inverseSeries(5U, true), 16U), fixedMulSmall(inverseSeries(239U, true), 4U));
+   result.degree = fixedDivSmall(pi, 180U);
+   result.radian = fixedMulSmall(fixedReciprocal(fixedMulSmall(result.degree, 10U)), 10U);
+
+      // ln(k) = ln(k - 1) + 2 atanh(1 / (2k - 1)).
+   Fixed logs [65];
+   logs[1] = fixedInt(0U, CONSTANT_LIMBS);
+   for (uint64_t k = 2U; k <= 64U; ++k)
+      logs[k] = fixedAdd(logs[k - 1], fixedMulSmall(inverseSeries(2U * k - 1U, false), 2U));
+   for (int j = 6; j <= 64; ++j)
+      result.logEighths[j] = (j < 8) ? fixedSub(logs[8], logs[j]) : fixedSub(logs[j], logs[8]);
+   result.ln10 = logs[10];
+   result.invLn10 = fixedDivSmall(fixedReciprocal(fixedDivSmall(result.ln10, 10U)), 10U);
+
+   const Fixed coarse = expInverse(64U), fine = expInverse(4096U);
+   result.expCoarse[0] = fixedInt(1U, CONSTANT_LIMBS);
+   for (int j = 1; j < 148; ++j) result.expCoarse[j] = fixedMul(result.expCoarse[j - 1], coarse);
+   result.expFine[0] = result.expCoarse[0];
+   for (int j = 1; j < 64; ++j) result.expFine[j] = fixedMul(result.expFine[j - 1], fine);
+
+      // Step by one degree with the angle addition formulas.
+   uint64_t terms;
+   Fixed u2 = fixedMul(result.degree, result.degree);
+   Fixed sinOne = fixedMul(result.degree, evenSeries(u2, 2U, true, terms));
+   Fixed cosOne = evenSeries(u2, 1U, true, terms);
+   result.sinDegrees[0] = fixedInt(0U, CONSTANT_LIMBS);
+   result.cosDegrees[0] = fixedInt(1U, CONSTANT_LIMBS);
+   for (int j = 1; j < 46; ++j)
+    {
+      const Fixed& s = result.sinDegrees[j - 1];
+      const Fixed& c = result.cosDegrees[j - 1];
+      result.sinDegrees[j] = fixedAdd(fixedMul(s, cosOne), fixedMul(c, sinOne));
+      result.cosDegrees[j] = fixedSub(fixedMul(c, cosOne), fixedMul(s, sinOne));
+    }
+
+   return result;
+ }
+
+static const Constants& constants ()
+ {
+   static const Constants result = makeConstants();
+   return result;
+ }
+
+   // A kernel approximates a function of one or two arguments using n fractional limbs.
+typedef void (*Kernel) (const SlowFloat&, const SlowFloat&, int, Approx&);
+
+   // An exactness test checks whether a guess is exactly the function of the two arguments.
+typedef bool (*Exact) (const SlowFloat&, const SlowFloat&, const SlowFloat&);
+
+   // The rounding boundary nearest to an approximation: a representable number or a midpoint between two.
+static SlowFloat nearestBoundary (const Approx& approx)
+ {
+   if (fixedIsZero(approx.a)) return approx.sign ? -sfZero : sfZero;
+   Wide nearest = fixedToWide(approx.a, approx.shift);
+   const uint64_t half = BIAS / 2;
+   uint64_t rem = nearest.m % half;
+   nearest.m -= rem;
+   if (rem >= half / 2) nearest.m += half;
+   if (nearest.m == WIDE_BIAS)
+    {
+      nearest.m = WIDE_MIN;
+      ++nearest.exponent;
+    }
+   nearest.sticky = false;
+   return roundWide(approx.sign, nearest);
+ }
+
+static const int PRECISIONS [] = { 2, 4, 12, MAX_LIMBS };
+
+   // Ziv's strategy: if both ends of the error bound round the same way, so does the true value.
+   // Otherwise, try again with more limbs. No precision decides a result that is exactly a rounding
+   // boundary, so exact may recognize one early, and past two hundred digits we assume one.
+static SlowFloat evaluate (Kernel kernel, const SlowFloat& lhs, const SlowFloat& rhs, Exact exact = nullptr)
+ {
+   Approx approx;
+   for (size_t i = 0U; i < sizeof(PRECISIONS) / sizeof(PRECISIONS[0]); ++i)
+    {
+      kernel(lhs, rhs, PRECISIONS[i], approx);
+      if (approx.err >= HOPELESS) continue;
+
+      Fixed error = fixedUlps(approx.err, approx.a.n);
+      if (fixedCompare(approx.a, error) <= 0) continue;
+      SlowFloat low = roundWide(approx.sign, fixedToWide(fixedSub(approx.a, error), approx.shift));
+      SlowFloat high = roundWide(approx.sign, fixedToWide(fixedAdd(approx.a, error), approx.shift));
+      if ((low.significand == high.significand) && (low.exponent == high.exponent)) return low;
+
+      if ((0U == i) && (nullptr != exact))
+       {
+         SlowFloat guess = nearestBoundary(approx);
+         if (exact(lhs, rhs, guess)) return guess;
+       }
+    }
+   return nearestBoundary(approx);
+ }
+
+   // A result in (1, 1 + 10^-17), or in (1 - 10^-18, 1) if below.
+static SlowFloat nearOne (bool below)
+ {
+   Wide result;
+   result.m = below ? WIDE_BIAS - 1U : WIDE_MIN;
+   result.exponent = below ? -1 : 0;
+   result.sticky = true;
+   return roundWide(false, result);
+ }
+
+   // a += b, for signed magnitudes.
+static void signedAdd (Fixed& a, bool& aSign, const Fixed& b, bool bSign)
+ {
+   if (aSign == bSign)
+      a = fixedAdd(a, b);
+   else if (fixedCompare(a, b) >= 0)
+      a = fixedSub(a, b);
+   else
+    {
+      a = fixedSub(b, a);
+      aSign = bSign;
+    }
+ }
+
+   // exp(x) = 10^k exp(r), with r in [0, ln(10)), and exp(r) = exp(i / 64) exp(j / 4096) exp(s), with s below 1 / 4096.
+   // If negative, this is exp(-x). x must be below 10^5.
+static void expFixed (const Fixed& x, bool negative, uint64_t xErr, Approx& result)
+ {
+   const int n = x.n;
+   const Constants& c = constants();
+   const Fixed ln10 = fixedTruncate(c.ln10, n);
+
+      // The estimate of k can be one low.
+   uint64_t k = fixedMul(x, fixedTruncate(c.invLn10, n)).d[0];
+   Fixed multiple = fixedMulSmall(ln10, k);
+   if (fixedCompare(multiple, x) > 0)
+    {
+      --k;
+      multiple = fixedSub(multiple, ln10);
+    }
+   Fixed r = fixedSub(x, multiple);
+   if (fixedCompare(r, ln10) >= 0)
+    {
+      ++k;
+      r = fixedSub(r, ln10);
+    }
+   if (negative)
+    {
+      ++k;
+      r = fixedSub(ln10, r);
+    }
+
+   uint64_t i = fixedMulSmall(r, 64U).d[0];
+   r = fixedSub(r, fixedDivSmall(fixedInt(i, n), 64U));
+   uint64_t j = fixedMulSmall(r, 4096U).d[0];
+   r = fixedSub(r, fixedDivSmall(fixedInt(j, n), 4096U));
+
+   Fixed sum = fixedAdd(fixedInt(1U, n), r), term = r;
+   uint64_t terms = 1U;
+   for (uint64_t m = 2U; ; ++m)
+    {
+      term = fixedDivSmall(fixedMul(term, r), m);
+      if (fixedIsZero(term)) break;
+      sum = fixedAdd(sum, term);
+      ++terms;
+    }
+
+   result.a = fixedMul(fixedMul(fixedTruncate(c.expCoarse[i], n), fixedTruncate(c.expFine[j], n)), sum);
+   result.shift = negative ? -static_cast<int64_t>(k) : static_cast<int64_t>(k);
+   result.sign = false;
+      // r carries the error in x and in k ln(10), and exp(r) < 11.
+   result.err = errorProduct(errorSum(errorSum(xErr, 2U * k + 4U), 2U * terms + 8U), 11U);
+ }
+
+   // The argument must be at least 10^-20 and below 10^5 in magnitude.
+static void expKernel (const SlowFloat& arg, const SlowFloat&, int n, Approx& result)
+ {
+   expFixed(fixedFromDecimal(magnitude(arg), arg.exponent - 8, n), getSign(arg), 1U, result);
+ }
+
+   // ln(m * 10^p) = p ln(10) + ln(c) + 2 atanh((m - c) / (m + c)), with m in (0.8, 8] and c the nearest eighth.
+   // The argument must be positive, finite, and not one.
+static void logKernel (const SlowFloat& arg, const SlowFloat&, int n, Approx& result)
+ {
+   const Constants& c = constants();
+   uint64_t sig = magnitude(arg);
+   int64_t power = arg.exponent;
+   uint64_t unit = MIN_SIGNIFICAND;
+   if (sig > 8U * MIN_SIGNIFICAND)
+    {
+      unit = BIAS;
+      ++power;
+    }
+
+   uint64_t j = (16U * sig / unit + 1U) / 2U;
+   uint64_t scaled = 8U * sig, center = j * unit;
+   bool below = scaled < center;
+   Fixed z = fixedDivSmall(fixedInt(below ? center - scaled : scaled - center, n), scaled + center);
+   Fixed z2 = fixedMul(z, z);
+   Fixed sum = z, odd = z;
+   uint64_t terms = 1U;
+   for (uint64_t i = 3U; ; i += 2U)
+    {
+      odd = fixedMul(odd, z2);
+      Fixed term = fixedDivSmall(odd, i);
+      if (fixedIsZero(term)) break;
+      sum = fixedAdd(sum, term);
+      ++terms;
+    }
+
+   uint64_t count = (power < 0) ? -power : power;
+   result.a = fixedAdd(sum, sum);
+   result.sign = below;
+   signedAdd(result.a, result.sign, fixedTruncate(c.logEighths[j], n), j < 8U);
+   signedAdd(result.a, result.sign, fixedMulSmall(fixedTruncate(c.ln10, n), count), power < 0);
+   result.shift = 0;
+   result.err = 8U * terms + 16U + 2U * count;
+ }
+
+static void logBaseKernel (const SlowFloat& base, const SlowFloat& arg, int n, Approx& result)
+ {
+   Approx num, den;
+   logKernel(arg, arg, n, num);
+   logKernel(base, base, n, den);
+   fixedDivide(num.a, num.err, den.a, den.err, result);
+   result.sign = num.sign != den.sign;
+ }
+
+   // exp(power * ln(base)). The caller has checked that the product is between 10^-21 and 10^5.
+static void powKernel (const SlowFloat& base, const SlowFloat& power, int n, Approx& result)
+ {
+      // Carry extra limbs in the logarithm, so that scaling it up by the power doesn't cost precision.
+   int64_t lead = power.exponent;
+   int extra = (lead > 0) ? static_cast<int>((lead + 8) / 9) : 0;
+   Approx ln;
+   logKernel(base, base, n + extra, ln);
+
+   Fixed product = fixedMul(ln.a, fixedFromDecimal(magnitude(power), -8, n + extra));
+   if (lead >= 0) product = fixedShiftLeft(product, lead);
+   else product = fixedShiftRight(product, -lead);
+   uint64_t err = errorSum(errorShift(errorSum(errorProduct(ln.err, 10U), 2U), lead - 9 * extra), 1U);
+
+   expFixed(fixedTruncate(product, n), ln.sign != getSign(power), err, result);
+ }
+
+   // Reduce an angle of at least one degree to [0, 360), in units of 10^-8 degrees.
+   // This is exact, because the angle is a decimal.
+static uint64_t reduceDegrees (const SlowFloat& arg)
+ {
+   uint64_t sig = magnitude(arg);
+   if (arg.exponent >= 8)
+    {
+         // 10^k mod 360 is 280 for every k from three up.
+      uint64_t scale = 1U;
+      for (int16_t i = 8; (i < arg.exponent) && (i < 11); ++i) scale = scale * 10U % 360U;
+      return sig % 360U * scale % 360U * MIN_SIGNIFICAND;
+    }
+   uint64_t divisor = POWERS_OF_TEN[8 - arg.exponent];
+   return sig / divisor % 360U * MIN_SIGNIFICAND + sig % divisor * POWERS_OF_TEN[arg.exponent];
+ }
+
+   // The series for sin(u) / u (first is 2) or cos(u) (first is 1) in u^2, or sinh(u) / u and cosh(u) if not alternate.
+static Fixed evenSeries (const Fixed& u2, uint64_t first, bool alternate, uint64_t& terms)
+ {
+   Fixed plus = fixedInt(1U, u2.n), minus = fixedInt(0U, u2.n), term = plus;
+   terms = 1U;
+   for (uint64_t i = first; ; i += 2U)
+    {
+      term = fixedDivSmall(fixedMul(term, u2), i * (i + 1U));
+      if (fixedIsZero(term)) break;
+      if (alternate && (0U != (terms & 1U))) minus = fixedAdd(minus, term);
+      else plus = fixedAdd(plus, term);
+      ++terms;
+    }
+   return fixedSub(plus, minus);
+ }
+
+   // The sine and cosine of the magnitude of an angle in degrees.
+static void trigDegrees (const SlowFloat& arg, int n, Approx& sine, Approx& cosine)
+ {
+   const Fixed degree = fixedTruncate(constants().degree, n);
+   uint64_t terms = 0U, more = 0U;
+   sine.sign = false;
+   cosine.sign = false;
+   cosine.shift = 0;
+
+   if (arg.exponent < 0)
+    {
+         // Below one degree, the angle is t * 10^shift radians, with t at least a thousandth,
+         // and the sine keeps its relative precision however small the angle is.
+      Fixed t = fixedShiftRight(fixedMulSmall(degree, magnitude(arg)), 9U);
+      int64_t shift = arg.exponent + 1;
+      Fixed u2 = fixedShiftRight(fixedMul(t, t), static_cast<uint64_t>(-2 * shift));
+      sine.a = fixedMul(t, evenSeries(u2, 2U, true, terms));
+      cosine.a = evenSeries(u2, 1U, true, more);
+      sine.shift = shift;
+      sine.err = 8U * (((terms > more) ? terms : more) + 3U);
+      cosine.err = sine.err;
+      return;
+    }
+
+      // Otherwise, work from the angle within the octant, which is exact, split into whole degrees
+      // from the table and the part of a degree left over.
+   uint64_t angle = reduceDegrees(arg);
+   uint64_t quadrant = angle / 9000000000U;
+   uint64_t rest = angle % 9000000000U;
+   bool swap = rest > 4500000000U;
+   if (swap) rest = 9000000000U - rest;
+
+   uint64_t whole = rest / MIN_SIGNIFICAND;
+   Fixed u = fixedDivSmall(fixedMulSmall(degree, rest % MIN_SIGNIFICAND), MIN_SIGNIFICAND);
+   Fixed u2 = fixedMul(u, u);
+   Fixed sinPart = fixedMul(u, evenSeries(u2, 2U, true, terms));
+   Fixed cosPart = evenSeries(u2, 1U, true, more);
+   const Fixed sinWhole = fixedTruncate(constants().sinDegrees[whole], n);
+   const Fixed cosWhole = fixedTruncate(constants().cosDegrees[whole], n);
+   Fixed s = fixedAdd(fixedMul(sinWhole, cosPart), fixedMul(cosWhole, sinPart));
+   Fixed c = fixedSub(fixedMul(cosWhole, cosPart), fixedMul(sinWhole, sinPart));
+
+   const Fixed& sinRest = swap ? c : s;
+   const Fixed& cosRest = swap ? s : c;
+   bool odd = 0U != (quadrant & 1U);
+   sine.a = odd ? cosRest : sinRest;
+   sine.sign = quadrant >= 2U;
+   cosine.a = odd ? sinRest : cosRest;
+   cosine.sign = (1U == quadrant) || (2U == quadrant);
+   sine.shift = 0;
+   sine.err = 32U + 8U * ((terms > more) ? terms : more);
+   cosine.err = sine.err;
+ }
+
+static void sinKernel (const SlowFloat& arg, const SlowFloat&, int n, Approx& result)
+ {
+   Approx cosine;
+   trigDegrees(arg, n, result, cosine);
+   result.sign = result.sign != getSign(arg);
+ }
+
+static void cosKernel (const SlowFloat& arg, const SlowFloat&, int n, Approx& result)
+ {
+   Approx sine;
+   trigDegrees(arg, n, sine, result);
+ }
+
+static void tanKernel (const SlowFloat& arg, const SlowFloat&, int n, Approx& result)
+ {
+   Approx sine, cosine;
+   trigDegrees(arg, n, sine, cosine);
+   fixedDivide(sine.a, sine.err, cosine.a, cosine.err, result);
+   result.shift += sine.shift - cosine.shift;
+   result.sign = (sine.sign != cosine.sign) != getSign(arg);
+ }
+
+static void degToRadKernel (const SlowFloat& arg, const SlowFloat&, int n, Approx& result)
+ {
+   result.a = fixedMul(fixedFromDecimal(magnitude(arg), -8, n), fixedTruncate(constants().degree, n));
+   result.shift = arg.exponent;
+   result.err = 32U;
+   result.sign = getSign(arg);
+ }
+
+static void radToDegKernel (const SlowFloat& arg, const SlowFloat&, int n, Approx& result)
+ {
+   result.a = fixedMul(fixedFromDecimal(magnitude(arg), -8, n), fixedTruncate(constants().radian, n));
+   result.shift = arg.exponent;
+   result.err = 32U;
+   result.sign = getSign(arg);
+ }
+
+   // An exact Approx for the magnitude of arg.
+static void approxOf (const SlowFloat& arg, int n, Approx& result)
+ {
+   result.a = fixedFromDecimal(magnitude(arg), -9, n);
+   result.shift = arg.exponent + 1;
+   result.err = 0U;
+   result.sign = false;
+ }
+
+   // sqrt(arg), for arg in [0.01, 2). The result is within two hundred units, and five more for each unit
+   // of error in arg.
+static Fixed fixedSqrt (const Fixed& arg)
+ {
+   const int n = arg.n;
+
+      // Newton's method, from above, for the nine-digit integer square root, which seeds 1 / sqrt(arg).
+   uint64_t scaled = static_cast<uint64_t>(arg.d[0]) * WIDE_BIAS + static_cast<uint64_t>(arg.d[1]) * BIAS + arg.d[2];
+   uint64_t root = 2U * BIAS;
+   for (;;)
+    {
+      uint64_t next = (root + scaled / root) / 2U;
+      if (next >= root) break;
+      root = next;
+    }
+   Fixed y = fixedMulSmall(fixedDivSmall(fixedInt(MIN_SIGNIFICAND, n), root), 10U);
+
+   const Fixed one = fixedInt(1U, n);
+   for (int digits = 8; digits < 9 * n + 16; digits *= 2)
+    {
+      Fixed product = fixedMul(fixedMul(arg, y), y);
+      if (fixedCompare(product, one) <= 0)
+         y = fixedAdd(y, fixedDivSmall(fixedMul(y, fixedSub(one, product)), 2U));
+      else
+         y = fixedSub(y, fixedDivSmall(fixedMul(y, fixedSub(product, one)), 2U));
+    }
+   return fixedMul(arg, y);
+ }
+
+   // sqrt(1 - x^2) = sqrt((1 - x)(1 + x)), for |x| below one, keeping its relative precision however
+   // close x is to one.
+static void sqrtComplement (const SlowFloat& arg, int n, Approx& result)
+ {
+   const Fixed one = fixedInt(1U, n);
+   Fixed x = fixedFromDecimal(magnitude(arg), arg.exponent - 8, n);
+   Fixed below = fixedSub(one, x);
+   int64_t power = fixedLead(below) + 1;
+   if (power > 0) power = 0; // x is too small for this precision.
+   Fixed w = fixedMul(fixedShiftLeft(below, static_cast<uint64_t>(-power)), fixedAdd(one, x));
+   if (0 != (power & 1))
+    {
+      w = fixedShiftRight(w, 1U);
+      ++power;
+    }
+
+   result.a = fixedSqrt(w);
+   result.shift = power / 2;
+   result.err = 220U;
+   result.sign = false;
+ }
+
+   // The series for atan(v) / v in v^2.
+static Fixed atanSeries (const Fixed& v2, uint64_t& terms)
+ {
+   Fixed plus = fixedInt(1U, v2.n), minus = fixedInt(0U, v2.n), power = plus;
+   terms = 1U;
+   for (uint64_t i = 3U; ; i += 2U)
+    {
+      power = fixedMul(power, v2);
+      Fixed term = fixedDivSmall(power, i);
+      if (fixedIsZero(term)) break;
+      if (0U != (terms & 1U)) minus = fixedAdd(minus, term);
+      else plus = fixedAdd(plus, term);
+      ++terms;
+    }
+   return fixedSub(plus, minus);
+ }
+
+   // atan(v) in degrees, for v = t * 10^shift no more than tan(46 degrees), with t known to within err units.
+   // Otherwise, atan(v) = j + atan((v cos(j) - sin(j)) / (cos(j) + v sin(j))), for the whole degree j
+   // from the table just below it.
+static void atanFixed (const Fixed& t, uint64_t err, int64_t shift, Approx& result)
+ {
+   const int n = t.n;
+   const Constants& c = constants();
+   const Fixed radian = fixedTruncate(c.radian, n);
+   uint64_t terms;
+   result.sign = false;
+
+   if (shift < -1)
+    {
+         // A small v keeps its relative precision.
+      Fixed v2 = fixedShiftRight(fixedMul(t, t), static_cast<uint64_t>(-2 * shift));
+      result.a = fixedMul(fixedMul(t, radian), atanSeries(v2, terms));
+      result.shift = shift;
+      result.err = errorProduct(errorSum(err, 2U * terms + 4U), 64U);
+      return;
+    }
+
+   Fixed v = t;
+   if (shift < 0) v = fixedShiftRight(t, 1U);
+   else if (shift > 0) v = fixedShiftLeft(t, 1U);
+   err = errorShift(err, shift);
+
+   uint64_t low = 0U, high = 45U;
+   while (low < high)
+    {
+      uint64_t mid = (low + high + 1U) / 2U;
+      if (fixedCompare(fixedMul(v, fixedTruncate(c.cosDegrees[mid], n)), fixedTruncate(c.sinDegrees[mid], n)) >= 0)
+         low = mid;
+      else
+         high = mid - 1U;
+    }
+
+   const Fixed sinWhole = fixedTruncate(c.sinDegrees[low], n);
+   const Fixed cosWhole = fixedTruncate(c.cosDegrees[low], n);
+   Fixed num = fixedSub(fixedMul(v, cosWhole), sinWhole);
+   Fixed den = fixedAdd(cosWhole, fixedMul(v, sinWhole));
+   Fixed z = fixedDivSmall(fixedMul(num, fixedReciprocal(fixedDivSmall(den, 2U))), 2U);
+   Fixed part = fixedMul(z, atanSeries(fixedMul(z, z), terms));
+
+   result.a = fixedAdd(fixedInt(low, n), fixedMul(radian, part));
+   result.shift = 0;
+   result.err = errorProduct(errorSum(errorProduct(err, 2U), terms + 12U), 64U);
+ }
+
+   // atan(num / den) in degrees, for a quotient no more than tan(46 degrees).
+static void atanQuotient (const Approx& num, const Approx& den, Approx& result)
+ {
+   Approx quotient;
+   fixedDivide(num.a, num.err, den.a, den.err, quotient);
+   quotient.shift += num.shift - den.shift;
+   if (0U != quotient.a.d[0])
+    {
+      quotient.a = fixedShiftRight(quotient.a, 1U);
+      quotient.err = errorShift(quotient.err, -1);
+      ++quotient.shift;
+    }
+   atanFixed(quotient.a, quotient.err, quotient.shift, result);
+ }
+
+   // degrees - result, for a result no more than degrees.
+static void complement (uint64_t degrees, Approx& result)
+ {
+   Fixed a = (result.shift < 0) ? fixedShiftRight(result.a, static_cast<uint64_t>(-result.shift)) : result.a;
+   result.err = errorSum(errorShift(result.err, result.shift), 1U);
+   result.a = fixedSub(fixedInt(degrees, a.n), a);
+   result.shift = 0;
+ }
+
+   // The angle of (x, y) in degrees. Neither may be zero or infinite, and they may not have the same magnitude.
+static void atan2Kernel (const SlowFloat& y, const SlowFloat& x, int n, Approx& result)
+ {
+   Approx across, up;
+   approxOf(x, n, across);
+   approxOf(y, n, up);
+
+   if ((getSign(y) ? -y : y) > (getSign(x) ? -x : x))
+    {
+      atanQuotient(across, up, result);
+      complement(90U, result);
+    }
+   else
+    {
+      atanQuotient(up, across, result);
+    }
+   if (getSign(x)) complement(180U, result);
+   result.sign = getSign(y);
+ }
+
+   // Whether the magnitude of arg is above sqrt(1/2).
+static bool isSteep (const SlowFloat& arg)
+ {
+   return (-1 == arg.exponent) && (magnitude(arg) > 707106781U);
+ }
+
+   // The argument must be below one in magnitude.
+static void asinKernel (const SlowFloat& arg, const SlowFloat&, int n, Approx& result)
+ {
+   Approx opposite, adjacent;
+   approxOf(arg, n, opposite);
+   sqrtComplement(arg, n, adjacent);
+   if (isSteep(arg))
+    {
+      atanQuotient(adjacent, opposite, result);
+      complement(90U, result);
+    }
+   else
+    {
+      atanQuotient(opposite, adjacent, result);
+    }
+   result.sign = getSign(arg);
+ }
+
+   // The argument must be below one in magnitude, and not zero.
+static void acosKernel (const SlowFloat& arg, const SlowFloat&, int n, Approx& result)
+ {
+   Approx opposite, adjacent;
+   approxOf(arg, n, opposite);
+   sqrtComplement(arg, n, adjacent);
+   if (isSteep(arg))
+    {
+      atanQuotient(adjacent, opposite, result);
+    }
+   else
+    {
+      atanQuotient(opposite, adjacent, result);
+      complement(90U, result);
+    }
+   if (getSign(arg)) complement(180U, result);
+   result.sign = false;
+ }
+
+   // sinh and cosh of the magnitude of an argument below 10^5.
+static void hyperbolic (const SlowFloat& arg, int n, Approx& sinh, Approx& cosh)
+ {
+   sinh.sign = false;
+   cosh.sign = false;
+
+   if (arg.exponent < 0)
+    {
+         // Below one, by the series, so that sinh keeps its relative precision.
+      uint64_t terms, more;
+      Fixed t = fixedFromDecimal(magnitude(arg), -9, n);
+      int64_t shift = arg.exponent + 1;
+      Fixed u2 = fixedShiftRight(fixedMul(t, t), static_cast<uint64_t>(-2 * shift));
+      sinh.a = fixedMul(t, evenSeries(u2, 2U, false, terms));
+      cosh.a = evenSeries(u2, 1U, false, more);
+      sinh.shift = shift;
+      cosh.shift = 0;
+      sinh.err = 4U * (((terms > more) ? terms : more) + 2U);
+      cosh.err = sinh.err;
+      return;
+    }
+
+      // Otherwise, from exp(x) and exp(-x), aligned to the larger.
+   Fixed x = fixedFromDecimal(magnitude(arg), arg.exponent - 8, n);
+   Approx up, down;
+   expFixed(x, false, 0U, up);
+   expFixed(x, true, 0U, down);
+   Fixed small = fixedShiftRight(down.a, static_cast<uint64_t>(up.shift - down.shift));
+   uint64_t err = errorSum(errorSum(up.err, errorShift(down.err, down.shift - up.shift)), 2U);
+
+   sinh.a = fixedDivSmall(fixedSub(up.a, small), 2U);
+   cosh.a = fixedDivSmall(fixedAdd(up.a, small), 2U);
+   sinh.shift = up.shift;
+   cosh.shift = up.shift;
+   sinh.err = err;
+   cosh.err = err;
+ }
+
+static void sinhKernel (const SlowFloat& arg, const SlowFloat&, int n, Approx& result)
+ {
+   Approx cosh;
+   hyperbolic(arg, n, result, cosh);
+   result.sign = getSign(arg);
+ }
+
+static void coshKernel (const SlowFloat& arg, const SlowFloat&, int n, Approx& result)
+ {
+   Approx sinh;
+   hyperbolic(arg, n, sinh, result);
+ }
+
+static void tanhKernel (const SlowFloat& arg, const SlowFloat&, int n, Approx& result)
+ {
+   Approx sinh, cosh;
+   hyperbolic(arg, n, sinh, cosh);
+   fixedDivide(sinh.a, sinh.err, cosh.a, cosh.err, result);
+   result.shift += sinh.shift - cosh.shift;
+   result.sign = getSign(arg);
+ }
+
+   // cbrt(x) = exp(ln(x) / 3). The magnitude of the argument must not be one.
+static void cbrtKernel (const SlowFloat& arg, const SlowFloat&, int n, Approx& result)
+ {
+   Approx ln;
+   logKernel(arg, arg, n, ln);
+   expFixed(fixedDivSmall(ln.a, 3U), ln.sign, errorSum(ln.err / 3U, 2U), result);
+   result.sign = getSign(arg);
+ }
+
+   // Whether guess is exactly lhs^power, for an integral power: only then do the directed roundings agree.
+static bool isExactPower (const SlowFloat& lhs, const SlowFloat& power, const SlowFloat& guess)
+ {
+   SlowFloat_Round_Mode saved = mode;
+   mode = ROUND_ZERO;
+   SlowFloat low = pow(lhs, power);
+   mode = ROUND_AWAY;
+   SlowFloat high = pow(lhs, power);
+   mode = saved;
+   return (low == guess) && (high == guess);
+ }
+
+   // Integral logarithms, like log base 2 of 1024, are common.
+static bool exactLog (const SlowFloat& base, const SlowFloat& arg, const SlowFloat& guess)
+ {
+   int64_t k;
+   if (!toInt64(guess, k)) return false;
+   return isExactPower(base, guess, arg);
+ }
+
+   // base^(p / q) is exactly guess when guess^q is exactly base^p.
+static bool exactPow (const SlowFloat& base, const SlowFloat& power, const SlowFloat& guess)
+ {
+   if (isZero(guess) || isInf(guess) || (power.exponent < -10) || (power.exponent > 7)) return false;
+   int64_t p = magnitude(power), q = POWERS_OF_TEN[8 - power.exponent];
+   while ((0 == p % 2) && (0 == q % 2)) { p /= 2; q /= 2; }
+   while ((0 == p % 5) && (0 == q % 5)) { p /= 5; q /= 5; }
+   if (q > 1000) return false;
+
+   SlowFloat raised = fromInt64(getSign(power) ? -p : p);
+   SlowFloat_Round_Mode saved = mode;
+   mode = ROUND_ZERO;
+   SlowFloat target = pow(base, raised);
+   mode = saved;
+   return isExactPower(base, raised, target) && isExactPower(guess, fromInt64(q), target);
+ }
+
+static bool exactCbrt (const SlowFloat& arg, const SlowFloat&, const SlowFloat& guess)
+ {
+   return isExactPower(guess, SlowFloat(300000000U, 0), arg);
+ }
+
+SlowFloat exp (const SlowFloat& arg)
+ {
+   if (isNaN(arg)) return arg;
+   if (isInf(arg)) return getSign(arg) ? sfZero : arg;
+   if (isZero(arg)) return SlowFloat(MIN_SIGNIFICAND, 0);
+
+   if (arg.exponent < -20) return nearOne(getSign(arg));
+   if (arg.exponent > 4) return getSign(arg) ? sfZero : sfInf;
+
+   return evaluate(expKernel, arg, arg);
+ }
+
+SlowFloat log (const SlowFloat& arg)
+ {
+   if (isNaN(arg)) return arg;
+   if (isZero(arg)) return -sfInf;
+   if (getSign(arg)) return sfNaN;
+   if (isInf(arg)) return arg;
+   if ((MIN_SIGNIFICAND == arg.significand) && (0 == arg.exponent)) return sfZero;
+
+   return evaluate(logKernel, arg, arg);
+ }
+
+SlowFloat log (const SlowFloat& base, const SlowFloat& arg)
+ {
+      // Leave the special cases to division.
+   const SlowFloat one = SlowFloat(MIN_SIGNIFICAND, 0);
+   if (isNaN(base) || isNaN(arg) || isInf(base) || isInf(arg) || isZero(base) || isZero(arg) ||
+         getSign(base) || getSign(arg) || (one == base) || (one == arg))
+      return log(arg) / log(base);
+   if (base == arg) return one;
+
+   return evaluate(logBaseKernel, base, arg, exactLog);
+ }
+
+   // The values of sin(30k) in halves, for k from 0 to 11, where they are rational. 3 marks the rest.
+static const int SINE_HALVES [] = { 0, 1, 3, 2, 3, 1, 0, -1, 3, -2, 3, -1 };
+
+   // The sine of a reduced angle, offset by a number of thirty degree steps, if it is rational.
+static bool exactSine (uint64_t angle, uint64_t offset, SlowFloat& result)
+ {
+   if (0U != angle % 3000000000U) return false;
+   int halves = SINE_HALVES[(angle / 3000000000U + offset) % 12U];
+   if (3 == halves) return false;
+
+   if (0 == halves) result = sfZero;
+   else if (1 == (halves < 0 ? -halves : halves)) result = SlowFloat(5U * MIN_SIGNIFICAND, -1);
+   else result = SlowFloat(MIN_SIGNIFICAND, 0);
+   if (halves < 0) result = -result;
+   return true;
+ }
+
+SlowFloat sind (const SlowFloat& arg)
+ {
+   if (isNaN(arg)) return arg;
+   if (isInf(arg)) return sfNaN;
+   if (isZero(arg)) return arg;
+
+   SlowFloat result;
+   if ((arg.exponent >= 0) && exactSine(reduceDegrees(arg), 0U, result))
+      return getSign(arg) ? -result : result;
+
+   return evaluate(sinKernel, arg, arg);
+ }
+
+SlowFloat cosd (const SlowFloat& arg)
+ {
+   if (isNaN(arg)) return arg;
+   if (isInf(arg)) return sfNaN;
+   if (isZero(arg)) return SlowFloat(MIN_SIGNIFICAND, 0);
+
+   if (arg.exponent < -20) return nearOne(true);
+   SlowFloat result;
+   if ((arg.exponent >= 0) && exactSine(reduceDegrees(arg), 3U, result))
+      return result;
+
+   return evaluate(cosKernel, arg, arg);
+ }
+
+   // The values of tan(45k) for k from 0 to 7, with 2 for infinity.
+static const int TANGENTS [] = { 0, 1, 2, -1, 0, 1, -2, -1 };
+
+SlowFloat tand (const SlowFloat& arg)
+ {
+   if (isNaN(arg)) return arg;
+   if (isInf(arg)) return sfNaN;
+   if (isZero(arg)) return arg;
+
+   uint64_t angle = (arg.exponent >= 0) ? reduceDegrees(arg) : 1U;
+   if (0U == angle % 4500000000U)
+    {
+      int tangent = TANGENTS[angle / 4500000000U];
+      SlowFloat result = sfZero;
+      if (2 == (tangent < 0 ? -tangent : tangent)) result = sfInf;
+      else if (0 != tangent) result = SlowFloat(MIN_SIGNIFICAND, 0);
+      if ((tangent < 0) != getSign(arg)) result = -result;
+      return result;
+    }
+
+   return evaluate(tanKernel, arg, arg);
+ }
+
+SlowFloat degToRad (const SlowFloat& arg)
+ {
+   if (isNaN(arg) || isInf(arg) || isZero(arg)) return arg;
+   return evaluate(degToRadKernel, arg, arg);
+ }
+
+SlowFloat radToDeg (const SlowFloat& arg)
+ {
+   if (isNaN(arg) || isInf(arg) || isZero(arg)) return arg;
+   return evaluate(radToDegKernel, arg, arg);
+ }
+
+   // A result within 10^-15 of a whole number of degrees, and below it if below.
+static SlowFloat nearDegrees (uint64_t degrees, bool below, bool sign)
+ {
+   Wide result = toWide(fromInt64(static_cast<int64_t>(degrees)));
+   if (below) --result.m;
+   result.sticky = true;
+   return roundWide(sign, result);
+ }
+
+   // A result nearer to arg than eighteen digits can tell, beyond it, or short of it if down.
+static SlowFloat nudge (const SlowFloat& arg, bool down)
+ {
+   Wide result = toWide(arg);
+   if (down)
+    {
+      --result.m;
+      if (result.m < WIDE_MIN)
+       {
+         result.m = WIDE_BIAS - 1U;
+         --result.exponent;
+       }
+    }
+   result.sticky = true;
+   return roundWide(getSign(arg), result);
+ }
+
+SlowFloat asind (const SlowFloat& arg)
+ {
+   if (isNaN(arg)) return arg;
+   if (isZero(arg)) return arg;
+
+   const SlowFloat one = SlowFloat(MIN_SIGNIFICAND, 0);
+   SlowFloat size = getSign(arg) ? -arg : arg;
+   if (size > one) return sfNaN;
+
+   SlowFloat result;
+   if (one == size) result = SlowFloat(900000000U, 1);
+   else if (SlowFloat(5U * MIN_SIGNIFICAND, -1) == size) result = SlowFloat(300000000U, 1);
+   else return evaluate(asinKernel, arg, arg);
+   return getSign(arg) ? -result : result;
+ }
+
+SlowFloat acosd (const SlowFloat& arg)
+ {
+   if (isNaN(arg)) return arg;
+   if (isZero(arg)) return SlowFloat(900000000U, 1);
+
+   const SlowFloat one = SlowFloat(MIN_SIGNIFICAND, 0);
+   SlowFloat size = getSign(arg) ? -arg : arg;
+   if (size > one) return sfNaN;
+
+   if (arg.exponent < -20) return nearDegrees(90U, !getSign(arg), false);
+   if (one == size) return getSign(arg) ? SlowFloat(180000000U, 2) : sfZero;
+   if (SlowFloat(5U * MIN_SIGNIFICAND, -1) == size)
+      return getSign(arg) ? SlowFloat(120000000U, 2) : SlowFloat(600000000U, 1);
+   return evaluate(acosKernel, arg, arg);
+ }
+
+SlowFloat atand (const SlowFloat& arg)
+ {
+   return atan2d(arg, SlowFloat(MIN_SIGNIFICAND, 0));
+ }
+
+SlowFloat atan2d (const SlowFloat& y, const SlowFloat& x)
+ {
+   if (isNaN(y)) return y;
+   if (isNaN(x)) return x;
+
+      // The angles that are whole multiples of 45 degrees, following C's atan2 for zeros and infinities.
+   bool left = getSign(x);
+   bool whole = true;
+   uint64_t degrees = 0U;
+   if (isZero(y) || (isInf(x) && !isInf(y))) degrees = left ? 180U : 0U;
+   else if (isZero(x) || isInf(y)) degrees = isInf(x) ? (left ? 135U : 45U) : 90U;
+   else if ((getSign(y) ? -y : y) == (getSign(x) ? -x : x)) degrees = left ? 135U : 45U;
+   else whole = false;
+   if (whole)
+    {
+      SlowFloat result = fromInt64(static_cast<int64_t>(degrees));
+      return getSign(y) ? -result : result;
+    }
+
+      // A tiny ratio to be added to or taken from a whole angle.
+   int64_t difference = static_cast<int64_t>(y.exponent) - x.exponent;
+   if (difference > 20) return nearDegrees(90U, !left, getSign(y));
+   if ((difference < -20) && left) return nearDegrees(180U, true, getSign(y));
+
+   return evaluate(atan2Kernel, y, x);
+ }
+
+SlowFloat sinh (const SlowFloat& arg)
+ {
+   if (isNaN(arg) || isInf(arg) || isZero(arg)) return arg;
+
+   if (arg.exponent < -20) return nudge(arg, false);
+   if (arg.exponent > 4) return getSign(arg) ? sfNInf : sfInf;
+   return evaluate(sinhKernel, arg, arg);
+ }
+
+SlowFloat cosh (const SlowFloat& arg)
+ {
+   if (isNaN(arg)) return arg;
+   if (isInf(arg)) return sfInf;
+   if (isZero(arg)) return SlowFloat(MIN_SIGNIFICAND, 0);
+
+   if (arg.exponent < -20) return nearOne(false);
+   if (arg.exponent > 4) return sfInf;
+   return evaluate(coshKernel, arg, arg);
+ }
+
+SlowFloat tanh (const SlowFloat& arg)
+ {
+   const SlowFloat one = SlowFloat(MIN_SIGNIFICAND, 0);
+   if (isNaN(arg) || isZero(arg)) return arg;
+   if (isInf(arg)) return getSign(arg) ? -one : one;
+
+      // Past 23, tanh is within 10^-19 of one.
+   if (arg.exponent < -20) return nudge(arg, true);
+   if ((getSign(arg) ? -arg : arg) >= SlowFloat(230000000U, 1)) return nudge(getSign(arg) ? -one : one, true);
+   return evaluate(tanhKernel, arg, arg);
+ }
+
+SlowFloat cbrt (const SlowFloat& arg)
+ {
+   if (isNaN(arg) || isInf(arg) || isZero(arg)) return arg;
+   if ((MIN_SIGNIFICAND == magnitude(arg)) && (0 == arg.exponent)) return arg;
+   return evaluate(cbrtKernel, arg, arg, exactCbrt);
+ }
+
+static SlowFloat positivePow (const SlowFloat& size, const SlowFloat& power);
+
+   // pow for a power that is not an integer that fits in an int64_t: a fraction, or one too large,
+   // which must be even, or one that is infinite or NaN.
+static SlowFloat fractionalPow (const SlowFloat& base, const SlowFloat& power)
+ {
+   const SlowFloat one = SlowFloat(MIN_SIGNIFICAND, 0);
+   if (one == base) return one;
+   if (isNaN(base)) return base;
+   if (isNaN(power)) return power;
+
+   SlowFloat size = getSign(base) ? -base : base;
+   if (isInf(power))
+    {
+      if (one == size) return one;
+      if ((size < one) == getSign(power)) return sfInf;
+      return sfZero;
+    }
+
+   if (isZero(base) || isInf(base))
+    {
+      if (isZero(base) == getSign(power)) return sfInf;
+      return sfZero;
+    }
+   if (getSign(base) && (power.exponent < 8)) return sfNaN;
+   if (one == size) return one;
+
+   if ((5U * MIN_SIGNIFICAND == power.significand) && (-1 == power.exponent)) return sqrt(size);
+   return positivePow(size, power);
+ }
+
+   // size^power, for a positive, finite size that is not one.
+static SlowFloat positivePow (const SlowFloat& size, const SlowFloat& power)
+ {
+      // Decide overflow, underflow, and results too close to one for the kernel from a nine-digit estimate.
+   SlowFloat product = log(size) * power;
+   const SlowFloat limit = SlowFloat(8U * MIN_SIGNIFICAND, 4);
+   if (product > limit) return sfInf;
+   if (product < -limit) return sfZero;
+   if (product.exponent < -21) return nearOne(getSign(product));
+
+   return evaluate(powKernel, size, power, exactPow);
+ }
+
+SlowFloat pow (const SlowFloat& base, const SlowFloat& power)
+ {
+      // Anything to the zero is one, even NaN.
+   if (isZero(power)) return SlowFloat(MIN_SIGNIFICAND, 0);
+
+      // Find the integral value of power, if it has one that fits.
+   bool integral = false;
+   int64_t n = 0;
+   if (!isInf(power) && !isNaN(power) && (power.exponent >= 0) && (power.exponent <= 17))
+    {
+      uint64_t sig = power.significand ^ (getSign(power) ? 0xFFFFFFFFU : 0U);
+      if (power.exponent >= 8)
+       {
+         for (int16_t i = 8; i < power.exponent; ++i) sig *= 10;
+         integral = true;
+       }
+      else
+       {
+         uint64_t divisor = 1;
+         for (int16_t i = power.exponent; i < 8; ++i) divisor *= 10;
+         integral = 0 == (sig % divisor);
+         sig /= divisor;
+       }
+      n = getSign(power) ? -static_cast<int64_t>(sig) : static_cast<int64_t>(sig);
+    }
+
+   if (!integral)
+      return fractionalPow(base, power);
+
+   if (isNaN(base)) return base;
+
+   bool resultSign = getSign(base) && (0 != (n & 1));
+   bool large = isInf(base);
+   if (isZero(base) || isInf(base))
+    {
+      if ((n < 0) == large)
+       {
+         if (resultSign) return -sfZero;
+         return sfZero;
+       }
+      if (resultSign) return -sfInf;
+      return sfInf;
+    }
+
+   Wide factor = toWide(base);
+   if (n < 0)
+    {
+         // Raise the reciprocal, computed by long division to eighteen digits.
+      uint64_t sig = factor.m / BIAS;
+      if (MIN_SIGNIFICAND == sig)
+       {
+         factor.exponent = -factor.exponent;
+       }
+      else
+       {
+         uint64_t quot = 0, rem = 1;
+         for (int i = 0; i < 26; ++i)
+          {
+            rem *= 10;
+            quot = quot * 10 + rem / sig;
+            rem %= sig;
+          }
+         factor.m = quot;
+         factor.exponent = -1 - factor.exponent;
+         factor.sticky = 0 != rem;
+       }
+    }
+
+      // Exponentiation by squaring. A factor that is out of range will only be made worse
+      // by the larger factors still to come, so we can stop early.
+   const uint64_t count = (n < 0) ? (0 - static_cast<uint64_t>(n)) : static_cast<uint64_t>(n);
+   uint64_t bits = count;
+   bool first = true;
+   Wide result = factor;
+   for (;;)
+    {
+      if (0 != (bits & 1))
+       {
+         result = first ? factor : multiply(result, factor);
+         first = false;
+       }
+      bits >>= 1;
+      if ((0 == bits) || (factor.exponent > MAX_EXPONENT) || (factor.exponent < (MIN_EXPONENT - 1))) break;
+      factor = multiply(factor, factor);
+    }
+   if (0 != bits)
+      result.exponent = factor.exponent;
+   if (!result.sticky)
+      return roundWide(resultSign, result);
+
+      // Every truncation made a factor low by less than 10^-17. Each one is raised to at most the power
+      // of count, and there are fewer than sixty-four multiplies, so the result is low by less than
+      // (3 count + 64) 10^-17. If that can't change the rounding, we're done.
+   SlowFloat low = roundWide(resultSign, result);
+   if (count < WIDE_MIN / 64U)
+    {
+      Wide high = result;
+      high.m += 30U * count + 700U;
+      if (high.m >= WIDE_BIAS)
+       {
+         high.m /= 10U;
+         ++high.exponent;
+       }
+      SlowFloat other = roundWide(resultSign, high);
+      if ((low.significand == other.significand) && (low.exponent == other.exponent)) return low;
+    }
+
+   SlowFloat rounded = positivePow(getSign(base) ? -base : base, power);
+   return resultSign ? -rounded : rounded;
+ }
+
+   // The batched operations are plain loops in this file, so that the scalar operation can be inlined.
+#define BATCHED(name,op) \
+void name (const SlowFloat* lhs, const SlowFloat& rhs, SlowFloat* result, size_t count) \
+ { \
+   for (size_t i = 0U; i < count; ++i) \
+      result[i] = lhs[i] op rhs; \
+ } \
+ \
+void name (const SlowFloat& lhs, const SlowFloat* rhs, SlowFloat* result, size_t count) \
+ { \
+   for (size_t i = 0U; i < count; ++i) \
+      result[i] = lhs op rhs[i]; \
+ } \
+ \
+void name (const SlowFloat* lhs, const SlowFloat* rhs, SlowFloat* result, size_t count) \
+ { \
+   for (size_t i = 0U; i < count; ++i) \
+      result[i] = lhs[i] op rhs[i]; \
+ }
+
+BATCHED(add, +)
+BATCHED(sub, -)
+BATCHED(mul, *)
+BATCHED(div, /)
+
+#undef BATCHED
+
  }
@@ -71,6 +71,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <string>
 #include <cstdint>
+#include <cstddef>
 
 namespace SlowFloat
  {
@@ -87,7 +88,8 @@ enum SlowFloat_Round_Mode
    ROUND_AWAY
  };
 
-extern SlowFloat_Round_Mode mode;
+   // Each thread has its own rounding mode, which starts as ROUND_TIES_EVEN.
+extern thread_local SlowFloat_Round_Mode mode;
 
 class SlowFloat final
  {
@@ -108,6 +110,10 @@ public:
    std::string toString (const SlowFloat&);
    SlowFloat fromString (const std::string&);
 
+      // toInt64 only succeeds if the value is an integer that fits. fromInt64 rounds if it must.
+   bool toInt64 (const SlowFloat&, int64_t&);
+   SlowFloat fromInt64 (int64_t);
+
    SlowFloat operator - (const SlowFloat&);
 
    SlowFloat operator + (const SlowFloat&, const SlowFloat&);
@@ -122,6 +128,49 @@ public:
    bool operator == (const SlowFloat&, const SlowFloat&);
    bool operator != (const SlowFloat&, const SlowFloat&);
 
+      // These are computed without going through double. sqrt and pow are correctly rounded. hypot
+      // carries eighteen digits and rounds once, so it is exact whenever the result is representable.
+   SlowFloat sqrt (const SlowFloat&);
+   SlowFloat hypot (const SlowFloat&, const SlowFloat&);
+   SlowFloat pow (const SlowFloat&, const SlowFloat&);
+
+      // These are correctly rounded over the whole exponent range. log with two arguments takes the base
+      // first. The trigonometric functions work in degrees, which a decimal argument reduces exactly.
+   SlowFloat exp (const SlowFloat&);
+   SlowFloat log (const SlowFloat&);
+   SlowFloat log (const SlowFloat& base, const SlowFloat& arg);
+   SlowFloat sind (const SlowFloat&);
+   SlowFloat cosd (const SlowFloat&);
+   SlowFloat tand (const SlowFloat&);
+   SlowFloat degToRad (const SlowFloat&);
+   SlowFloat radToDeg (const SlowFloat&);
+
+      // These are correctly rounded too. The inverse trigonometric functions return degrees, and atan2d
+      // takes y first, like C's atan2.
+   SlowFloat asind (const SlowFloat&);
+   SlowFloat acosd (const SlowFloat&);
+   SlowFloat atand (const SlowFloat&);
+   SlowFloat atan2d (const SlowFloat& y, const SlowFloat& x);
+   SlowFloat sinh (const SlowFloat&);
+   SlowFloat cosh (const SlowFloat&);
+   SlowFloat tanh (const SlowFloat&);
+   SlowFloat cbrt (const SlowFloat&);
+
+      // Element-wise arithmetic over arrays of count values, with either side possibly held fixed.
+      // The result may be the same array as an operand.
+   void add (const SlowFloat*, const SlowFloat&, SlowFloat*, size_t);
+   void add (const SlowFloat&, const SlowFloat*, SlowFloat*, size_t);
+   void add (const SlowFloat*, const SlowFloat*, SlowFloat*, size_t);
+   void sub (const SlowFloat*, const SlowFloat&, SlowFloat*, size_t);
+   void sub (const SlowFloat&, const SlowFloat*, SlowFloat*, size_t);
+   void sub (const SlowFloat*, const SlowFloat*, SlowFloat*, size_t);
+   void mul (const SlowFloat*, const SlowFloat&, SlowFloat*, size_t);
+   void mul (const SlowFloat&, const SlowFloat*, SlowFloat*, size_t);
+   void mul (const SlowFloat*, const SlowFloat*, SlowFloat*, size_t);
+   void div (const SlowFloat*, const SlowFloat&, SlowFloat*, size_t);
+   void div (const SlowFloat&, const SlowFloat*, SlowFloat*, size_t);
+   void div (const SlowFloat*, const SlowFloat*, SlowFloat*, size_t);
+
  }
 
 #endif /* SLOWFLOAT_H */
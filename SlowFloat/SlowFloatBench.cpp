@@ -0,0 +1,246 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "SlowFloat.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+/*
+   Throughput of the SlowFloat operations, in every rounding mode, over a few mixes of inputs.
+   Output is CSV on stdout, one row per operation/mode/mix:
+      benchmark,mode,inputs,ns_per_op
+   The one optional argument is the minimum time to spend on each row, in milliseconds (default 20).
+*/
+
+typedef std::vector<std::pair<SlowFloat::SlowFloat, SlowFloat::SlowFloat> > Pairs;
+
+static const char * const MODE_NAMES [] =
+ {
+   "TIES_EVEN",
+   "TIES_AWAY",
+   "POSITIVE_INFINITY",
+   "NEGATIVE_INFINITY",
+   "ZERO",
+   "TIES_ODD",
+   "TIES_ZERO",
+   "AWAY"
+ };
+
+   // Keeps the optimizer from throwing the work away.
+static volatile uint32_t sink;
+
+static void consume (const SlowFloat::SlowFloat& arg)
+ {
+   sink = sink + arg.significand + static_cast<uint16_t>(arg.exponent);
+ }
+
+static void consume (bool arg)
+ {
+   sink = sink + (arg ? 1U : 0U);
+ }
+
+   // Only look at the bits: anything like fmod would cost more than the conversion being timed.
+static void consume (double arg)
+ {
+   uint64_t bits;
+   std::memcpy(&bits, &arg, sizeof(bits));
+   sink = sink + static_cast<uint32_t>(bits ^ (bits >> 32));
+ }
+
+static void consume (const std::string& arg)
+ {
+   sink = sink + static_cast<uint32_t>(arg.size());
+ }
+
+   // Simple and repeatable : the same inputs on every run.
+static uint32_t nextRandom (uint32_t& state)
+ {
+   state = state * 1103515245U + 12345U;
+   return state >> 8;
+ }
+
+static SlowFloat::SlowFloat makeNumber (uint32_t& state, int16_t exponent)
+ {
+   uint32_t significand = 100000000U + nextRandom(state) % 900000000U;
+   if (0U != (nextRandom(state) & 1U))
+    {
+      significand = ~significand;
+    }
+   return SlowFloat::SlowFloat(significand, exponent);
+ }
+
+static const size_t COUNT = 256U;
+
+static Pairs sameExponent ()
+ {
+   uint32_t state = 1U;
+   Pairs result;
+   for (size_t i = 0U; i < COUNT; ++i)
+    {
+      int16_t exponent = static_cast<int16_t>(static_cast<int>(nextRandom(state) % 21U) - 10);
+      result.emplace_back(makeNumber(state, exponent), makeNumber(state, exponent));
+    }
+   return result;
+ }
+
+static Pairs farExponents ()
+ {
+   uint32_t state = 2U;
+   Pairs result;
+   for (size_t i = 0U; i < COUNT; ++i)
+    {
+      int16_t exponent = static_cast<int16_t>(static_cast<int>(nextRandom(state) % 201U) - 100);
+      int16_t distance = static_cast<int16_t>(10 + nextRandom(state) % 30U);
+      result.emplace_back(makeNumber(state, exponent), makeNumber(state, static_cast<int16_t>(exponent - distance)));
+    }
+   return result;
+ }
+
+static Pairs specials ()
+ {
+   const double values [] =
+    {
+      0.0, -0.0, 1.0, -1.0,
+      std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+      std::numeric_limits<double>::quiet_NaN()
+    };
+   const size_t size = sizeof(values) / sizeof(values[0]);
+   Pairs result;
+   for (size_t i = 0U; i < COUNT; ++i)
+    {
+      result.emplace_back(SlowFloat::SlowFloat(values[i % size]), SlowFloat::SlowFloat(values[(i / size) % size]));
+    }
+   return result;
+ }
+
+   // The exact results land on or next to a tie in the tenth digit.
+static Pairs nearTies ()
+ {
+   uint32_t state = 3U;
+   Pairs result;
+   for (size_t i = 0U; i < COUNT; ++i)
+    {
+      int16_t exponent = static_cast<int16_t>(static_cast<int>(nextRandom(state) % 21U) - 10);
+      uint32_t tie = 499999999U + nextRandom(state) % 3U;
+      result.emplace_back(makeNumber(state, exponent), SlowFloat::SlowFloat(tie, static_cast<int16_t>(exponent - 9)));
+    }
+   return result;
+ }
+
+static int minimumMilliseconds = 20;
+
+template <class Operation>
+static void measure (const char* name, const char* mode, const char* inputs, const Pairs& pairs, Operation operation)
+ {
+   size_t operations = 0U;
+   std::chrono::steady_clock::duration elapsed (0);
+   const std::chrono::steady_clock::duration minimum = std::chrono::milliseconds(minimumMilliseconds);
+   while (elapsed < minimum)
+    {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      for (const auto& pair : pairs)
+       {
+         operation(pair.first, pair.second);
+       }
+      elapsed += std::chrono::steady_clock::now() - start;
+      operations += pairs.size();
+    }
+   std::cout << name << "," << mode << "," << inputs << "," <<
+      (std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(operations)) << std::endl;
+ }
+
+int main (int argc, char ** argv)
+ {
+   if (argc > 1)
+    {
+      minimumMilliseconds = std::atoi(argv[1]);
+    }
+
+   const std::vector<std::pair<const char*, Pairs> > mixes =
+    {
+      { "same_exponent", sameExponent() },
+      { "far_exponents", farExponents() },
+      { "specials", specials() },
+      { "near_ties", nearTies() }
+    };
+
+   std::cout << "benchmark,mode,inputs,ns_per_op" << std::endl;
+   for (int mode = SlowFloat::ROUND_TIES_EVEN; mode <= SlowFloat::ROUND_AWAY; ++mode)
+    {
+      SlowFloat::mode = static_cast<SlowFloat::SlowFloat_Round_Mode>(mode);
+      const char* modeName = MODE_NAMES[mode];
+
+      for (const auto& mix : mixes)
+       {
+         const char* inputs = mix.first;
+         const Pairs& pairs = mix.second;
+
+          // Precompute what the conversions need, so only the conversion is timed.
+         std::vector<std::pair<double, std::string> > converted;
+         for (const auto& pair : pairs)
+          {
+            converted.emplace_back(static_cast<double>(pair.first), SlowFloat::toString(pair.first));
+          }
+         Pairs indices;
+         for (size_t i = 0U; i < pairs.size(); ++i)
+          {
+            indices.emplace_back(SlowFloat::SlowFloat(static_cast<uint32_t>(i), 0), SlowFloat::SlowFloat());
+          }
+
+         measure("add", modeName, inputs, pairs, [] (const SlowFloat::SlowFloat& lhs, const SlowFloat::SlowFloat& rhs) { consume(lhs + rhs); });
+         measure("sub", modeName, inputs, pairs, [] (const SlowFloat::SlowFloat& lhs, const SlowFloat::SlowFloat& rhs) { consume(lhs - rhs); });
+         measure("mul", modeName, inputs, pairs, [] (const SlowFloat::SlowFloat& lhs, const SlowFloat::SlowFloat& rhs) { consume(lhs * rhs); });
+         measure("div", modeName, inputs, pairs, [] (const SlowFloat::SlowFloat& lhs, const SlowFloat::SlowFloat& rhs) { consume(lhs / rhs); });
+         measure("eq", modeName, inputs, pairs, [] (const SlowFloat::SlowFloat& lhs, const SlowFloat::SlowFloat& rhs) { consume(lhs == rhs); });
+         measure("ne", modeName, inputs, pairs, [] (const SlowFloat::SlowFloat& lhs, const SlowFloat::SlowFloat& rhs) { consume(lhs != rhs); });
+         measure("lt", modeName, inputs, pairs, [] (const SlowFloat::SlowFloat& lhs, const SlowFloat::SlowFloat& rhs) { consume(lhs < rhs); });
+         measure("le", modeName, inputs, pairs, [] (const SlowFloat::SlowFloat& lhs, const SlowFloat::SlowFloat& rhs) { consume(lhs <= rhs); });
+         measure("gt", modeName, inputs, pairs, [] (const SlowFloat::SlowFloat& lhs, const SlowFloat::SlowFloat& rhs) { consume(lhs > rhs); });
+         measure("ge", modeName, inputs, pairs, [] (const SlowFloat::SlowFloat& lhs, const SlowFloat::SlowFloat& rhs) { consume(lhs >= rhs); });
+         measure("to_double", modeName, inputs, pairs, [] (const SlowFloat::SlowFloat& lhs, const SlowFloat::SlowFloat&) { consume(static_cast<double>(lhs)); });
+         measure("to_string", modeName, inputs, pairs, [] (const SlowFloat::SlowFloat& lhs, const SlowFloat::SlowFloat&) { consume(SlowFloat::toString(lhs)); });
+          // The significand of the first of each pair of indices is the index of the input to convert.
+         measure("from_double", modeName, inputs, indices, [&converted] (const SlowFloat::SlowFloat& index, const SlowFloat::SlowFloat&)
+            { consume(SlowFloat::SlowFloat(converted[index.significand].first)); });
+         measure("from_string", modeName, inputs, indices, [&converted] (const SlowFloat::SlowFloat& index, const SlowFloat::SlowFloat&)
+            { consume(SlowFloat::fromString(converted[index.significand].second)); });
+       }
+    }
+   SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+
+   return 0;
+ }
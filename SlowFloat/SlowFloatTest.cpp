@@ -34,6 +34,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SlowFloat.h"
 
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
 
 TEST(SlowFloatTests, testDefaultConstructor)
  {
@@ -281,6 +288,29 @@ TEST(SlowFloatTests, testRounding) // Is this OVERKILL? Maybe.
    EXPECT_TRUE(SlowFloat::decideRound(false, false, -1, false));
 
 
+   SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+ }
+
+TEST(SlowFloatTests, testRoundingModeIsPerThread)
+ {
+   SlowFloat::mode = SlowFloat::ROUND_POSITIVE_INFINITY;
+   SlowFloat::SlowFloat third = SlowFloat::SlowFloat(1.0) / SlowFloat::SlowFloat(3.0);
+
+   SlowFloat::SlowFloat_Round_Mode seen = SlowFloat::ROUND_AWAY;
+   SlowFloat::SlowFloat other;
+   std::thread worker ([&seen, &other] ()
+    {
+      seen = SlowFloat::mode;
+      SlowFloat::mode = SlowFloat::ROUND_NEGATIVE_INFINITY;
+      other = SlowFloat::SlowFloat(1.0) / SlowFloat::SlowFloat(3.0);
+    });
+   worker.join();
+
+   EXPECT_EQ(SlowFloat::ROUND_TIES_EVEN, seen);
+   EXPECT_EQ(SlowFloat::ROUND_POSITIVE_INFINITY, SlowFloat::mode);
+   EXPECT_EQ(333333334U, third.significand);
+   EXPECT_EQ(333333333U, other.significand);
+
    SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
  }
 
@@ -429,6 +459,70 @@ TEST(SlowFloatTests, testConversions)
    EXPECT_EQ( 20, SlowFloat::SlowFloat( 1e20).exponent);
  }
 
+   // Compare against the exact decimal expansion of each double, rounded by fromString, and against strtod.
+TEST(SlowFloatTests, testConversionsAreExact)
+ {
+   std::vector<double> values =
+    {
+      1.0, 0.1, 0.2, 0.3, 2.5, 1.000000005, 1.000000015, 100000002.5, 123456789.5, 1234567895.0,
+      1e-20, 1e22, 1e23, 9.999999995, 4294967296.0, 18446744073709551616.0, 0.000001,
+      std::numeric_limits<double>::max(), std::numeric_limits<double>::min(), std::numeric_limits<double>::denorm_min(),
+      std::numeric_limits<double>::min() - std::numeric_limits<double>::denorm_min()
+    };
+   std::mt19937_64 gen (9);
+   for (int i = 0; i < 2000; ++i)
+    {
+      uint64_t bits = gen();
+      if (0x7FF == ((bits >> 52) & 0x7FF)) continue;
+      double value;
+      std::memcpy(&value, &bits, sizeof(value));
+      values.push_back(value);
+    }
+   for (int i = 0; i < 2000; ++i)
+    {
+         // Short decimals, like scripts use.
+      values.push_back(static_cast<double>(gen() % 100000000) / std::pow(10.0, static_cast<double>(gen() % 12)));
+    }
+
+   const SlowFloat::SlowFloat_Round_Mode modes [] =
+    {
+      SlowFloat::ROUND_TIES_EVEN, SlowFloat::ROUND_TIES_AWAY, SlowFloat::ROUND_POSITIVE_INFINITY, SlowFloat::ROUND_NEGATIVE_INFINITY,
+      SlowFloat::ROUND_ZERO, SlowFloat::ROUND_TIES_ODD, SlowFloat::ROUND_TIES_ZERO, SlowFloat::ROUND_AWAY
+    };
+   char buffer [1024];
+   for (double value : values)
+    {
+      for (double signedValue : { value, -value })
+       {
+         std::snprintf(buffer, sizeof(buffer), "%.800e", signedValue);
+         for (SlowFloat::SlowFloat_Round_Mode mode : modes)
+          {
+            SlowFloat::mode = mode;
+            SlowFloat::SlowFloat expected = SlowFloat::fromString(buffer);
+            SlowFloat::SlowFloat actual = SlowFloat::SlowFloat(signedValue);
+            EXPECT_EQ(expected.significand, actual.significand) << buffer << " in mode " << mode;
+            EXPECT_EQ(expected.exponent, actual.exponent) << buffer << " in mode " << mode;
+          }
+         SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+
+         SlowFloat::SlowFloat converted = SlowFloat::SlowFloat(signedValue);
+         EXPECT_EQ(std::strtod(SlowFloat::toString(converted).c_str(), nullptr), static_cast<double>(converted)) << buffer;
+       }
+    }
+
+      // And back, over the whole range of double, including what flushes to zero and infinity.
+   for (int exponent = -330; exponent <= 310; ++exponent)
+    {
+      for (int i = 0; i < 20; ++i)
+       {
+         SlowFloat::SlowFloat value (static_cast<uint32_t>(100000000U + gen() % 900000000U), static_cast<int16_t>(exponent));
+         double actual = static_cast<double>(value);
+         double expected = std::strtod(SlowFloat::toString(value).c_str(), nullptr);
+         EXPECT_EQ(expected, actual) << SlowFloat::toString(value);
+       }
+    }
+ }
+
 TEST(SlowFloatTests, testComparisons)
  {
    SlowFloat::SlowFloat positiveZero (0U, 0);
@@ -2118,3 +2212,639 @@ TEST(SlowFloatTests, testFromStrings)
    EXPECT_EQ(0U, res.significand);
    EXPECT_EQ(0, res.exponent);
  }
+
+TEST(SlowFloatTests, testSqrts)
+ {
+   SlowFloat::SlowFloat res;
+
+   res = SlowFloat::sqrt(SlowFloat::SlowFloat(400000000U, 0));
+   EXPECT_EQ(200000000U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::sqrt(SlowFloat::SlowFloat(200000000U, 0));
+   EXPECT_EQ(141421356U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   SlowFloat::mode = SlowFloat::ROUND_POSITIVE_INFINITY;
+   res = SlowFloat::sqrt(SlowFloat::SlowFloat(200000000U, 0));
+   EXPECT_EQ(141421357U, res.significand);
+   res = SlowFloat::sqrt(SlowFloat::SlowFloat(400000000U, 0));
+   EXPECT_EQ(200000000U, res.significand);
+   SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+
+   res = SlowFloat::sqrt(SlowFloat::SlowFloat(100000000U, -1));
+   EXPECT_EQ(316227766U, res.significand);
+   EXPECT_EQ(-1, res.exponent);
+
+      // Well outside of the range of double.
+   res = SlowFloat::sqrt(SlowFloat::SlowFloat(999999999U, 32767));
+   EXPECT_EQ(999999999U, res.significand);
+   EXPECT_EQ(16383, res.exponent);
+
+   SlowFloat::mode = SlowFloat::ROUND_AWAY;
+   res = SlowFloat::sqrt(SlowFloat::SlowFloat(999999999U, 32767));
+   EXPECT_EQ(100000000U, res.significand);
+   EXPECT_EQ(16384, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+
+   res = SlowFloat::sqrt(SlowFloat::SlowFloat(100000000U, -32767));
+   EXPECT_EQ(316227766U, res.significand);
+   EXPECT_EQ(-16384, res.exponent);
+
+   res = SlowFloat::sqrt(SlowFloat::SlowFloat(~400000000U, 0));
+   EXPECT_EQ(255U, res.significand);
+   EXPECT_EQ(-32768, res.exponent);
+
+   res = SlowFloat::sqrt(SlowFloat::SlowFloat(~0U, 0));
+   EXPECT_EQ(~0U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::sqrt(SlowFloat::SlowFloat(0U, -32768));
+   EXPECT_EQ(0U, res.significand);
+   EXPECT_EQ(-32768, res.exponent);
+ }
+
+TEST(SlowFloatTests, testHypots)
+ {
+   SlowFloat::SlowFloat res;
+
+   res = SlowFloat::hypot(SlowFloat::SlowFloat(300000000U, 0), SlowFloat::SlowFloat(~400000000U, 0));
+   EXPECT_EQ(500000000U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::hypot(SlowFloat::SlowFloat(100000000U, 30000), SlowFloat::SlowFloat(100000000U, 30000));
+   EXPECT_EQ(141421356U, res.significand);
+   EXPECT_EQ(30000, res.exponent);
+
+   res = SlowFloat::hypot(SlowFloat::SlowFloat(100000000U, 0), SlowFloat::SlowFloat(100000000U, -20));
+   EXPECT_EQ(100000000U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::hypot(SlowFloat::SlowFloat(~0U, 0), SlowFloat::SlowFloat(~700000000U, 3));
+   EXPECT_EQ(700000000U, res.significand);
+   EXPECT_EQ(3, res.exponent);
+
+   res = SlowFloat::hypot(SlowFloat::SlowFloat(255U, -32768), SlowFloat::SlowFloat(~0U, -32768));
+   EXPECT_EQ(0U, res.significand);
+   EXPECT_EQ(-32768, res.exponent);
+ }
+
+TEST(SlowFloatTests, testPows)
+ {
+   SlowFloat::SlowFloat res;
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(200000000U, 0), SlowFloat::SlowFloat(100000000U, 1));
+   EXPECT_EQ(102400000U, res.significand);
+   EXPECT_EQ(3, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(150000000U, 0), SlowFloat::SlowFloat(200000000U, 0));
+   EXPECT_EQ(225000000U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(~200000000U, 0), SlowFloat::SlowFloat(300000000U, 0));
+   EXPECT_EQ(~800000000U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(200000000U, 0), SlowFloat::SlowFloat(~200000000U, 0));
+   EXPECT_EQ(250000000U, res.significand);
+   EXPECT_EQ(-1, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(300000000U, 0), SlowFloat::SlowFloat(~100000000U, 0));
+   EXPECT_EQ(333333333U, res.significand);
+   EXPECT_EQ(-1, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(110000000U, 0), SlowFloat::SlowFloat(100000000U, 2));
+   EXPECT_EQ(137806123U, res.significand);
+   EXPECT_EQ(4, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(700000000U, -1), SlowFloat::SlowFloat(~370000000U, 1));
+   EXPECT_EQ(538731686U, res.significand);
+   EXPECT_EQ(5, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(300000000U, 0), SlowFloat::SlowFloat(400000000U, 1));
+   EXPECT_EQ(121576655U, res.significand);
+   EXPECT_EQ(19, res.exponent);
+
+   SlowFloat::mode = SlowFloat::ROUND_POSITIVE_INFINITY;
+   res = SlowFloat::pow(SlowFloat::SlowFloat(300000000U, 0), SlowFloat::SlowFloat(400000000U, 1));
+   EXPECT_EQ(121576655U, res.significand);
+   SlowFloat::mode = SlowFloat::ROUND_ZERO;
+   res = SlowFloat::pow(SlowFloat::SlowFloat(300000000U, 0), SlowFloat::SlowFloat(400000000U, 1));
+   EXPECT_EQ(121576654U, res.significand);
+   res = SlowFloat::pow(SlowFloat::SlowFloat(300000000U, 0), SlowFloat::SlowFloat(~400000000U, 1));
+   EXPECT_EQ(822526333U, res.significand);
+   EXPECT_EQ(-20, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+
+      // The edges of the exponent range.
+   res = SlowFloat::pow(SlowFloat::SlowFloat(100000000U, 1), SlowFloat::SlowFloat(327670000U, 4));
+   EXPECT_EQ(100000000U, res.significand);
+   EXPECT_EQ(32767, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(100000000U, 1), SlowFloat::SlowFloat(327680000U, 4));
+   EXPECT_EQ(0U, res.significand);
+   EXPECT_EQ(-32768, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(100000000U, 1), SlowFloat::SlowFloat(~327670000U, 4));
+   EXPECT_EQ(100000000U, res.significand);
+   EXPECT_EQ(-32767, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(~100000000U, 1), SlowFloat::SlowFloat(~327690000U, 4));
+   EXPECT_EQ(~0U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(200000000U, 0), SlowFloat::SlowFloat(100000000U, 17));
+   EXPECT_EQ(0U, res.significand);
+   EXPECT_EQ(-32768, res.exponent);
+
+      // Special cases.
+   res = SlowFloat::pow(SlowFloat::SlowFloat(255U, -32768), SlowFloat::SlowFloat(0U, 0));
+   EXPECT_EQ(100000000U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(~0U, 0), SlowFloat::SlowFloat(~100000000U, 0));
+   EXPECT_EQ(~0U, res.significand);
+   EXPECT_EQ(-32768, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(~0U, -32768), SlowFloat::SlowFloat(~200000000U, 0));
+   EXPECT_EQ(0U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+      // Not an integer.
+   res = SlowFloat::pow(SlowFloat::SlowFloat(200000000U, 0), SlowFloat::SlowFloat(500000000U, -1));
+   EXPECT_EQ(141421356U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(160000000U, 1), SlowFloat::SlowFloat(250000000U, -1));
+   EXPECT_EQ(200000000U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(200000000U, 0), SlowFloat::SlowFloat(150000000U, 0));
+   EXPECT_EQ(282842712U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(270000000U, 1), SlowFloat::SlowFloat(~333333333U, -1));
+   EXPECT_EQ(333333334U, res.significand);
+   EXPECT_EQ(-1, res.exponent);
+
+   res = SlowFloat::pow(SlowFloat::SlowFloat(100000000U, 1), SlowFloat::SlowFloat(~327665000U, 4));
+   EXPECT_EQ(316227766U, res.significand);
+   EXPECT_EQ(-32767, res.exponent);
+
+      // An integral power so large that repeated squaring loses too much.
+   res = SlowFloat::pow(SlowFloat::SlowFloat(999999999U, -1), SlowFloat::SlowFloat(750000000U, 13));
+   EXPECT_EQ(820051203U, res.significand);
+   EXPECT_EQ(-32573, res.exponent);
+
+      // Powers near zero are near one, but not one in every mode.
+   SlowFloat::mode = SlowFloat::ROUND_POSITIVE_INFINITY;
+   res = SlowFloat::pow(SlowFloat::SlowFloat(100000001U, 0), SlowFloat::SlowFloat(100000000U, -13));
+   EXPECT_EQ(100000001U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_ZERO;
+   res = SlowFloat::pow(SlowFloat::SlowFloat(250000000U, 0), SlowFloat::SlowFloat(100000000U, -25));
+   EXPECT_EQ(100000000U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+ }
+
+TEST(SlowFloatTests, testExps)
+ {
+   SlowFloat::SlowFloat res;
+
+   res = SlowFloat::exp(SlowFloat::SlowFloat(100000000U, 0));
+   EXPECT_EQ(271828183U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::exp(SlowFloat::SlowFloat(750000000U, 4));
+   EXPECT_EQ(121939032U, res.significand);
+   EXPECT_EQ(32572, res.exponent);
+
+   res = SlowFloat::exp(SlowFloat::SlowFloat(~750000000U, 4));
+   EXPECT_EQ(820081956U, res.significand);
+   EXPECT_EQ(-32573, res.exponent);
+
+   res = SlowFloat::exp(SlowFloat::SlowFloat(800000000U, 4));
+   EXPECT_TRUE(SlowFloat::isInf(res));
+
+   res = SlowFloat::exp(SlowFloat::SlowFloat(~800000000U, 4));
+   EXPECT_EQ(0U, res.significand);
+
+      // Tiny arguments.
+   res = SlowFloat::exp(SlowFloat::SlowFloat(100000000U, -30000));
+   EXPECT_EQ(100000000U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_POSITIVE_INFINITY;
+   res = SlowFloat::exp(SlowFloat::SlowFloat(100000000U, -30000));
+   EXPECT_EQ(100000001U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_ZERO;
+   res = SlowFloat::exp(SlowFloat::SlowFloat(~100000000U, -30000));
+   EXPECT_EQ(999999999U, res.significand);
+   EXPECT_EQ(-1, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+
+   res = SlowFloat::exp(SlowFloat::SlowFloat(0U, 0));
+   EXPECT_EQ(100000000U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+ }
+
+TEST(SlowFloatTests, testLogs)
+ {
+   SlowFloat::SlowFloat res;
+
+   res = SlowFloat::log(SlowFloat::SlowFloat(200000000U, 0));
+   EXPECT_EQ(693147181U, res.significand);
+   EXPECT_EQ(-1, res.exponent);
+
+   res = SlowFloat::log(SlowFloat::SlowFloat(100000000U, -30000));
+   EXPECT_EQ(~690775528U, res.significand);
+   EXPECT_EQ(4, res.exponent);
+
+   res = SlowFloat::log(SlowFloat::SlowFloat(999999999U, 32767));
+   EXPECT_EQ(754511083U, res.significand);
+   EXPECT_EQ(4, res.exponent);
+
+   res = SlowFloat::log(SlowFloat::SlowFloat(999999999U, -1));
+   EXPECT_EQ(~100000000U, res.significand);
+   EXPECT_EQ(-9, res.exponent);
+
+   res = SlowFloat::log(SlowFloat::SlowFloat(100000000U, 0));
+   EXPECT_EQ(0U, res.significand);
+
+   res = SlowFloat::log(SlowFloat::SlowFloat(0U, 0));
+   EXPECT_TRUE(SlowFloat::isInf(res));
+
+   res = SlowFloat::log(SlowFloat::SlowFloat(~100000000U, 0));
+   EXPECT_TRUE(std::isnan(static_cast<double>(res)));
+
+      // With a base, exact answers are exact.
+   res = SlowFloat::log(SlowFloat::SlowFloat(200000000U, 0), SlowFloat::SlowFloat(102400000U, 3));
+   EXPECT_EQ(100000000U, res.significand);
+   EXPECT_EQ(1, res.exponent);
+
+   res = SlowFloat::log(SlowFloat::SlowFloat(300000000U, 0), SlowFloat::SlowFloat(810000000U, 1));
+   EXPECT_EQ(400000000U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::log(SlowFloat::SlowFloat(100000000U, 1), SlowFloat::SlowFloat(200000000U, 0));
+   EXPECT_EQ(301029996U, res.significand);
+   EXPECT_EQ(-1, res.exponent);
+ }
+
+TEST(SlowFloatTests, testTrigs)
+ {
+   SlowFloat::SlowFloat res;
+
+   res = SlowFloat::sind(SlowFloat::SlowFloat(300000000U, 1));
+   EXPECT_EQ(500000000U, res.significand);
+   EXPECT_EQ(-1, res.exponent);
+
+   res = SlowFloat::sind(SlowFloat::SlowFloat(100000000U, 0));
+   EXPECT_EQ(174524064U, res.significand);
+   EXPECT_EQ(-2, res.exponent);
+
+   res = SlowFloat::sind(SlowFloat::SlowFloat(~750000000U, -1));
+   EXPECT_EQ(~130895956U, res.significand);
+   EXPECT_EQ(-2, res.exponent);
+
+      // Arguments at the ends of the exponent range reduce exactly.
+   res = SlowFloat::sind(SlowFloat::SlowFloat(100000000U, 30000));
+   EXPECT_EQ(~984807753U, res.significand);
+   EXPECT_EQ(-1, res.exponent);
+
+   res = SlowFloat::sind(SlowFloat::SlowFloat(100000000U, -30000));
+   EXPECT_EQ(174532925U, res.significand);
+   EXPECT_EQ(-30002, res.exponent);
+
+   res = SlowFloat::cosd(SlowFloat::SlowFloat(600000000U, 1));
+   EXPECT_EQ(500000000U, res.significand);
+   EXPECT_EQ(-1, res.exponent);
+
+   res = SlowFloat::cosd(SlowFloat::SlowFloat(100000000U, 2));
+   EXPECT_EQ(~173648178U, res.significand);
+   EXPECT_EQ(-1, res.exponent);
+
+   res = SlowFloat::cosd(SlowFloat::SlowFloat(100000000U, -30000));
+   EXPECT_EQ(100000000U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_ZERO;
+   res = SlowFloat::cosd(SlowFloat::SlowFloat(100000000U, -30000));
+   EXPECT_EQ(999999999U, res.significand);
+   EXPECT_EQ(-1, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+
+   res = SlowFloat::tand(SlowFloat::SlowFloat(450000000U, 1));
+   EXPECT_EQ(100000000U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::tand(SlowFloat::SlowFloat(900000000U, 1));
+   EXPECT_TRUE(SlowFloat::isInf(res));
+
+   res = SlowFloat::tand(SlowFloat::SlowFloat(~899999999U, 1));
+   EXPECT_EQ(~572957795U, res.significand);
+   EXPECT_EQ(8, res.exponent);
+
+   res = SlowFloat::tand(SlowFloat::SlowFloat(100000000U, 30000));
+   EXPECT_EQ(~567128182U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::degToRad(SlowFloat::SlowFloat(180000000U, 2));
+   EXPECT_EQ(314159265U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::degToRad(SlowFloat::SlowFloat(999999999U, 32767));
+   EXPECT_EQ(174532925U, res.significand);
+   EXPECT_EQ(32766, res.exponent);
+
+   res = SlowFloat::radToDeg(SlowFloat::SlowFloat(100000000U, 0));
+   EXPECT_EQ(572957795U, res.significand);
+   EXPECT_EQ(1, res.exponent);
+ }
+
+TEST(SlowFloatTests, testInverseTrigs)
+ {
+   SlowFloat::SlowFloat res;
+
+   res = SlowFloat::asind(SlowFloat::SlowFloat(300000000U, -1));
+   EXPECT_EQ(174576031U, res.significand);
+   EXPECT_EQ(1, res.exponent);
+
+   res = SlowFloat::asind(SlowFloat::SlowFloat(~500000000U, -1));
+   EXPECT_EQ(~300000000U, res.significand);
+   EXPECT_EQ(1, res.exponent);
+
+   res = SlowFloat::asind(SlowFloat::SlowFloat(~999999999U, -1));
+   EXPECT_EQ(~899974377U, res.significand);
+   EXPECT_EQ(1, res.exponent);
+
+   res = SlowFloat::asind(SlowFloat::SlowFloat(100000000U, -30000));
+   EXPECT_EQ(572957795U, res.significand);
+   EXPECT_EQ(-29999, res.exponent);
+
+   res = SlowFloat::asind(SlowFloat::SlowFloat(100000001U, 0));
+   EXPECT_TRUE(std::isnan(static_cast<double>(res)));
+
+   res = SlowFloat::acosd(SlowFloat::SlowFloat(999999999U, -1));
+   EXPECT_EQ(256234516U, res.significand);
+   EXPECT_EQ(-3, res.exponent);
+
+   res = SlowFloat::acosd(SlowFloat::SlowFloat(~300000000U, -1));
+   EXPECT_EQ(107457603U, res.significand);
+   EXPECT_EQ(2, res.exponent);
+
+   res = SlowFloat::acosd(SlowFloat::SlowFloat(~500000000U, -1));
+   EXPECT_EQ(120000000U, res.significand);
+   EXPECT_EQ(2, res.exponent);
+
+   SlowFloat::mode = SlowFloat::ROUND_ZERO;
+   res = SlowFloat::acosd(SlowFloat::SlowFloat(100000000U, -30000));
+   EXPECT_EQ(899999999U, res.significand);
+   EXPECT_EQ(1, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_POSITIVE_INFINITY;
+   res = SlowFloat::acosd(SlowFloat::SlowFloat(~100000000U, -30000));
+   EXPECT_EQ(900000001U, res.significand);
+   EXPECT_EQ(1, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+
+   res = SlowFloat::atand(SlowFloat::SlowFloat(200000000U, 0));
+   EXPECT_EQ(634349488U, res.significand);
+   EXPECT_EQ(1, res.exponent);
+
+   res = SlowFloat::atand(SlowFloat::SlowFloat(~100000000U, 0));
+   EXPECT_EQ(~450000000U, res.significand);
+   EXPECT_EQ(1, res.exponent);
+
+   res = SlowFloat::atand(SlowFloat::SlowFloat(100000000U, 30000));
+   EXPECT_EQ(900000000U, res.significand);
+   EXPECT_EQ(1, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_ZERO;
+   res = SlowFloat::atand(SlowFloat::SlowFloat(100000000U, 30000));
+   EXPECT_EQ(899999999U, res.significand);
+   EXPECT_EQ(1, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+
+   res = SlowFloat::atand(SlowFloat::SlowFloat(~100000000U, -30000));
+   EXPECT_EQ(~572957795U, res.significand);
+   EXPECT_EQ(-29999, res.exponent);
+
+      // atan2 takes y first, and follows C for zeros and infinities.
+   res = SlowFloat::atan2d(SlowFloat::SlowFloat(~100000000U, 0), SlowFloat::SlowFloat(~200000000U, 0));
+   EXPECT_EQ(~153434949U, res.significand);
+   EXPECT_EQ(2, res.exponent);
+
+   res = SlowFloat::atan2d(SlowFloat::SlowFloat(300000000U, 0), SlowFloat::SlowFloat(~300000000U, 0));
+   EXPECT_EQ(135000000U, res.significand);
+   EXPECT_EQ(2, res.exponent);
+
+   SlowFloat::mode = SlowFloat::ROUND_ZERO;
+   res = SlowFloat::atan2d(SlowFloat::SlowFloat(100000000U, -30000), SlowFloat::SlowFloat(~100000000U, 0));
+   EXPECT_EQ(179999999U, res.significand);
+   EXPECT_EQ(2, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+
+   res = SlowFloat::atan2d(SlowFloat::SlowFloat(100000000U, -30000), SlowFloat::SlowFloat(100000000U, 30000));
+   EXPECT_EQ(0U, res.significand);
+
+   res = SlowFloat::atan2d(SlowFloat::SlowFloat(~0U, 0), SlowFloat::SlowFloat(~0U, 0));
+   EXPECT_EQ(~180000000U, res.significand);
+   EXPECT_EQ(2, res.exponent);
+
+   res = SlowFloat::atan2d(SlowFloat::SlowFloat(0U, -32768), SlowFloat::SlowFloat(~0U, -32768));
+   EXPECT_EQ(135000000U, res.significand);
+   EXPECT_EQ(2, res.exponent);
+ }
+
+TEST(SlowFloatTests, testHyperbolics)
+ {
+   SlowFloat::SlowFloat res;
+
+   res = SlowFloat::sinh(SlowFloat::SlowFloat(100000000U, 0));
+   EXPECT_EQ(117520119U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::sinh(SlowFloat::SlowFloat(~750000000U, 4));
+   EXPECT_EQ(~609695161U, res.significand);
+   EXPECT_EQ(32571, res.exponent);
+
+   res = SlowFloat::sinh(SlowFloat::SlowFloat(~800000000U, 4));
+   EXPECT_EQ(~0U, res.significand);
+   EXPECT_EQ(-32768, res.exponent);
+
+   SlowFloat::mode = SlowFloat::ROUND_AWAY;
+   res = SlowFloat::sinh(SlowFloat::SlowFloat(100000000U, -30000));
+   EXPECT_EQ(100000001U, res.significand);
+   EXPECT_EQ(-30000, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+
+   res = SlowFloat::cosh(SlowFloat::SlowFloat(750000000U, 4));
+   EXPECT_EQ(609695161U, res.significand);
+   EXPECT_EQ(32571, res.exponent);
+
+   res = SlowFloat::cosh(SlowFloat::SlowFloat(500000000U, -1));
+   EXPECT_EQ(112762597U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   SlowFloat::mode = SlowFloat::ROUND_POSITIVE_INFINITY;
+   res = SlowFloat::cosh(SlowFloat::SlowFloat(100000000U, -30000));
+   EXPECT_EQ(100000001U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+
+   res = SlowFloat::tanh(SlowFloat::SlowFloat(500000000U, -1));
+   EXPECT_EQ(462117157U, res.significand);
+   EXPECT_EQ(-1, res.exponent);
+
+   SlowFloat::mode = SlowFloat::ROUND_POSITIVE_INFINITY;
+   res = SlowFloat::tanh(SlowFloat::SlowFloat(~300000000U, 1));
+   EXPECT_EQ(~999999999U, res.significand);
+   EXPECT_EQ(-1, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_ZERO;
+   res = SlowFloat::tanh(SlowFloat::SlowFloat(100000000U, -30000));
+   EXPECT_EQ(999999999U, res.significand);
+   EXPECT_EQ(-30001, res.exponent);
+   SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+ }
+
+TEST(SlowFloatTests, testCbrts)
+ {
+   SlowFloat::SlowFloat res;
+
+   res = SlowFloat::cbrt(SlowFloat::SlowFloat(200000000U, 0));
+   EXPECT_EQ(125992105U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::cbrt(SlowFloat::SlowFloat(~270000000U, 1));
+   EXPECT_EQ(~300000000U, res.significand);
+   EXPECT_EQ(0, res.exponent);
+
+   res = SlowFloat::cbrt(SlowFloat::SlowFloat(~100000000U, 30000));
+   EXPECT_EQ(~100000000U, res.significand);
+   EXPECT_EQ(10000, res.exponent);
+
+   res = SlowFloat::cbrt(SlowFloat::SlowFloat(343000000U, -30000));
+   EXPECT_EQ(150810428U, res.significand);
+   EXPECT_EQ(-10000, res.exponent);
+
+   res = SlowFloat::cbrt(SlowFloat::SlowFloat(999999999U, 32767));
+   EXPECT_EQ(464158883U, res.significand);
+   EXPECT_EQ(10922, res.exponent);
+ }
+
+TEST(SlowFloatTests, testInt64s)
+ {
+   int64_t res;
+
+   EXPECT_TRUE(SlowFloat::toInt64(SlowFloat::SlowFloat(123000000U, 2), res));
+   EXPECT_EQ(123, res);
+   EXPECT_TRUE(SlowFloat::toInt64(SlowFloat::SlowFloat(~123000000U, 2), res));
+   EXPECT_EQ(-123, res);
+   EXPECT_TRUE(SlowFloat::toInt64(SlowFloat::SlowFloat(~0U, 0), res));
+   EXPECT_EQ(0, res);
+   EXPECT_TRUE(SlowFloat::toInt64(SlowFloat::SlowFloat(922337203U, 18), res));
+   EXPECT_EQ(INT64_C(922337203000000000) * 10, res);
+   EXPECT_TRUE(SlowFloat::toInt64(SlowFloat::SlowFloat(~922337203U, 18), res));
+   EXPECT_EQ(INT64_C(-922337203000000000) * 10, res);
+
+   EXPECT_FALSE(SlowFloat::toInt64(SlowFloat::SlowFloat(123400000U, 2), res));
+   EXPECT_FALSE(SlowFloat::toInt64(SlowFloat::SlowFloat(500000000U, -1), res));
+   EXPECT_FALSE(SlowFloat::toInt64(SlowFloat::SlowFloat(922337204U, 18), res));
+   EXPECT_FALSE(SlowFloat::toInt64(SlowFloat::SlowFloat(100000000U, 19), res));
+   EXPECT_FALSE(SlowFloat::toInt64(SlowFloat::SlowFloat(0U, -32768), res));
+   EXPECT_FALSE(SlowFloat::toInt64(SlowFloat::SlowFloat(255U, -32768), res));
+
+   SlowFloat::SlowFloat val;
+
+   val = SlowFloat::fromInt64(0);
+   EXPECT_EQ(0U, val.significand);
+   EXPECT_EQ(0, val.exponent);
+   val = SlowFloat::fromInt64(-7);
+   EXPECT_EQ(~700000000U, val.significand);
+   EXPECT_EQ(0, val.exponent);
+   val = SlowFloat::fromInt64(999999999);
+   EXPECT_EQ(999999999U, val.significand);
+   EXPECT_EQ(8, val.exponent);
+
+      // More than nine digits rounds.
+   val = SlowFloat::fromInt64(INT64_C(1234567895));
+   EXPECT_EQ(123456790U, val.significand);
+   EXPECT_EQ(9, val.exponent);
+   val = SlowFloat::fromInt64(INT64_C(1234567885));
+   EXPECT_EQ(123456788U, val.significand);
+   val = SlowFloat::fromInt64(INT64_C(9999999995));
+   EXPECT_EQ(100000000U, val.significand);
+   EXPECT_EQ(10, val.exponent);
+   val = SlowFloat::fromInt64(INT64_MIN);
+   EXPECT_EQ(~922337204U, val.significand);
+   EXPECT_EQ(18, val.exponent);
+
+   SlowFloat::mode = SlowFloat::ROUND_NEGATIVE_INFINITY;
+   val = SlowFloat::fromInt64(INT64_C(-1234567881));
+   EXPECT_EQ(~123456789U, val.significand);
+   val = SlowFloat::fromInt64(INT64_C(1234567889));
+   EXPECT_EQ(123456788U, val.significand);
+   SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+
+   for (int64_t i = -100000; i <= 100000; i += 37)
+    {
+      int64_t back;
+      EXPECT_TRUE(SlowFloat::toInt64(SlowFloat::fromInt64(i), back));
+      EXPECT_EQ(i, back);
+      EXPECT_TRUE(SlowFloat::fromInt64(i) == SlowFloat::SlowFloat(static_cast<double>(i)));
+    }
+ }
+
+TEST(SlowFloatTests, testBatches)
+ {
+   std::vector<SlowFloat::SlowFloat> lhs;
+   std::vector<SlowFloat::SlowFloat> rhs;
+   std::mt19937 gen (5);
+   std::uniform_int_distribution<uint32_t> sig (100000000U, 999999999U);
+   std::uniform_int_distribution<int> exp (-20, 20);
+   for (int i = 0; i < 1000; ++i)
+    {
+      lhs.emplace_back(sig(gen) ^ ((i & 1) ? 0xFFFFFFFFU : 0U), static_cast<int16_t>(exp(gen)));
+      rhs.emplace_back(sig(gen) ^ ((i & 2) ? 0xFFFFFFFFU : 0U), static_cast<int16_t>(exp(gen)));
+    }
+   lhs[0] = SlowFloat::SlowFloat(0U, 0);
+   rhs[1] = SlowFloat::SlowFloat(0U, 0);
+   rhs[2] = SlowFloat::SlowFloat(1U, -32768);
+   const SlowFloat::SlowFloat fixed (314159265U, 0);
+   std::vector<SlowFloat::SlowFloat> res (lhs.size());
+
+#define CHECKBATCH(name,op) \
+   SlowFloat::name(lhs.data(), rhs.data(), res.data(), lhs.size()); \
+   for (size_t i = 0U; i < lhs.size(); ++i) \
+    { \
+      SlowFloat::SlowFloat exp = lhs[i] op rhs[i]; \
+      EXPECT_EQ(exp.significand, res[i].significand) << i; \
+      EXPECT_EQ(exp.exponent, res[i].exponent) << i; \
+    } \
+   SlowFloat::name(lhs.data(), fixed, res.data(), lhs.size()); \
+   for (size_t i = 0U; i < lhs.size(); ++i) \
+    { \
+      SlowFloat::SlowFloat exp = lhs[i] op fixed; \
+      EXPECT_EQ(exp.significand, res[i].significand) << i; \
+      EXPECT_EQ(exp.exponent, res[i].exponent) << i; \
+    } \
+   res = rhs; \
+   SlowFloat::name(fixed, res.data(), res.data(), res.size()); \
+   for (size_t i = 0U; i < rhs.size(); ++i) \
+    { \
+      SlowFloat::SlowFloat exp = fixed op rhs[i]; \
+      EXPECT_EQ(exp.significand, res[i].significand) << i; \
+      EXPECT_EQ(exp.exponent, res[i].exponent) << i; \
+    }
+
+   CHECKBATCH(add, +)
+   CHECKBATCH(sub, -)
+   CHECKBATCH(mul, *)
+   CHECKBATCH(div, /)
+
+   SlowFloat::mode = SlowFloat::ROUND_NEGATIVE_INFINITY;
+   CHECKBATCH(add, +)
+   CHECKBATCH(div, /)
+   SlowFloat::mode = SlowFloat::ROUND_TIES_EVEN;
+
+#undef CHECKBATCH
+ }